@@ -76,6 +76,35 @@ esp_err_t esp_event_post(esp_event_base_t event_base, int32_t event_id,
                              event_data, event_data_size, ticks_to_wait);
 }
 
+esp_err_t esp_event_post_lane(uint32_t lane, esp_event_base_t event_base, int32_t event_id,
+                              const void* event_data, size_t event_data_size, TickType_t ticks_to_wait)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_post_to_lane(s_default_loop, lane, event_base, event_id,
+                                  event_data, event_data_size, ticks_to_wait);
+}
+
+esp_err_t esp_event_set_base_lane(esp_event_base_t event_base, uint32_t lane)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_loop_set_base_lane(s_default_loop, event_base, lane);
+}
+
+esp_err_t esp_event_post_batch(const esp_event_batch_item_t* events, size_t event_count, TickType_t ticks_to_wait)
+{
+    if (s_default_loop == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return esp_event_post_batch_to(s_default_loop, events, event_count, ticks_to_wait);
+}
+
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
 esp_err_t esp_event_isr_post(esp_event_base_t event_base, int32_t event_id,
                              const void* event_data, size_t event_data_size, BaseType_t* task_unblocked)
@@ -100,7 +129,10 @@ esp_err_t esp_event_loop_create_default(void)
         .task_name = "sys_evt",
         .task_stack_size = ESP_TASKD_EVENT_STACK,
         .task_priority = ESP_TASKD_EVENT_PRIO,
-        .task_core_id = 0
+        .task_core_id = 0,
+        .data_pool_block_size = CONFIG_ESP_EVENT_DEFAULT_LOOP_DATA_POOL_BLOCK_SIZE,
+        .data_pool_block_count = CONFIG_ESP_EVENT_DEFAULT_LOOP_DATA_POOL_BLOCKS,
+        .lane_count = CONFIG_ESP_EVENT_DEFAULT_LOOP_LANES,
     };
 
     esp_err_t err;
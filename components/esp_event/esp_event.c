@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -26,6 +27,10 @@
 #define LOOP_DUMP_FORMAT              "LOOP @%p,%s rx:%" PRIu32 " dr:%" PRIu32 "\n"
 // handler @<address> ev:<base, id> inv:<times invoked> time:<runtime>
 #define HANDLER_DUMP_FORMAT           "  HANDLER @%p ev:%s,%s inv:%" PRIu32 " time:%lld us\n"
+// data pool blocks:<block count> size:<block size> used:<blocks used> max:<max blocks used> heap:<heap copies>
+#define POOL_DUMP_FORMAT              "  DATA POOL blocks:%u size:%u used:%" PRIu32 " max:%" PRIu32 " heap:%" PRIu32 "\n"
+// lane <lane> depth:<events waiting> max:<max events waiting> dr:<events dropped>
+#define LANE_DUMP_FORMAT              "  LANE %" PRIu32 " depth:%u max:%" PRIu32 " dr:%" PRIu32 "\n"
 
 #define PRINT_DUMP_INFO(dst, sz, ...)  do { \
                                             int cb = snprintf(dst, sz, __VA_ARGS__); \
@@ -39,6 +44,7 @@
 static const char* TAG = "event";
 static const char* esp_event_any_base = "any";
 static const char* esp_event_handler_cleanup = "cleanup";
+static const char* esp_event_batch = "batch";
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
 static SLIST_HEAD(esp_event_loop_instance_list_t, esp_event_loop_instance) s_event_loops =
@@ -49,6 +55,9 @@ static portMUX_TYPE s_event_loops_spinlock = portMUX_INITIALIZER_UNLOCKED;
 
 /* ------------------------- Static Functions ------------------------------- */
 
+static esp_err_t post_to_lane(esp_event_loop_instance_t* loop, uint32_t lane, esp_event_base_t event_base, int32_t event_id,
+                              const void* event_data, size_t event_data_size, TickType_t ticks_to_wait);
+
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
 
 static int esp_event_dump_prepare(void)
@@ -60,7 +69,7 @@ static int esp_event_dump_prepare(void)
     esp_event_handler_node_t* handler_it;
 
     // Count the number of items to be printed. This is needed to compute how much memory to reserve.
-    int loops = 0, handlers = 0;
+    int loops = 0, lanes = 0, handlers = 0;
 
     portENTER_CRITICAL(&s_event_loops_spinlock);
 
@@ -82,6 +91,7 @@ static int esp_event_dump_prepare(void)
             }
         }
         loops++;
+        lanes += loop_it->lane_count;
     }
 
     portEXIT_CRITICAL(&s_event_loops_spinlock);
@@ -89,12 +99,157 @@ static int esp_event_dump_prepare(void)
     // Reserve slightly more memory than computed
     int allowance = 3;
     int size = (((loops + allowance) * (sizeof(LOOP_DUMP_FORMAT) + 10 + 20 + 2 * 11)) +
+                ((loops + allowance) * (sizeof(POOL_DUMP_FORMAT) + 5 * 11)) +
+                ((lanes + allowance) * (sizeof(LANE_DUMP_FORMAT) + 4 * 11)) +
                 ((handlers + allowance) * (sizeof(HANDLER_DUMP_FORMAT) + 10 + 2 * 20 + 11 + 20)));
 
     return size;
 }
 #endif
 
+static esp_err_t data_pool_init(esp_event_data_pool_t* pool, size_t block_size, size_t block_count)
+{
+    memset(pool, 0, sizeof(*pool));
+    portMUX_INITIALIZE(&pool->lock);
+
+    if (block_size == 0 || block_count == 0) {
+        return ESP_OK;
+    }
+
+    // Blocks have to be aligned for any type of event data and have to fit the free list pointer
+    const size_t align = _Alignof(max_align_t);
+    block_size = (block_size + align - 1) & ~(align - 1);
+
+    pool->blocks = calloc(block_count, block_size);
+    if (pool->blocks == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    pool->block_size = block_size;
+    pool->block_count = block_count;
+
+    for (size_t i = block_count; i > 0; i--) {
+        void* block = pool->blocks + (i - 1) * block_size;
+        *(void**) block = pool->free_list;
+        pool->free_list = block;
+    }
+
+    return ESP_OK;
+}
+
+// Returns a block for event data of the given size, or NULL if the data has to be copied to the heap
+static void* data_pool_alloc(esp_event_data_pool_t* pool, size_t size)
+{
+    if (pool->blocks == NULL) {
+        return NULL;
+    }
+
+    void* block = NULL;
+
+    portENTER_CRITICAL(&pool->lock);
+    if (size <= pool->block_size && pool->free_list != NULL) {
+        block = pool->free_list;
+        pool->free_list = *(void**) block;
+        pool->used++;
+        if (pool->used > pool->max_used) {
+            pool->max_used = pool->used;
+        }
+    } else {
+        pool->heap_copies++;
+    }
+    portEXIT_CRITICAL(&pool->lock);
+
+    return block;
+}
+
+// Returns false if the data wasn't allocated from the pool
+static bool data_pool_free(esp_event_data_pool_t* pool, void* data)
+{
+    uint8_t* block = (uint8_t*) data;
+
+    if (pool->blocks == NULL || block < pool->blocks || block >= pool->blocks + pool->block_count * pool->block_size) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&pool->lock);
+    *(void**) block = pool->free_list;
+    pool->free_list = block;
+    pool->used--;
+    portEXIT_CRITICAL(&pool->lock);
+
+    return true;
+}
+
+// Returns the lane of the events of the base. Inlined, since it's also used by esp_event_isr_post_to.
+static inline __attribute__((always_inline)) uint32_t base_lane_get(esp_event_loop_instance_t* loop, esp_event_base_t base)
+{
+    uint32_t lane = 0;
+
+    if (loop->lane_count > 1) {
+        portENTER_CRITICAL_SAFE(&loop->base_lanes_lock);
+        for (size_t i = 0; i < loop->base_lane_count; i++) {
+            if (loop->base_lanes[i].base == base) {
+                lane = loop->base_lanes[i].lane;
+                break;
+            }
+        }
+        portEXIT_CRITICAL_SAFE(&loop->base_lanes_lock);
+    }
+
+    return lane;
+}
+
+static inline __attribute__((always_inline)) void lane_update_max_depth(esp_event_lane_t* lane, uint32_t depth)
+{
+    uint_least32_t max_depth = atomic_load(&lane->max_depth);
+
+    while (depth > max_depth && !atomic_compare_exchange_weak(&lane->max_depth, &max_depth, depth)) {
+    }
+}
+
+// Receives the next event from the highest lane which has one
+static BaseType_t loop_receive(esp_event_loop_instance_t* loop, esp_event_post_instance_t* post, TickType_t ticks_to_wait)
+{
+    if (loop->queue_set == NULL) {
+        return xQueueReceive(loop->lanes[0].queue, post, ticks_to_wait);
+    }
+
+    // The set holds one entry for every event in the lanes. Every entry taken from the set is followed by
+    // receiving exactly one event, so there is always an event in one of the lanes after taking an entry.
+    if (xQueueSelectFromSet(loop->queue_set, ticks_to_wait) == NULL) {
+        return pdFALSE;
+    }
+
+    for (uint32_t lane = loop->lane_count; lane > 0; lane--) {
+        if (xQueueReceive(loop->lanes[lane - 1].queue, post, 0) == pdTRUE) {
+            return pdTRUE;
+        }
+    }
+
+    return pdFALSE;
+}
+
+// Deletes the queues of the lanes, which must be empty
+static void loop_lanes_delete(esp_event_loop_instance_t* loop)
+{
+    if (loop->lanes != NULL) {
+        for (uint32_t lane = 0; lane < loop->lane_count; lane++) {
+            if (loop->lanes[lane].queue != NULL) {
+                if (loop->queue_set != NULL) {
+                    xQueueRemoveFromSet(loop->lanes[lane].queue, loop->queue_set);
+                }
+                vQueueDelete(loop->lanes[lane].queue);
+            }
+        }
+    }
+
+    if (loop->queue_set != NULL) {
+        vQueueDelete(loop->queue_set);
+    }
+
+    free(loop->lanes);
+}
+
 static void esp_event_loop_run_task(void* args)
 {
     esp_err_t err;
@@ -141,11 +296,334 @@ static void handler_execute(esp_event_loop_instance_t* loop, esp_event_handler_n
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     diff = esp_timer_get_time() - start;
 
+    xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
     handler->invoked++;
     handler->time += diff;
+    xSemaphoreGiveRecursive(loop->mutex);
 #endif
 }
 
+static inline uint32_t dispatch_hash(esp_event_base_t base, int32_t id)
+{
+    return (((uint32_t)(uintptr_t) base) >> 2) ^ ((uint32_t) id * 2654435761u);
+}
+
+static esp_event_dispatch_entry_t* dispatch_table_slot(const esp_event_dispatch_table_t* table, esp_event_base_t base, int32_t id)
+{
+    // At least half of the entries are unused, so the probe always ends at the matching entry or at an unused one
+    size_t i = dispatch_hash(base, id) & table->mask;
+    while (table->entries[i].base != NULL && (table->entries[i].base != base || table->entries[i].id != id)) {
+        i = (i + 1) & table->mask;
+    }
+    return &(table->entries[i]);
+}
+
+// Collects the handlers executed for an event in the same order as dispatch_from_lists executes them. Only the
+// loop level handlers are collected if base is NULL. Returns the number of handlers, which are stored to handlers
+// unless it is NULL.
+static uint32_t dispatch_collect(esp_event_loop_instance_t* loop, esp_event_base_t base, int32_t id, esp_event_handler_node_t** handlers)
+{
+    esp_event_handler_node_t *handler;
+    esp_event_loop_node_t *loop_node;
+    esp_event_base_node_t *base_node;
+    esp_event_id_node_t *id_node;
+    uint32_t count = 0;
+
+    SLIST_FOREACH(loop_node, &(loop->loop_nodes), next) {
+        SLIST_FOREACH(handler, &(loop_node->handlers), next) {
+            if (handlers) {
+                handlers[count] = handler;
+            }
+            count++;
+        }
+
+        if (base == NULL) {
+            continue;
+        }
+
+        SLIST_FOREACH(base_node, &(loop_node->base_nodes), next) {
+            if (base_node->base == base) {
+                SLIST_FOREACH(handler, &(base_node->handlers), next) {
+                    if (handlers) {
+                        handlers[count] = handler;
+                    }
+                    count++;
+                }
+
+                SLIST_FOREACH(id_node, &(base_node->id_nodes), next) {
+                    if (id_node->id == id) {
+                        SLIST_FOREACH(handler, &(id_node->handlers), next) {
+                            if (handlers) {
+                                handlers[count] = handler;
+                            }
+                            count++;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+static uint32_t dispatch_table_add(esp_event_loop_instance_t* loop, esp_event_dispatch_table_t* table, esp_event_base_t base, int32_t id)
+{
+    esp_event_dispatch_entry_t* entry = dispatch_table_slot(table, base, id);
+
+    if (entry->base != NULL) {
+        // Same base or id registered in another node, the entry already contains its handlers
+        return 0;
+    }
+
+    entry->base = base;
+    entry->id = id;
+    entry->count = dispatch_collect(loop, base, id, NULL);
+
+    return entry->count;
+}
+
+static void dispatch_table_free(esp_event_dispatch_table_t* table)
+{
+    free(table->handlers);
+    free(table);
+}
+
+// Builds the dispatch table from the handler lists, must be called with the loop mutex taken
+static esp_event_dispatch_table_t* dispatch_table_create(esp_event_loop_instance_t* loop)
+{
+    esp_event_loop_node_t *loop_node;
+    esp_event_base_node_t *base_node;
+    esp_event_id_node_t *id_node;
+
+    // Every base node and every id node adds at most one entry
+    size_t keys = 0;
+
+    SLIST_FOREACH(loop_node, &(loop->loop_nodes), next) {
+        SLIST_FOREACH(base_node, &(loop_node->base_nodes), next) {
+            keys++;
+            SLIST_FOREACH(id_node, &(base_node->id_nodes), next) {
+                keys++;
+            }
+        }
+    }
+
+    size_t capacity = 4;
+    while (capacity < keys * 2) {
+        capacity *= 2;
+    }
+
+    esp_event_dispatch_table_t* table = calloc(1, sizeof(*table) + capacity * sizeof(esp_event_dispatch_entry_t));
+
+    if (!table) {
+        return NULL;
+    }
+
+    table->entries = (esp_event_dispatch_entry_t*) (table + 1);
+    table->mask = capacity - 1;
+
+    // Events of a base with handlers, but no id level handlers for the event id, execute the handlers of the
+    // (base, ESP_EVENT_ANY_ID) entry. Events of a base without handlers execute only the loop level handlers.
+    table->loop_count = dispatch_collect(loop, NULL, ESP_EVENT_ANY_ID, NULL);
+    uint32_t total = table->loop_count;
+
+    SLIST_FOREACH(loop_node, &(loop->loop_nodes), next) {
+        SLIST_FOREACH(base_node, &(loop_node->base_nodes), next) {
+            total += dispatch_table_add(loop, table, base_node->base, ESP_EVENT_ANY_ID);
+            SLIST_FOREACH(id_node, &(base_node->id_nodes), next) {
+                total += dispatch_table_add(loop, table, base_node->base, id_node->id);
+            }
+        }
+    }
+
+    if (total > 0) {
+        table->handlers = calloc(total, sizeof(esp_event_handler_node_t*));
+
+        if (!table->handlers) {
+            free(table);
+            return NULL;
+        }
+
+        uint32_t first = dispatch_collect(loop, NULL, ESP_EVENT_ANY_ID, table->handlers);
+
+        for (size_t i = 0; i < capacity; i++) {
+            esp_event_dispatch_entry_t* entry = &(table->entries[i]);
+            if (entry->base != NULL) {
+                entry->first = first;
+                first += dispatch_collect(loop, entry->base, entry->id, table->handlers + first);
+            }
+        }
+    }
+
+    return table;
+}
+
+// Frees the retired dispatch tables and handlers if no dispatch is in progress, must be called with the loop
+// mutex taken
+static void dispatch_reclaim(esp_event_loop_instance_t* loop)
+{
+    if (!atomic_load(&loop->dispatch_retired) || atomic_load(&loop->dispatch_readers) != 0) {
+        return;
+    }
+
+    atomic_store(&loop->dispatch_retired, false);
+
+    esp_event_dispatch_table_t *table, *temp_table;
+    SLIST_FOREACH_SAFE(table, &(loop->retired_tables), next, temp_table) {
+        dispatch_table_free(table);
+    }
+    SLIST_INIT(&(loop->retired_tables));
+
+    esp_event_handler_node_t *handler, *temp_handler;
+    SLIST_FOREACH_SAFE(handler, &(loop->retired_handlers), next, temp_handler) {
+        free(handler->handler_ctx);
+        free(handler);
+    }
+    SLIST_INIT(&(loop->retired_handlers));
+}
+
+static void dispatch_table_retire(esp_event_loop_instance_t* loop, esp_event_dispatch_table_t* table)
+{
+    if (table) {
+        SLIST_INSERT_HEAD(&(loop->retired_tables), table, next);
+        atomic_store(&loop->dispatch_retired, true);
+    }
+}
+
+// Replaces the dispatch table after the handler lists were changed, must be called with the loop mutex taken
+static void dispatch_table_update(esp_event_loop_instance_t* loop)
+{
+    esp_event_dispatch_table_t* table = dispatch_table_create(loop);
+
+    if (!table) {
+        // Not fatal, events are dispatched from the handler lists until the next successful update
+        ESP_LOGW(TAG, "alloc for dispatch table of loop %p failed", loop);
+    }
+
+    dispatch_table_retire(loop, atomic_exchange(&loop->dispatch_table, table));
+    dispatch_reclaim(loop);
+}
+
+// Executes the handlers of the event by walking the handler lists, must be called with the loop mutex taken
+static bool dispatch_from_lists(esp_event_loop_instance_t* loop, esp_event_post_instance_t post)
+{
+    bool exec = false;
+
+    esp_event_handler_node_t *handler, *temp_handler;
+    esp_event_loop_node_t *loop_node, *temp_node;
+    esp_event_base_node_t *base_node, *temp_base;
+    esp_event_id_node_t *id_node, *temp_id_node;
+
+    SLIST_FOREACH_SAFE(loop_node, &(loop->loop_nodes), next, temp_node) {
+        // Execute loop level handlers
+        SLIST_FOREACH_SAFE(handler, &(loop_node->handlers), next, temp_handler) {
+            if (!handler->unregistered) {
+                handler_execute(loop, handler, post);
+                exec |= true;
+            }
+        }
+
+        SLIST_FOREACH_SAFE(base_node, &(loop_node->base_nodes), next, temp_base) {
+            if (base_node->base == post.base) {
+                // Execute base level handlers
+                SLIST_FOREACH_SAFE(handler, &(base_node->handlers), next, temp_handler) {
+                    if (!handler->unregistered) {
+                        handler_execute(loop, handler, post);
+                        exec |= true;
+                    }
+                }
+
+                SLIST_FOREACH_SAFE(id_node, &(base_node->id_nodes), next, temp_id_node) {
+                    if (id_node->id == post.id) {
+                        // Execute id level handlers
+                        SLIST_FOREACH_SAFE(handler, &(id_node->handlers), next, temp_handler) {
+                            if (!handler->unregistered) {
+                                handler_execute(loop, handler, post);
+                                exec |= true;
+                            }
+                        }
+                        // Skip to next base node
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return exec;
+}
+
+// Executes the handlers of the event found in the dispatch table
+static bool dispatch_from_table(esp_event_loop_instance_t* loop, const esp_event_dispatch_table_t* table,
+                                esp_event_post_instance_t post)
+{
+    bool exec = false;
+
+    const esp_event_dispatch_entry_t* entry = dispatch_table_slot(table, post.base, post.id);
+
+    if (entry->base == NULL) {
+        entry = dispatch_table_slot(table, post.base, ESP_EVENT_ANY_ID);
+    }
+
+    uint32_t first = 0, count = table->loop_count;
+
+    if (entry->base != NULL) {
+        first = entry->first;
+        count = entry->count;
+    }
+
+    for (uint32_t i = first; i < first + count; i++) {
+        esp_event_handler_node_t* handler = table->handlers[i];
+        if (!handler->unregistered) {
+            handler_execute(loop, handler, post);
+            exec = true;
+        }
+    }
+
+    return exec;
+}
+
+// Executes the handlers of the events, in order, must be called with the dispatch mutex taken. The handlers are
+// looked up in the dispatch table without taking the loop mutex. Handlers registered or unregistered meanwhile
+// replace the table, the tables loaded here and the handlers they point to stay allocated until dispatch_readers
+// drops back to zero. The table is loaded again for every event, so that registrations done by the handlers of an
+// event apply to the following events of a batch. If there is no table, the handler lists are walked with the
+// mutex taken instead.
+static void dispatch(esp_event_loop_instance_t* loop, const esp_event_post_instance_t* posts, size_t post_count)
+{
+    atomic_fetch_add(&loop->dispatch_readers, 1);
+
+    for (size_t i = 0; i < post_count; i++) {
+        esp_event_dispatch_table_t* table = atomic_load(&loop->dispatch_table);
+        bool exec;
+
+        if (table) {
+            exec = dispatch_from_table(loop, table, posts[i]);
+        } else {
+            xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
+            bool lists_in_use = loop->lists_in_use;
+            loop->lists_in_use = true;
+            exec = dispatch_from_lists(loop, posts[i]);
+            loop->lists_in_use = lists_in_use;
+            xSemaphoreGiveRecursive(loop->mutex);
+        }
+
+        if (!exec) {
+            // No handlers were registered, not even loop/base level handlers
+            ESP_LOGD(TAG, "no handlers have been registered for event %s:%"PRIu32" posted to loop %p", posts[i].base, posts[i].id, loop);
+        }
+    }
+
+    atomic_fetch_sub(&loop->dispatch_readers, 1);
+
+    if (atomic_load(&loop->dispatch_retired)) {
+        xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
+        dispatch_reclaim(loop);
+        xSemaphoreGiveRecursive(loop->mutex);
+    }
+}
+
 static esp_err_t handler_instances_add(esp_event_handler_nodes_t* handlers, esp_event_handler_t event_handler, void* event_handler_arg, esp_event_handler_instance_context_t **handler_ctx, bool legacy)
 {
     esp_event_handler_node_t *handler_instance = calloc(1, sizeof(*handler_instance));
@@ -302,7 +780,16 @@ static esp_err_t loop_node_add_handler(esp_event_loop_node_t* loop_node,
     }
 }
 
-static esp_err_t handler_instances_remove(esp_event_handler_nodes_t* handlers, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
+static void handler_instance_retire(esp_event_loop_instance_t* loop, esp_event_handler_node_t* handler)
+{
+    // A dispatch which loaded the dispatch table before the handler was removed may still reach the handler,
+    // so it is only marked as unregistered here and freed by dispatch_reclaim once no dispatch is in progress.
+    handler->unregistered = true;
+    SLIST_INSERT_HEAD(&(loop->retired_handlers), handler, next);
+    atomic_store(&loop->dispatch_retired, true);
+}
+
+static esp_err_t handler_instances_remove(esp_event_loop_instance_t* loop, esp_event_handler_nodes_t* handlers, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
 {
     esp_event_handler_node_t *it, *temp;
 
@@ -310,15 +797,13 @@ static esp_err_t handler_instances_remove(esp_event_handler_nodes_t* handlers, e
         if (legacy) {
             if (it->handler_ctx->handler == handler_ctx->handler) {
                 SLIST_REMOVE(handlers, it, esp_event_handler_node, next);
-                free(it->handler_ctx);
-                free(it);
+                handler_instance_retire(loop, it);
                 return ESP_OK;
             }
         } else {
             if (it->handler_ctx == handler_ctx) {
                 SLIST_REMOVE(handlers, it, esp_event_handler_node, next);
-                free(it->handler_ctx);
-                free(it);
+                handler_instance_retire(loop, it);
                 return ESP_OK;
             }
         }
@@ -327,15 +812,15 @@ static esp_err_t handler_instances_remove(esp_event_handler_nodes_t* handlers, e
     return ESP_ERR_NOT_FOUND;
 }
 
-static esp_err_t base_node_remove_handler(esp_event_base_node_t* base_node, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
+static esp_err_t base_node_remove_handler(esp_event_loop_instance_t* loop, esp_event_base_node_t* base_node, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
 {
     if (id == ESP_EVENT_ANY_ID) {
-        return handler_instances_remove(&(base_node->handlers), handler_ctx, legacy);
+        return handler_instances_remove(loop, &(base_node->handlers), handler_ctx, legacy);
     } else {
         esp_event_id_node_t *it, *temp;
         SLIST_FOREACH_SAFE(it, &(base_node->id_nodes), next, temp) {
             if (it->id == id) {
-                esp_err_t res = handler_instances_remove(&(it->handlers), handler_ctx, legacy);
+                esp_err_t res = handler_instances_remove(loop, &(it->handlers), handler_ctx, legacy);
 
                 if (res == ESP_OK) {
                     if (SLIST_EMPTY(&(it->handlers))) {
@@ -351,15 +836,15 @@ static esp_err_t base_node_remove_handler(esp_event_base_node_t* base_node, int3
     return ESP_ERR_NOT_FOUND;
 }
 
-static esp_err_t loop_node_remove_handler(esp_event_loop_node_t* loop_node, esp_event_base_t base, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
+static esp_err_t loop_node_remove_handler(esp_event_loop_instance_t* loop, esp_event_loop_node_t* loop_node, esp_event_base_t base, int32_t id, esp_event_handler_instance_context_t* handler_ctx, bool legacy)
 {
     if (base == esp_event_any_base && id == ESP_EVENT_ANY_ID) {
-        return handler_instances_remove(&(loop_node->handlers), handler_ctx, legacy);
+        return handler_instances_remove(loop, &(loop_node->handlers), handler_ctx, legacy);
     } else {
         esp_event_base_node_t *it, *temp;
         SLIST_FOREACH_SAFE(it, &(loop_node->base_nodes), next, temp) {
             if (it->base == base) {
-                esp_err_t res = base_node_remove_handler(it, id, handler_ctx, legacy);
+                esp_err_t res = base_node_remove_handler(loop, it, id, handler_ctx, legacy);
 
                 if (res == ESP_OK) {
                     if (SLIST_EMPTY(&(it->handlers)) && SLIST_EMPTY(&(it->id_nodes))) {
@@ -379,13 +864,14 @@ static esp_err_t loop_remove_handler(esp_event_remove_handler_context_t* ctx)
 {
     esp_event_loop_node_t *it, *temp;
     SLIST_FOREACH_SAFE(it, &(ctx->loop->loop_nodes), next, temp) {
-        esp_err_t res = loop_node_remove_handler(it, ctx->event_base, ctx->event_id, ctx->handler_ctx, ctx->legacy);
+        esp_err_t res = loop_node_remove_handler(ctx->loop, it, ctx->event_base, ctx->event_id, ctx->handler_ctx, ctx->legacy);
 
         if (res == ESP_OK) {
             if (SLIST_EMPTY(&(it->base_nodes)) && SLIST_EMPTY(&(it->handlers))) {
                 SLIST_REMOVE(&(ctx->loop->loop_nodes), it, esp_event_loop_node, next);
                 free(it);
             }
+            dispatch_table_update(ctx->loop);
             return ESP_OK;
         }
     }
@@ -426,13 +912,15 @@ static void loop_node_remove_all_handler(esp_event_loop_node_t* loop_node)
     }
 }
 
-static void inline __attribute__((always_inline)) post_instance_delete(esp_event_post_instance_t* post)
+static void inline __attribute__((always_inline)) post_instance_delete(esp_event_loop_instance_t* loop, esp_event_post_instance_t* post)
 {
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
     if (post->data_allocated)
 #endif
     {
-        free(post->data.ptr);
+        if (!data_pool_free(&loop->data_pool, post->data.ptr)) {
+            free(post->data.ptr);
+        }
     }
     memset(post, 0, sizeof(*post));
 }
@@ -532,7 +1020,9 @@ static esp_err_t find_and_unregister_handler(esp_event_remove_handler_context_t*
         handler_ctx_copy->handler = ctx->handler_ctx->handler;
         ctx->handler_ctx = handler_ctx_copy;
     }
-    return esp_event_post_to(ctx->loop, esp_event_handler_cleanup, 0, ctx, sizeof(esp_event_remove_handler_context_t), portMAX_DELAY);
+    /* post to the highest lane, which is received first, so that a busy lower lane doesn't delay the removal */
+    return post_to_lane(ctx->loop, ctx->loop->lane_count - 1, esp_event_handler_cleanup, 0, ctx,
+                        sizeof(esp_event_remove_handler_context_t), portMAX_DELAY);
 }
 
 /* ---------------------------- Public API --------------------------------- */
@@ -558,19 +1048,64 @@ esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, es
         return err;
     }
 
-    loop->queue = xQueueCreate(event_loop_args->queue_size, sizeof(esp_event_post_instance_t));
-    if (loop->queue == NULL) {
-        ESP_LOGE(TAG, "create event loop queue failed");
+    loop->lane_count = event_loop_args->lane_count > 1 ? event_loop_args->lane_count : 1;
+    loop->lanes = calloc(loop->lane_count, sizeof(*loop->lanes));
+    if (loop->lanes == NULL) {
+        ESP_LOGE(TAG, "alloc for event loop lanes failed");
         goto on_err;
     }
 
+    for (uint32_t lane = 0; lane < loop->lane_count; lane++) {
+        loop->lanes[lane].queue = xQueueCreate(event_loop_args->queue_size, sizeof(esp_event_post_instance_t));
+        if (loop->lanes[lane].queue == NULL) {
+            ESP_LOGE(TAG, "create event loop queue failed");
+            goto on_err;
+        }
+        atomic_init(&loop->lanes[lane].max_depth, 0);
+        atomic_init(&loop->lanes[lane].dropped, 0);
+    }
+
+    // The loop waits on a set of the queues of all lanes, so that it's unblocked by an event in any lane
+    if (loop->lane_count > 1) {
+        loop->queue_set = xQueueCreateSet(event_loop_args->queue_size * loop->lane_count);
+        if (loop->queue_set == NULL) {
+            ESP_LOGE(TAG, "create event loop queue set failed");
+            goto on_err;
+        }
+
+        for (uint32_t lane = 0; lane < loop->lane_count; lane++) {
+            xQueueAddToSet(loop->lanes[lane].queue, loop->queue_set);
+        }
+    }
+
+    portMUX_INITIALIZE(&loop->base_lanes_lock);
+
     loop->mutex = xSemaphoreCreateRecursiveMutex();
     if (loop->mutex == NULL) {
         ESP_LOGE(TAG, "create event loop mutex failed");
         goto on_err;
     }
 
+    loop->dispatch_mutex = xSemaphoreCreateRecursiveMutex();
+    if (loop->dispatch_mutex == NULL) {
+        ESP_LOGE(TAG, "create event loop dispatch mutex failed");
+        goto on_err;
+    }
+
+    if (data_pool_init(&loop->data_pool, event_loop_args->data_pool_block_size, event_loop_args->data_pool_block_count) != ESP_OK) {
+        ESP_LOGE(TAG, "alloc for event data pool failed");
+        goto on_err;
+    }
+
     SLIST_INIT(&(loop->loop_nodes));
+    SLIST_INIT(&(loop->retired_tables));
+    SLIST_INIT(&(loop->retired_handlers));
+    atomic_init(&loop->dispatch_readers, 0);
+    atomic_init(&loop->dispatch_retired, false);
+    atomic_init(&loop->dispatch_table, NULL);
+
+    // Without the table, the events would be dispatched from the handler lists, which is slower but correct
+    dispatch_table_update(loop);
 
     // Create the loop task if requested
     if (event_loop_args->task_name != NULL) {
@@ -607,25 +1142,32 @@ esp_err_t esp_event_loop_create(const esp_event_loop_args_t* event_loop_args, es
     return ESP_OK;
 
 on_err:
-    if (loop->queue != NULL) {
-        vQueueDelete(loop->queue);
-    }
+    loop_lanes_delete(loop);
 
     if (loop->mutex != NULL) {
         vSemaphoreDelete(loop->mutex);
     }
 
+    if (loop->dispatch_mutex != NULL) {
+        vSemaphoreDelete(loop->dispatch_mutex);
+    }
+
+    esp_event_dispatch_table_t* table = atomic_load(&loop->dispatch_table);
+    if (table != NULL) {
+        dispatch_table_free(table);
+    }
+
+    free(loop->data_pool.blocks);
     free(loop);
 
     return err;
 }
 
-// On event lookup performance: The library implements the event list as a linked list, which results to O(n)
-// lookup time. The test comparing this implementation to the O(lg n) performance of rbtrees
-// (https://github.com/freebsd/freebsd/blob/master/sys/sys/tree.h)
-// indicate that the difference is not that substantial, especially considering the additional
-// pointers per node of rbtrees. Code for the rbtree implementation of the event loop library is archived
-// in feature/esp_event_loop_library_rbtrees if needed.
+// On event lookup performance: The library keeps the registered handlers in linked lists, which results to O(n)
+// lookup time. Since registration is rare compared to dispatch, every change of the lists also rebuilds a hash
+// table from the event base and id to the array of handlers to execute (see dispatch_table_create), so that
+// the lookup during dispatch is O(1) and doesn't need the loop mutex. The dispatch mutex, which is only taken by the
+// tasks running the loop and by the tasks waiting for them to finish a dispatch, is held while an event is executed.
 esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t ticks_to_run)
 {
     assert(event_loop);
@@ -641,16 +1183,18 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
     int64_t remaining_ticks = ticks_to_run;
 #endif
 
-    while (xQueueReceive(loop->queue, &post, remaining_ticks) == pdTRUE) {
-        // The event has already been unqueued, so ensure it gets executed.
-        xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
+    while (loop_receive(loop, &post, remaining_ticks) == pdTRUE) {
+        xSemaphoreTakeRecursive(loop->dispatch_mutex, portMAX_DELAY);
 
         // check if the event retrieve from the queue is the internal event that is
         // triggered when a handler needs to be removed..
         if (post.base == esp_event_handler_cleanup) {
             assert(post.data.ptr != NULL);
             esp_event_remove_handler_context_t* ctx = (esp_event_remove_handler_context_t*)post.data.ptr;
+
+            xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
             loop_remove_handler(ctx);
+            xSemaphoreGiveRecursive(loop->mutex);
 
             // if the handler unregistration request came from legacy code,
             // we have to free handler_ctx pointer since it points to memory
@@ -662,74 +1206,30 @@ esp_err_t esp_event_loop_run(esp_event_loop_handle_t event_loop, TickType_t tick
 
         loop->running_task = xTaskGetCurrentTaskHandle();
 
-        bool exec = false;
-
-        esp_event_handler_node_t *handler, *temp_handler;
-        esp_event_loop_node_t *loop_node, *temp_node;
-        esp_event_base_node_t *base_node, *temp_base;
-        esp_event_id_node_t *id_node, *temp_id_node;
-
-        SLIST_FOREACH_SAFE(loop_node, &(loop->loop_nodes), next, temp_node) {
-            // Execute loop level handlers
-            SLIST_FOREACH_SAFE(handler, &(loop_node->handlers), next, temp_handler) {
-                if (!handler->unregistered) {
-                    handler_execute(loop, handler, post);
-                    exec |= true;
-                }
-            }
-
-            SLIST_FOREACH_SAFE(base_node, &(loop_node->base_nodes), next, temp_base) {
-                if (base_node->base == post.base) {
-                    // Execute base level handlers
-                    SLIST_FOREACH_SAFE(handler, &(base_node->handlers), next, temp_handler) {
-                        if (!handler->unregistered) {
-                            handler_execute(loop, handler, post);
-                            exec |= true;
-                        }
-                    }
-
-                    SLIST_FOREACH_SAFE(id_node, &(base_node->id_nodes), next, temp_id_node) {
-                        if (id_node->id == post.id) {
-                            // Execute id level handlers
-                            SLIST_FOREACH_SAFE(handler, &(id_node->handlers), next, temp_handler) {
-                                if (!handler->unregistered) {
-                                    handler_execute(loop, handler, post);
-                                    exec |= true;
-                                }
-                            }
-                            // Skip to next base node
-                            break;
-                        }
-                    }
-                }
-            }
+        // The event has already been unqueued, so ensure it gets executed. The events of a batch are
+        // all executed at once, see esp_event_post_batch_to.
+        if (post.base == esp_event_batch) {
+            dispatch(loop, (const esp_event_post_instance_t*) post.data.ptr, post.id);
+        } else {
+            dispatch(loop, &post, 1);
         }
 
-        esp_event_base_t base = post.base;
-        int32_t id = post.id;
+        post_instance_delete(loop, &post);
+
+        loop->running_task = NULL;
 
-        post_instance_delete(&post);
+        xSemaphoreGiveRecursive(loop->dispatch_mutex);
 
         if (ticks_to_run != portMAX_DELAY) {
             end = xTaskGetTickCount();
             remaining_ticks -= end - marker;
             // If the ticks to run expired, return to the caller
             if (remaining_ticks <= 0) {
-                xSemaphoreGiveRecursive(loop->mutex);
                 break;
             } else {
                 marker = end;
             }
         }
-
-        loop->running_task = NULL;
-
-        xSemaphoreGiveRecursive(loop->mutex);
-
-        if (!exec) {
-            // No handlers were registered, not even loop/base level handlers
-            ESP_LOGD(TAG, "no handlers have been registered for event %s:%"PRIu32" posted to loop %p", base, id, event_loop);
-        }
     }
 
     return ESP_OK;
@@ -742,7 +1242,10 @@ esp_err_t esp_event_loop_delete(esp_event_loop_handle_t event_loop)
 
     esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
     SemaphoreHandle_t loop_mutex = loop->mutex;
+    SemaphoreHandle_t dispatch_mutex = loop->dispatch_mutex;
 
+    // Wait for the dispatch in progress to finish, unless the caller is executing it
+    xSemaphoreTakeRecursive(loop->dispatch_mutex, portMAX_DELAY);
     xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
@@ -764,18 +1267,29 @@ esp_err_t esp_event_loop_delete(esp_event_loop_handle_t event_loop)
         free(it);
     }
 
-    // Drop existing posts on the queue
+    // Free the current and retired dispatch tables and the retired handlers, unless the caller is a handler of
+    // the loop, whose dispatch still uses them
+    dispatch_table_retire(loop, atomic_exchange(&loop->dispatch_table, NULL));
+    dispatch_reclaim(loop);
+
+    // Drop existing posts on the queues
     esp_event_post_instance_t post;
-    while (xQueueReceive(loop->queue, &post, 0) == pdTRUE) {
-        post_instance_delete(&post);
+    for (uint32_t lane = 0; lane < loop->lane_count; lane++) {
+        while (xQueueReceive(loop->lanes[lane].queue, &post, 0) == pdTRUE) {
+            post_instance_delete(loop, &post);
+        }
     }
 
     // Cleanup loop
-    vQueueDelete(loop->queue);
+    loop_lanes_delete(loop);
+    free(loop->base_lanes);
+    free(loop->data_pool.blocks);
     free(loop);
-    // Free loop mutex before deleting
+    // Free loop mutexes before deleting
     xSemaphoreGiveRecursive(loop_mutex);
     vSemaphoreDelete(loop_mutex);
+    xSemaphoreGiveRecursive(dispatch_mutex);
+    vSemaphoreDelete(dispatch_mutex);
 
     return ESP_OK;
 }
@@ -838,6 +1352,10 @@ esp_err_t esp_event_handler_register_with_internal(esp_event_loop_handle_t event
         err = loop_node_add_handler(last_loop_node, event_base, event_id, event_handler, event_handler_arg, handler_ctx_arg, legacy);
     }
 
+    if (err == ESP_OK) {
+        dispatch_table_update(loop);
+    }
+
 on_err:
     xSemaphoreGiveRecursive(loop->mutex);
     return err;
@@ -874,16 +1392,23 @@ esp_err_t esp_event_handler_unregister_with_internal(esp_event_loop_handle_t eve
     esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
     esp_event_remove_handler_context_t remove_handler_ctx = {loop, event_base, event_id, handler_ctx, legacy};
 
-    /* remove the handler if the mutex is taken successfully.
-     * otherwise it will be removed from the list later */
+    /* remove the handler right away, unless a handler executed by dispatch_from_lists in this task
+     * is unregistering. In that case it will be removed from the list later */
     esp_err_t res = ESP_FAIL;
-    if (xSemaphoreTake(loop->mutex, 0) == pdTRUE) {
+    xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
+    if (!loop->lists_in_use) {
         res = loop_remove_handler(&remove_handler_ctx);
-        xSemaphoreGive(loop->mutex);
     } else {
-        xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
         res = find_and_unregister_handler(&remove_handler_ctx);
-        xSemaphoreGiveRecursive(loop->mutex);
+    }
+    xSemaphoreGiveRecursive(loop->mutex);
+
+    /* a dispatch in progress may have looked up the handler before it was removed, wait for it to finish
+     * so that the handler no longer runs once this returns. The dispatch mutex is recursive, so this
+     * doesn't wait if the caller is a handler executed by the loop */
+    if (res == ESP_OK) {
+        xSemaphoreTakeRecursive(loop->dispatch_mutex, portMAX_DELAY);
+        xSemaphoreGiveRecursive(loop->dispatch_mutex);
     }
 
     return res;
@@ -909,23 +1434,58 @@ esp_err_t esp_event_handler_instance_unregister_with(esp_event_loop_handle_t eve
     return esp_event_handler_unregister_with_internal(event_loop, event_base, event_id, (esp_event_handler_instance_context_t*) handler_ctx_arg, false);
 }
 
-esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id,
-                            const void* event_data, size_t event_data_size, TickType_t ticks_to_wait)
+// Sends the post to the queue of the lane, without blocking if the caller is the task running the loop
+static BaseType_t post_instance_send(esp_event_loop_instance_t* loop, uint32_t lane, const esp_event_post_instance_t* post, TickType_t ticks_to_wait)
 {
-    assert(event_loop);
+    BaseType_t result = pdFALSE;
+    QueueHandle_t queue = loop->lanes[lane].queue;
 
-    if (event_base == ESP_EVENT_ANY_BASE || event_id == ESP_EVENT_ANY_ID) {
-        return ESP_ERR_INVALID_ARG;
+    // Find the task that currently executes the loop. It is safe to query loop->task since it is
+    // not mutated since loop creation. ENSURE THIS REMAINS TRUE.
+    if (loop->task == NULL) {
+        // The loop has no dedicated task. Find out what task is currently running it.
+        result = xSemaphoreTakeRecursive(loop->mutex, ticks_to_wait);
+
+        if (result == pdTRUE) {
+            if (loop->running_task != xTaskGetCurrentTaskHandle()) {
+                xSemaphoreGiveRecursive(loop->mutex);
+                result = xQueueSendToBack(queue, post, ticks_to_wait);
+            } else {
+                xSemaphoreGiveRecursive(loop->mutex);
+                result = xQueueSendToBack(queue, post, 0);
+            }
+        }
+    } else {
+        // The loop has a dedicated task.
+        if (loop->task != xTaskGetCurrentTaskHandle()) {
+            result = xQueueSendToBack(queue, post, ticks_to_wait);
+        } else {
+            result = xQueueSendToBack(queue, post, 0);
+        }
     }
 
-    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+    if (result == pdTRUE) {
+        lane_update_max_depth(&loop->lanes[lane], uxQueueMessagesWaiting(queue));
+    } else {
+        atomic_fetch_add(&loop->lanes[lane].dropped, 1);
+    }
 
+    return result;
+}
+
+static esp_err_t post_to_lane(esp_event_loop_instance_t* loop, uint32_t lane, esp_event_base_t event_base, int32_t event_id,
+                              const void* event_data, size_t event_data_size, TickType_t ticks_to_wait)
+{
     esp_event_post_instance_t post;
     memset((void*)(&post), 0, sizeof(post));
 
     if (event_data != NULL && event_data_size != 0) {
-        // Make persistent copy of event data on heap.
-        void* event_data_copy = calloc(1, event_data_size);
+        // Make persistent copy of event data in the data pool of the loop, or on heap if it doesn't fit.
+        void* event_data_copy = data_pool_alloc(&loop->data_pool, event_data_size);
+
+        if (event_data_copy == NULL) {
+            event_data_copy = calloc(1, event_data_size);
+        }
 
         if (event_data_copy == NULL) {
             return ESP_ERR_NO_MEM;
@@ -941,48 +1501,203 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t
     post.base = event_base;
     post.id = event_id;
 
-    BaseType_t result = pdFALSE;
+    BaseType_t result = post_instance_send(loop, lane, &post, ticks_to_wait);
 
-    // Find the task that currently executes the loop. It is safe to query loop->task since it is
-    // not mutated since loop creation. ENSURE THIS REMAINS TRUE.
-    if (loop->task == NULL) {
-        // The loop has no dedicated task. Find out what task is currently running it.
-        result = xSemaphoreTakeRecursive(loop->mutex, ticks_to_wait);
+    if (result != pdTRUE) {
+        post_instance_delete(loop, &post);
 
-        if (result == pdTRUE) {
-            if (loop->running_task != xTaskGetCurrentTaskHandle()) {
-                xSemaphoreGiveRecursive(loop->mutex);
-                result = xQueueSendToBack(loop->queue, &post, ticks_to_wait);
-            } else {
-                xSemaphoreGiveRecursive(loop->mutex);
-                result = xQueueSendToBack(loop->queue, &post, 0);
-            }
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+        atomic_fetch_add(&loop->events_dropped, 1);
+#endif
+        return ESP_ERR_TIMEOUT;
+    }
+
+#ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
+    atomic_fetch_add(&loop->events_received, 1);
+#endif
+
+    return ESP_OK;
+}
+
+esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id,
+                            const void* event_data, size_t event_data_size, TickType_t ticks_to_wait)
+{
+    assert(event_loop);
+
+    if (event_base == ESP_EVENT_ANY_BASE || event_id == ESP_EVENT_ANY_ID) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    return post_to_lane(loop, base_lane_get(loop, event_base), event_base, event_id, event_data, event_data_size, ticks_to_wait);
+}
+
+esp_err_t esp_event_post_to_lane(esp_event_loop_handle_t event_loop, uint32_t lane, esp_event_base_t event_base,
+                                 int32_t event_id, const void* event_data, size_t event_data_size, TickType_t ticks_to_wait)
+{
+    assert(event_loop);
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    if (event_base == ESP_EVENT_ANY_BASE || event_id == ESP_EVENT_ANY_ID || lane >= loop->lane_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return post_to_lane(loop, lane, event_base, event_id, event_data, event_data_size, ticks_to_wait);
+}
+
+esp_err_t esp_event_post_batch_to(esp_event_loop_handle_t event_loop, const esp_event_batch_item_t* events,
+                                  size_t event_count, TickType_t ticks_to_wait)
+{
+    assert(event_loop);
+
+    if (events == NULL || event_count == 0 || event_count > INT32_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The posts of all events are followed by the copies of their data in a single allocation, which is sent to
+    // the loop as one post and freed after the loop has executed the handlers of all events.
+    const size_t align = _Alignof(max_align_t);
+    size_t size = event_count * sizeof(esp_event_post_instance_t);
+
+    for (size_t i = 0; i < event_count; i++) {
+        if (events[i].event_base == ESP_EVENT_ANY_BASE || events[i].event_id == ESP_EVENT_ANY_ID) {
+            return ESP_ERR_INVALID_ARG;
         }
-    } else {
-        // The loop has a dedicated task.
-        if (loop->task != xTaskGetCurrentTaskHandle()) {
-            result = xQueueSendToBack(loop->queue, &post, ticks_to_wait);
-        } else {
-            result = xQueueSendToBack(loop->queue, &post, 0);
+
+        if (events[i].event_data != NULL && events[i].event_data_size != 0) {
+            size = ((size + align - 1) & ~(align - 1)) + events[i].event_data_size;
+        }
+    }
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    // A batch is sent as a single post, so it can't be split between lanes without losing the order of its events
+    uint32_t lane = base_lane_get(loop, events[0].event_base);
+    for (size_t i = 1; i < event_count; i++) {
+        if (events[i].event_base != events[0].event_base && base_lane_get(loop, events[i].event_base) != lane) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    uint8_t* batch = calloc(1, size);
+
+    if (batch == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_event_post_instance_t* posts = (esp_event_post_instance_t*) batch;
+    size_t offset = event_count * sizeof(esp_event_post_instance_t);
+
+    for (size_t i = 0; i < event_count; i++) {
+        if (events[i].event_data != NULL && events[i].event_data_size != 0) {
+            offset = (offset + align - 1) & ~(align - 1);
+            memcpy(batch + offset, events[i].event_data, events[i].event_data_size);
+            posts[i].data.ptr = batch + offset;
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+            posts[i].data_allocated = true;
+            posts[i].data_set = true;
+#endif
+            offset += events[i].event_data_size;
         }
+        posts[i].base = events[i].event_base;
+        posts[i].id = events[i].event_id;
     }
 
+    esp_event_post_instance_t post;
+    memset((void*)(&post), 0, sizeof(post));
+
+    post.data.ptr = batch;
+#if CONFIG_ESP_EVENT_POST_FROM_ISR
+    post.data_allocated = true;
+    post.data_set = true;
+#endif
+    post.base = esp_event_batch;
+    post.id = (int32_t) event_count;
+
+    BaseType_t result = post_instance_send(loop, lane, &post, ticks_to_wait);
+
     if (result != pdTRUE) {
-        post_instance_delete(&post);
+        post_instance_delete(loop, &post);
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
-        atomic_fetch_add(&loop->events_dropped, 1);
+        atomic_fetch_add(&loop->events_dropped, event_count);
 #endif
         return ESP_ERR_TIMEOUT;
     }
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
-    atomic_fetch_add(&loop->events_received, 1);
+    atomic_fetch_add(&loop->events_received, event_count);
 #endif
 
     return ESP_OK;
 }
 
+esp_err_t esp_event_loop_set_base_lane(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, uint32_t lane)
+{
+    assert(event_loop);
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    if (event_base == ESP_EVENT_ANY_BASE || lane >= loop->lane_count) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xSemaphoreTakeRecursive(loop->mutex, portMAX_DELAY);
+
+    // Posts read the lanes with the spinlock taken, so the updated array is allocated before taking it
+    esp_event_base_lane_t* base_lanes = calloc(loop->base_lane_count + 1, sizeof(*base_lanes));
+
+    if (base_lanes == NULL) {
+        xSemaphoreGiveRecursive(loop->mutex);
+        return ESP_ERR_NO_MEM;
+    }
+
+    size_t base_lane_count = 0;
+    for (size_t i = 0; i < loop->base_lane_count; i++) {
+        if (loop->base_lanes[i].base != event_base) {
+            base_lanes[base_lane_count++] = loop->base_lanes[i];
+        }
+    }
+
+    // Lane 0 is the lane of the bases which are not in the array
+    if (lane != 0) {
+        base_lanes[base_lane_count].base = event_base;
+        base_lanes[base_lane_count].lane = lane;
+        base_lane_count++;
+    }
+
+    portENTER_CRITICAL(&loop->base_lanes_lock);
+    esp_event_base_lane_t* old_base_lanes = loop->base_lanes;
+    loop->base_lanes = base_lanes;
+    loop->base_lane_count = base_lane_count;
+    portEXIT_CRITICAL(&loop->base_lanes_lock);
+
+    free(old_base_lanes);
+
+    xSemaphoreGiveRecursive(loop->mutex);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_event_loop_get_lane_stats(esp_event_loop_handle_t event_loop, uint32_t lane, esp_event_lane_stats_t* stats)
+{
+    assert(event_loop);
+
+    esp_event_loop_instance_t* loop = (esp_event_loop_instance_t*) event_loop;
+
+    if (lane >= loop->lane_count || stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    stats->depth = uxQueueMessagesWaiting(loop->lanes[lane].queue);
+    stats->max_depth = atomic_load(&loop->lanes[lane].max_depth);
+    stats->dropped = atomic_load(&loop->lanes[lane].dropped);
+
+    return ESP_OK;
+}
+
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
 esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, int32_t event_id,
                                 const void* event_data, size_t event_data_size, BaseType_t* task_unblocked)
@@ -1013,10 +1728,17 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop, esp_event_ba
     BaseType_t result = pdFALSE;
 
     // Post the event from an ISR,
-    result = xQueueSendToBackFromISR(loop->queue, &post, task_unblocked);
+    uint32_t lane = base_lane_get(loop, event_base);
+    result = xQueueSendToBackFromISR(loop->lanes[lane].queue, &post, task_unblocked);
+
+    if (result == pdTRUE) {
+        lane_update_max_depth(&loop->lanes[lane], uxQueueMessagesWaitingFromISR(loop->lanes[lane].queue));
+    } else {
+        atomic_fetch_add(&loop->lanes[lane].dropped, 1);
+    }
 
     if (result != pdTRUE) {
-        post_instance_delete(&post);
+        post_instance_delete(loop, &post);
 
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
         atomic_fetch_add(&loop->events_dropped, 1);
@@ -1062,6 +1784,24 @@ esp_err_t esp_event_dump(FILE* file)
         PRINT_DUMP_INFO(dst, sz, LOOP_DUMP_FORMAT, loop_it, loop_it->task != NULL ? loop_it->name : "none",
                         events_received, events_dropped);
 
+        esp_event_data_pool_t* pool = &(loop_it->data_pool);
+        if (pool->blocks != NULL) {
+            portENTER_CRITICAL(&pool->lock);
+            uint32_t used = pool->used, max_used = pool->max_used, heap_copies = pool->heap_copies;
+            portEXIT_CRITICAL(&pool->lock);
+
+            PRINT_DUMP_INFO(dst, sz, POOL_DUMP_FORMAT, (unsigned) pool->block_count, (unsigned) pool->block_size,
+                            used, max_used, heap_copies);
+        }
+
+        if (loop_it->lane_count > 1) {
+            for (uint32_t lane = 0; lane < loop_it->lane_count; lane++) {
+                esp_event_lane_t* lane_it = &(loop_it->lanes[lane]);
+                PRINT_DUMP_INFO(dst, sz, LANE_DUMP_FORMAT, lane, (unsigned) uxQueueMessagesWaiting(lane_it->queue),
+                                (uint32_t) atomic_load(&lane_it->max_depth), (uint32_t) atomic_load(&lane_it->dropped));
+            }
+        }
+
         int sz_bak = sz;
 
         SLIST_FOREACH(loop_node_it, &(loop_it->loop_nodes), next) {
@@ -8,6 +8,10 @@
 */
 
 #include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <set>
+#include <vector>
 #include "esp_event.h"
 
 #include <catch2/catch_test_macros.hpp>
@@ -17,6 +21,7 @@
 extern "C" {
 #include "Mocktask.h"
 #include "Mockqueue.h"
+#include "Mockportmacro.h"
 }
 
 namespace {
@@ -40,6 +45,119 @@ static esp_event_loop_args_t test_event_get_default_loop_args(void)
 
 void dummy_handler(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id, void* event_data) { }
 
+void counting_handler(void* event_handler_arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
+{
+    (*static_cast<uint32_t*>(event_handler_arg))++;
+}
+
+/**
+ * Queues, queue set and mutex of a loop without dedicated task, which really store the posted events, so that
+ * esp_event_loop_run() can be called with the FreeRTOS mocks.
+ */
+struct FakeQueue : public CMockFix {
+    FakeQueue()
+    {
+        queues = 0;
+        memset(head, 0, sizeof(head));
+        memset(count, 0, sizeof(count));
+        xQueueGenericCreate_Stub([](const UBaseType_t length, const UBaseType_t item_size, const uint8_t type, int num_calls) {
+            REQUIRE(FakeQueue::queues < MAX_QUEUES);
+            REQUIRE(length <= QUEUE_SIZE);
+            REQUIRE(item_size <= MAX_ITEM_SIZE);
+            FakeQueue::item_size = item_size;
+            return FakeQueue::handle(FakeQueue::queues++);
+        });
+        xQueueCreateMutex_IgnoreAndReturn(reinterpret_cast<QueueHandle_t>(0xcafebabe));
+        xQueueTakeMutexRecursive_IgnoreAndReturn(pdTRUE);
+        xQueueGiveMutexRecursive_IgnoreAndReturn(pdTRUE);
+        xTaskGetTickCount_IgnoreAndReturn(0);
+        xTaskGetCurrentTaskHandle_IgnoreAndReturn(reinterpret_cast<TaskHandle_t>(1));
+        xQueueGenericSend_Stub([](QueueHandle_t queue, const void * const item, TickType_t ticks, const BaseType_t position, int num_calls) {
+            size_t q = FakeQueue::index(queue);
+            if (FakeQueue::count[q] == QUEUE_SIZE) {
+                return static_cast<BaseType_t>(pdFALSE);
+            }
+            memcpy(FakeQueue::items[q][(FakeQueue::head[q] + FakeQueue::count[q]) % QUEUE_SIZE], item, FakeQueue::item_size);
+            FakeQueue::count[q]++;
+            return static_cast<BaseType_t>(pdTRUE);
+        });
+        xQueueReceive_Stub([](QueueHandle_t queue, void * const item, TickType_t ticks, int num_calls) {
+            size_t q = FakeQueue::index(queue);
+            if (FakeQueue::count[q] == 0) {
+                return static_cast<BaseType_t>(pdFALSE);
+            }
+            memcpy(item, FakeQueue::items[q][FakeQueue::head[q]], FakeQueue::item_size);
+            FakeQueue::head[q] = (FakeQueue::head[q] + 1) % QUEUE_SIZE;
+            FakeQueue::count[q]--;
+            return static_cast<BaseType_t>(pdTRUE);
+        });
+        uxQueueMessagesWaiting_Stub([](const QueueHandle_t queue, int num_calls) {
+            return static_cast<UBaseType_t>(FakeQueue::count[FakeQueue::index(queue)]);
+        });
+        xQueueCreateSet_IgnoreAndReturn(reinterpret_cast<QueueSetHandle_t>(0xfeedbeef));
+        xQueueAddToSet_IgnoreAndReturn(pdPASS);
+        xQueueRemoveFromSet_IgnoreAndReturn(pdPASS);
+        xQueueSelectFromSet_Stub([](QueueSetHandle_t set, const TickType_t ticks, int num_calls) {
+            for (size_t q = 0; q < FakeQueue::queues; q++) {
+                if (FakeQueue::count[q] != 0) {
+                    return static_cast<QueueSetMemberHandle_t>(FakeQueue::handle(q));
+                }
+            }
+            return static_cast<QueueSetMemberHandle_t>(nullptr);
+        });
+        vQueueDelete_Ignore();
+    }
+
+    ~FakeQueue()
+    {
+        xQueueGenericCreate_Stub(nullptr);
+        xQueueGenericSend_Stub(nullptr);
+        xQueueReceive_Stub(nullptr);
+        uxQueueMessagesWaiting_Stub(nullptr);
+        xQueueSelectFromSet_Stub(nullptr);
+        xQueueCreateMutex_StopIgnore();
+        xQueueTakeMutexRecursive_StopIgnore();
+        xQueueGiveMutexRecursive_StopIgnore();
+        xTaskGetTickCount_StopIgnore();
+        xTaskGetCurrentTaskHandle_StopIgnore();
+        xQueueCreateSet_StopIgnore();
+        xQueueAddToSet_StopIgnore();
+        xQueueRemoveFromSet_StopIgnore();
+        vQueueDelete_StopIgnore();
+    }
+
+    static QueueHandle_t handle(size_t q)
+    {
+        return reinterpret_cast<QueueHandle_t>(&items[q]);
+    }
+
+    static size_t index(QueueHandle_t queue)
+    {
+        for (size_t q = 0; q < queues; q++) {
+            if (queue == handle(q)) {
+                return q;
+            }
+        }
+        FAIL("unknown queue");
+        return 0;
+    }
+
+    static const size_t MAX_QUEUES = 4;
+    static const size_t MAX_ITEM_SIZE = 32;
+
+    static size_t item_size;
+    static size_t queues;
+    static size_t head[MAX_QUEUES];
+    static size_t count[MAX_QUEUES];
+    static uint8_t items[MAX_QUEUES][QUEUE_SIZE][MAX_ITEM_SIZE];
+};
+
+size_t FakeQueue::item_size;
+size_t FakeQueue::queues;
+size_t FakeQueue::head[FakeQueue::MAX_QUEUES];
+size_t FakeQueue::count[FakeQueue::MAX_QUEUES];
+uint8_t FakeQueue::items[FakeQueue::MAX_QUEUES][QUEUE_SIZE][FakeQueue::MAX_ITEM_SIZE];
+
 }
 
 // TODO: IDF-2693, function definition just to satisfy linker, implement esp_common instead
@@ -140,6 +258,222 @@ TEST_CASE("test esp_event_loop_create with_task(void)")
     xQueueGiveMutexRecursive_StopIgnore();
 }
 
+TEST_CASE("benchmark dispatch rate against the number of registered handlers")
+{
+    const char* bases[] = {"base0", "base1", "base2", "base3", "base4", "base5", "base6", "base7"};
+    const size_t base_count = sizeof(bases) / sizeof(bases[0]);
+    const size_t handler_counts[] = {1, 10, 50, 150, 300};
+    const uint32_t events = QUEUE_SIZE * 1600;
+
+    for (size_t handler_count : handler_counts) {
+        FakeQueue queue;
+        esp_event_loop_handle_t loop = nullptr;
+        esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+        loop_args.task_name = nullptr;
+        REQUIRE(ESP_OK == esp_event_loop_create(&loop_args, &loop));
+
+        // Every handler is registered to its own event
+        uint32_t invoked = 0;
+        for (size_t i = 0; i < handler_count; i++) {
+            REQUIRE(ESP_OK == esp_event_handler_register_with(loop, bases[i % base_count], i / base_count,
+                                                              counting_handler, &invoked));
+        }
+
+        std::chrono::nanoseconds elapsed(0);
+        for (uint32_t posted = 0; posted < events; posted += QUEUE_SIZE) {
+            for (uint32_t i = posted; i < posted + QUEUE_SIZE; i++) {
+                size_t handler = i % handler_count;
+                REQUIRE(ESP_OK == esp_event_post_to(loop, bases[handler % base_count], handler / base_count,
+                                                    nullptr, 0, 0));
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            CHECK(ESP_OK == esp_event_loop_run(loop, portMAX_DELAY));
+            elapsed += std::chrono::steady_clock::now() - start;
+        }
+        CHECK(invoked == events);
+
+        printf("handlers: %4zu events/s: %.0f\n", handler_count, events / (elapsed.count() / 1e9));
+
+        CHECK(ESP_OK == esp_event_loop_delete(loop));
+    }
+}
+
+TEST_CASE("event data is copied to the data pool of the loop if it fits")
+{
+    FakeQueue queue;
+    vPortEnterCritical_Ignore();
+    vPortExitCritical_Ignore();
+
+    esp_event_loop_handle_t loop = nullptr;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+    loop_args.task_name = nullptr;
+    loop_args.data_pool_block_size = 8;
+    loop_args.data_pool_block_count = 2;
+    REQUIRE(ESP_OK == esp_event_loop_create(&loop_args, &loop));
+
+    std::vector<std::pair<const void*, std::vector<uint8_t>>> received;
+    esp_event_handler_t record_data = [](void* arg, esp_event_base_t base, int32_t id, void* data) {
+        auto received = static_cast<std::vector<std::pair<const void*, std::vector<uint8_t>>>*>(arg);
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        received->push_back({data, std::vector<uint8_t>(bytes, bytes + id)});
+    };
+    REQUIRE(ESP_OK == esp_event_handler_register_with(loop, "pool", ESP_EVENT_ANY_ID, record_data, &received));
+
+    // The event ID is the size of the data, the third small event doesn't find a free block anymore
+    const uint8_t data[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+    const int32_t sizes[] = {4, 8, 4, 16};
+    for (int32_t size : sizes) {
+        REQUIRE(ESP_OK == esp_event_post_to(loop, "pool", size, data, size, 0));
+    }
+    CHECK(ESP_OK == esp_event_loop_run(loop, portMAX_DELAY));
+
+    REQUIRE(received.size() == 4);
+    for (size_t i = 0; i < received.size(); i++) {
+        CHECK(received[i].second == std::vector<uint8_t>(data, data + sizes[i]));
+    }
+    std::set<const void*> blocks = {received[0].first, received[1].first};
+    CHECK(blocks.size() == 2);
+    CHECK(blocks.count(received[2].first) == 0);
+    CHECK(blocks.count(received[3].first) == 0);
+
+    // The blocks are returned to the pool after the events have been dispatched
+    received.clear();
+    REQUIRE(ESP_OK == esp_event_post_to(loop, "pool", 4, data, 4, 0));
+    REQUIRE(ESP_OK == esp_event_post_to(loop, "pool", 4, data, 4, 0));
+    CHECK(ESP_OK == esp_event_loop_run(loop, portMAX_DELAY));
+
+    REQUIRE(received.size() == 2);
+    CHECK(std::set<const void*>({received[0].first, received[1].first}) == blocks);
+
+    CHECK(ESP_OK == esp_event_loop_delete(loop));
+
+    vPortEnterCritical_StopIgnore();
+    vPortExitCritical_StopIgnore();
+}
+
+TEST_CASE("events posted in a batch take one queue slot and are executed in order")
+{
+    FakeQueue queue;
+
+    esp_event_loop_handle_t loop = nullptr;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+    loop_args.task_name = nullptr;
+    REQUIRE(ESP_OK == esp_event_loop_create(&loop_args, &loop));
+
+    std::vector<std::pair<int32_t, std::vector<uint8_t>>> received;
+    esp_event_handler_t record_event = [](void* arg, esp_event_base_t base, int32_t id, void* data) {
+        auto received = static_cast<std::vector<std::pair<int32_t, std::vector<uint8_t>>>*>(arg);
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        received->push_back({id, data ? std::vector<uint8_t>(bytes, bytes + 3) : std::vector<uint8_t>()});
+    };
+    REQUIRE(ESP_OK == esp_event_handler_register_with(loop, "batch", ESP_EVENT_ANY_ID, record_event, &received));
+
+    const uint8_t data_2[3] = {2, 2, 2};
+    const uint8_t data_4[3] = {4, 4, 4};
+    const esp_event_batch_item_t events[] = {
+        {"batch", 2, data_2, sizeof(data_2)},
+        {"batch", 3, nullptr, 0},
+        {"batch", 4, data_4, sizeof(data_4)},
+    };
+
+    REQUIRE(ESP_OK == esp_event_post_to(loop, "batch", 1, nullptr, 0, 0));
+    REQUIRE(ESP_OK == esp_event_post_batch_to(loop, events, 3, 0));
+    REQUIRE(ESP_OK == esp_event_post_to(loop, "batch", 5, nullptr, 0, 0));
+    CHECK(FakeQueue::count[0] == 3);
+
+    CHECK(ESP_OK == esp_event_loop_run(loop, portMAX_DELAY));
+
+    REQUIRE(received.size() == 5);
+    for (size_t i = 0; i < received.size(); i++) {
+        CHECK(received[i].first == static_cast<int32_t>(i + 1));
+    }
+    CHECK(received[1].second == std::vector<uint8_t>(data_2, data_2 + 3));
+    CHECK(received[2].second.empty());
+    CHECK(received[3].second == std::vector<uint8_t>(data_4, data_4 + 3));
+
+    CHECK(ESP_OK == esp_event_loop_delete(loop));
+}
+
+TEST_CASE("posting a batch with invalid events fails")
+{
+    esp_event_loop_handle_t loop = reinterpret_cast<esp_event_loop_handle_t>(1);
+    const esp_event_batch_item_t events[] = {
+        {"batch", 1, nullptr, 0},
+        {"batch", ESP_EVENT_ANY_ID, nullptr, 0},
+    };
+
+    CHECK(ESP_ERR_INVALID_ARG == esp_event_post_batch_to(loop, nullptr, 1, 0));
+    CHECK(ESP_ERR_INVALID_ARG == esp_event_post_batch_to(loop, events, 0, 0));
+    CHECK(ESP_ERR_INVALID_ARG == esp_event_post_batch_to(loop, events, 2, 0));
+}
+
+TEST_CASE("events of higher priority lanes are executed first")
+{
+    FakeQueue queue;
+    vPortEnterCritical_Ignore();
+    vPortExitCritical_Ignore();
+
+    esp_event_loop_handle_t loop = nullptr;
+    esp_event_loop_args_t loop_args = test_event_get_default_loop_args();
+    loop_args.task_name = nullptr;
+    loop_args.lane_count = 3;
+    REQUIRE(ESP_OK == esp_event_loop_create(&loop_args, &loop));
+
+    std::vector<std::pair<esp_event_base_t, int32_t>> received;
+    esp_event_handler_t record_event = [](void* arg, esp_event_base_t base, int32_t id, void* data) {
+        static_cast<std::vector<std::pair<esp_event_base_t, int32_t>>*>(arg)->push_back({base, id});
+    };
+    REQUIRE(ESP_OK == esp_event_handler_register_with(loop, ESP_EVENT_ANY_BASE, ESP_EVENT_ANY_ID, record_event, &received));
+
+    esp_event_base_t low = "low";
+    esp_event_base_t high = "high";
+    CHECK(ESP_ERR_INVALID_ARG == esp_event_loop_set_base_lane(loop, high, 3));
+    CHECK(ESP_ERR_INVALID_ARG == esp_event_loop_set_base_lane(loop, ESP_EVENT_ANY_BASE, 2));
+    REQUIRE(ESP_OK == esp_event_loop_set_base_lane(loop, high, 2));
+
+    for (int32_t id = 0; id < 3; id++) {
+        REQUIRE(ESP_OK == esp_event_post_to(loop, low, id, nullptr, 0, 0));
+    }
+    REQUIRE(ESP_OK == esp_event_post_to_lane(loop, 1, low, 3, nullptr, 0, 0));
+    REQUIRE(ESP_OK == esp_event_post_to(loop, high, 4, nullptr, 0, 0));
+    CHECK(ESP_ERR_INVALID_ARG == esp_event_post_to_lane(loop, 3, low, 5, nullptr, 0, 0));
+
+    // The events of a batch must all belong to the same lane
+    const esp_event_batch_item_t mixed[] = {
+        {high, 6, nullptr, 0},
+        {low, 7, nullptr, 0},
+    };
+    CHECK(ESP_ERR_INVALID_ARG == esp_event_post_batch_to(loop, mixed, 2, 0));
+
+    esp_event_lane_stats_t stats;
+    REQUIRE(ESP_OK == esp_event_loop_get_lane_stats(loop, 0, &stats));
+    CHECK(stats.depth == 3);
+    CHECK(stats.max_depth == 3);
+    CHECK(stats.dropped == 0);
+    CHECK(ESP_ERR_INVALID_ARG == esp_event_loop_get_lane_stats(loop, 3, &stats));
+
+    CHECK(ESP_OK == esp_event_loop_run(loop, portMAX_DELAY));
+
+    std::vector<std::pair<esp_event_base_t, int32_t>> expected = {{high, 4}, {low, 3}, {low, 0}, {low, 1}, {low, 2}};
+    CHECK(received == expected);
+
+    REQUIRE(ESP_OK == esp_event_loop_get_lane_stats(loop, 0, &stats));
+    CHECK(stats.depth == 0);
+    CHECK(stats.max_depth == 3);
+
+    // Setting lane 0 moves the base back to the default lane
+    REQUIRE(ESP_OK == esp_event_loop_set_base_lane(loop, high, 0));
+    REQUIRE(ESP_OK == esp_event_post_to(loop, high, 5, nullptr, 0, 0));
+    REQUIRE(ESP_OK == esp_event_loop_get_lane_stats(loop, 0, &stats));
+    CHECK(stats.depth == 1);
+
+    CHECK(ESP_OK == esp_event_loop_delete(loop));
+
+    vPortEnterCritical_StopIgnore();
+    vPortExitCritical_StopIgnore();
+}
+
 TEST_CASE("registering with ANY_BASE but specific ID fails")
 {
     esp_event_loop_handle_t loop = reinterpret_cast<esp_event_loop_handle_t>(1);
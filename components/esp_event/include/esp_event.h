@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -29,8 +29,30 @@ typedef struct {
     uint32_t task_stack_size;                   /**< stack size of the event loop task, ignored if task name is NULL */
     BaseType_t task_core_id;                    /**< core to which the event loop task is pinned to,
                                                         ignored if task name is NULL */
+    size_t data_pool_block_size;                /**< size of the blocks of the event data pool, the data of events
+                                                        posted with more data is copied to the heap */
+    size_t data_pool_block_count;               /**< number of blocks of the event data pool; if 0, the data of all
+                                                        events is copied to the heap */
+    uint32_t lane_count;                        /**< number of priority lanes, each with its own queue of queue_size
+                                                        events; 0 is the same as 1 */
 } esp_event_loop_args_t;
 
+/// Statistics of a priority lane of an event loop, the events posted by one esp_event_post_batch_to count as one
+typedef struct {
+    uint32_t depth;                             /**< number of events waiting in the lane */
+    uint32_t max_depth;                         /**< highest number of events which have been waiting in the lane */
+    uint32_t dropped;                           /**< number of events dropped due to the lane being full */
+} esp_event_lane_stats_t;
+
+/// Event posted by esp_event_post_batch_to and esp_event_post_batch
+typedef struct {
+    esp_event_base_t event_base;                /**< the event base that identifies the event */
+    int32_t event_id;                           /**< the event ID that identifies the event */
+    const void *event_data;                     /**< the data, specific to the event occurrence, that gets passed
+                                                        to the handler; can be NULL */
+    size_t event_data_size;                     /**< the size of the event data */
+} esp_event_batch_item_t;
+
 /**
  * @brief Create a new event loop.
  *
@@ -310,6 +332,9 @@ esp_err_t esp_event_handler_unregister_with(esp_event_loop_handle_t event_loop,
  *       unregistered. When using ESP_EVENT_ANY_BASE, events registered to specific bases will also not be
  *       unregistered. This avoids accidental unregistration of handlers registered by other users or components.
  *
+ * @note If the handler is being executed by the task running the loop, this function waits for it to return, so
+ *       that the handler argument can be freed afterwards. It doesn't wait when called from a handler of the loop.
+ *
  * @param[in] event_loop the event loop with which to unregister this handler function, must not be NULL
  * @param[in] event_base the base of the event with which to unregister the handler
  * @param[in] event_id the ID of the event with which to unregister the handler
@@ -397,6 +422,158 @@ esp_err_t esp_event_post_to(esp_event_loop_handle_t event_loop,
                             size_t event_data_size,
                             TickType_t ticks_to_wait);
 
+/**
+ * @brief Posts an event to a priority lane of the default event loop.
+ *
+ * This function behaves in the same manner as esp_event_post, except that the event is posted to the given lane
+ * instead of the lane of its event base.
+ *
+ * @param[in] lane the lane to post to, must be lower than CONFIG_ESP_EVENT_DEFAULT_LOOP_LANES
+ * @param[in] event_base the event base that identifies the event
+ * @param[in] event_id the event ID that identifies the event
+ * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler
+ * @param[in] event_data_size the size of the event data
+ * @param[in] ticks_to_wait number of ticks to block on a full lane
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_TIMEOUT: Time to wait for the lane to unblock expired
+ *  - ESP_ERR_INVALID_ARG: Invalid lane, invalid combination of event base and event ID
+ *  - ESP_ERR_INVALID_STATE: The default event loop has not been created
+ *  - Others: Fail
+ */
+esp_err_t esp_event_post_lane(uint32_t lane,
+                              esp_event_base_t event_base,
+                              int32_t event_id,
+                              const void *event_data,
+                              size_t event_data_size,
+                              TickType_t ticks_to_wait);
+
+/**
+ * @brief Posts an event to a priority lane of the specified event loop.
+ *
+ * Events loops created with more than one lane always take the next event from the highest lane which has one,
+ * so that the events of a lane are not delayed by the events of the lower lanes. Events posted with
+ * esp_event_post_to are posted to the lane of their event base, see esp_event_loop_set_base_lane.
+ *
+ * @param[in] event_loop the event loop to post to, must not be NULL
+ * @param[in] lane the lane to post to, must be lower than the lane_count the event loop was created with
+ * @param[in] event_base the event base that identifies the event
+ * @param[in] event_id the event ID that identifies the event
+ * @param[in] event_data the data, specific to the event occurrence, that gets passed to the handler
+ * @param[in] event_data_size the size of the event data
+ * @param[in] ticks_to_wait number of ticks to block on a full lane
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_TIMEOUT: Time to wait for the lane to unblock expired
+ *  - ESP_ERR_INVALID_ARG: Invalid lane, invalid combination of event base and event ID
+ *  - Others: Fail
+ */
+esp_err_t esp_event_post_to_lane(esp_event_loop_handle_t event_loop,
+                                 uint32_t lane,
+                                 esp_event_base_t event_base,
+                                 int32_t event_id,
+                                 const void *event_data,
+                                 size_t event_data_size,
+                                 TickType_t ticks_to_wait);
+
+/**
+ * @brief Sets the priority lane of the events of an event base posted to the default event loop.
+ *
+ * @param[in] event_base the event base of the events
+ * @param[in] lane the lane of the events, must be lower than CONFIG_ESP_EVENT_DEFAULT_LOOP_LANES
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: Invalid lane or ESP_EVENT_ANY_BASE
+ *  - ESP_ERR_NO_MEM: Cannot allocate memory for the lane of the base
+ *  - ESP_ERR_INVALID_STATE: The default event loop has not been created
+ *  - Others: Fail
+ */
+esp_err_t esp_event_set_base_lane(esp_event_base_t event_base, uint32_t lane);
+
+/**
+ * @brief Sets the priority lane of the events of an event base posted to the specified event loop.
+ *
+ * The events of bases without a lane are posted to lane 0, the lowest priority lane. The lane applies to the
+ * events posted with esp_event_post_to, esp_event_isr_post_to and esp_event_post_batch_to afterwards.
+ *
+ * @param[in] event_loop the event loop, must not be NULL
+ * @param[in] event_base the event base of the events
+ * @param[in] lane the lane of the events, must be lower than the lane_count the event loop was created with
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: Invalid lane or ESP_EVENT_ANY_BASE
+ *  - ESP_ERR_NO_MEM: Cannot allocate memory for the lane of the base
+ *  - Others: Fail
+ */
+esp_err_t esp_event_loop_set_base_lane(esp_event_loop_handle_t event_loop, esp_event_base_t event_base, uint32_t lane);
+
+/**
+ * @brief Gets the statistics of a priority lane of an event loop.
+ *
+ * @param[in] event_loop the event loop, must not be NULL
+ * @param[in] lane the lane, must be lower than the lane_count the event loop was created with
+ * @param[out] stats the statistics of the lane
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_INVALID_ARG: Invalid lane or stats is NULL
+ */
+esp_err_t esp_event_loop_get_lane_stats(esp_event_loop_handle_t event_loop, uint32_t lane, esp_event_lane_stats_t *stats);
+
+/**
+ * @brief Posts several events to the default event loop at once.
+ *
+ * The data of all events is copied to a single allocation and the events are sent to the event loop queue as
+ * a single item, so that the events take one slot of the queue and unblock the event loop task once. The event
+ * loop task then executes the handlers of all events one after the other, in the order of the events array.
+ * The events are posted to the priority lane of their event bases, which must all have the same lane: a batch is
+ * a single item of a queue, splitting it between lanes would change the order of its events.
+ *
+ * @param[in] events the events to post
+ * @param[in] event_count the number of events in the events array
+ * @param[in] ticks_to_wait number of ticks to block on a full event queue
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_TIMEOUT: Time to wait for event queue to unblock expired, no event was posted
+ *  - ESP_ERR_INVALID_ARG: events is NULL, event_count is 0, an event has an invalid combination of
+ *                          event base and event ID or the event bases have different lanes
+ *  - ESP_ERR_NO_MEM: Cannot allocate memory for the event data
+ *  - ESP_ERR_INVALID_STATE: The default event loop has not been created
+ *  - Others: Fail
+ */
+esp_err_t esp_event_post_batch(const esp_event_batch_item_t *events,
+                               size_t event_count,
+                               TickType_t ticks_to_wait);
+
+/**
+ * @brief Posts several events to the specified event loop at once.
+ *
+ * This function behaves in the same manner as esp_event_post_batch, except the additional specification of the
+ * event loop to post the events to.
+ *
+ * @param[in] event_loop the event loop to post to, must not be NULL
+ * @param[in] events the events to post
+ * @param[in] event_count the number of events in the events array
+ * @param[in] ticks_to_wait number of ticks to block on a full event queue
+ *
+ * @return
+ *  - ESP_OK: Success
+ *  - ESP_ERR_TIMEOUT: Time to wait for event queue to unblock expired, no event was posted
+ *  - ESP_ERR_INVALID_ARG: events is NULL, event_count is 0, an event has an invalid combination of
+ *                          event base and event ID or the event bases have different lanes
+ *  - ESP_ERR_NO_MEM: Cannot allocate memory for the event data
+ *  - Others: Fail
+ */
+esp_err_t esp_event_post_batch_to(esp_event_loop_handle_t event_loop,
+                                  const esp_event_batch_item_t *events,
+                                  size_t event_count,
+                                  TickType_t ticks_to_wait);
+
 #if CONFIG_ESP_EVENT_POST_FROM_ISR
 /**
  * @brief Special variant of esp_event_post for posting events from interrupt handlers.
@@ -464,6 +641,10 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop,
  *
  @verbatim
        event loop
+           data pool
+           lane
+           lane
+           ...
            handler
            handler
            ...
@@ -482,6 +663,23 @@ esp_err_t esp_event_isr_post_to(esp_event_loop_handle_t event_loop,
            total_received - number of successfully posted events
            total_dropped - number of events unsuccessfully posted due to queue being full
 
+   data pool (only for loops created with a data pool)
+       format: blocks:block_count size:block_size used:blocks_used max:max_blocks_used heap:heap_copies
+       where:
+           block_count, block_size - the data pool configuration of the loop
+           blocks_used - number of blocks holding the data of queued events
+           max_blocks_used - high-water mark of blocks_used
+           heap_copies - number of events whose data was copied to the heap because it didn't fit a block
+                         or all blocks were used
+
+   lane (only for loops created with more than one priority lane)
+       format: lane depth:events_waiting max:max_events_waiting dr:events_dropped
+       where:
+           lane - the priority lane, starting at 0 for the lowest
+           events_waiting - number of events waiting in the lane
+           max_events_waiting - highest number of events which have been waiting in the lane
+           events_dropped - number of events unsuccessfully posted due to the lane being full
+
    handler
        format: address ev:base,id inv:total_invoked run:total_runtime
        where:
@@ -66,16 +66,86 @@ typedef struct esp_event_loop_node {
 
 typedef SLIST_HEAD(esp_event_loop_nodes, esp_event_loop_node) esp_event_loop_nodes_t;
 
+/// Pool of fixed size blocks for the data of posted events
+typedef struct esp_event_data_pool {
+    uint8_t* blocks;                                                /**< memory of all blocks, NULL if the loop has no pool */
+    size_t block_size;                                              /**< size of a block, a multiple of the alignment of any type */
+    size_t block_count;                                             /**< number of blocks */
+    void* free_list;                                                /**< first unused block, an unused block starts with
+                                                                            the pointer to the next one */
+    uint32_t used;                                                  /**< number of blocks in use */
+    uint32_t max_used;                                              /**< high-water mark of the blocks in use */
+    uint32_t heap_copies;                                           /**< number of event data copies allocated from the heap
+                                                                            because they didn't fit a block or no block was unused */
+    portMUX_TYPE lock;                                              /**< spinlock protecting the free list and the counters */
+} esp_event_data_pool_t;
+
+/// Handlers executed for events with a specific base and id
+typedef struct esp_event_dispatch_entry {
+    esp_event_base_t base;                                          /**< base identifier of the event, NULL for unused entries */
+    int32_t id;                                                     /**< id of the event, ESP_EVENT_ANY_ID for the events of the base
+                                                                            which have no id level handlers */
+    uint32_t first;                                                 /**< index of the first handler in the handler array */
+    uint32_t count;                                                 /**< number of handlers to execute */
+} esp_event_dispatch_entry_t;
+
+/// Snapshot of the registered handlers of a loop, indexed by event base and id
+typedef struct esp_event_dispatch_table {
+    esp_event_dispatch_entry_t* entries;                            /**< open addressing hash table of the entries */
+    size_t mask;                                                    /**< number of entries minus one, the number of entries
+                                                                            is a power of two */
+    esp_event_handler_node_t** handlers;                            /**< handlers of all entries, in the order of execution */
+    uint32_t loop_count;                                            /**< number of loop level handlers at the start of the
+                                                                            handler array, executed for events with unknown base */
+    SLIST_ENTRY(esp_event_dispatch_table) next;                     /**< next retired table */
+} esp_event_dispatch_table_t;
+
+typedef SLIST_HEAD(esp_event_dispatch_tables, esp_event_dispatch_table) esp_event_dispatch_tables_t;
+
+/// Priority lane of an event loop
+typedef struct esp_event_lane {
+    QueueHandle_t queue;                                            /**< event queue of the lane */
+    atomic_uint_least32_t max_depth;                                /**< highest number of events waiting in the queue */
+    atomic_uint_least32_t dropped;                                  /**< number of events dropped due to the queue being full */
+} esp_event_lane_t;
+
+/// Priority lane of the events of an event base
+typedef struct esp_event_base_lane {
+    esp_event_base_t base;                                          /**< the event base */
+    uint32_t lane;                                                  /**< the lane of the events of the base */
+} esp_event_base_lane_t;
+
 /// Event loop
 typedef struct esp_event_loop_instance {
     const char* name;                                               /**< name of this event loop */
-    QueueHandle_t queue;                                            /**< event queue */
+    esp_event_lane_t* lanes;                                        /**< priority lanes, each with its own event queue,
+                                                                            in increasing order of priority */
+    uint32_t lane_count;                                            /**< number of priority lanes */
+    QueueSetHandle_t queue_set;                                     /**< set of the queues of the lanes, NULL if the loop
+                                                                            has a single lane */
+    esp_event_base_lane_t* base_lanes;                              /**< lanes of the event bases, events of other bases
+                                                                            are posted to lane 0 */
+    size_t base_lane_count;                                         /**< number of entries of base_lanes */
+    portMUX_TYPE base_lanes_lock;                                   /**< protects base_lanes, which is read by posts */
     TaskHandle_t task;                                              /**< task that consumes the event queue */
     TaskHandle_t running_task;                                      /**< for loops with no dedicated task, the
                                                                             task that consumes the queue */
     SemaphoreHandle_t mutex;                                        /**< mutex for updating the events linked list */
+    SemaphoreHandle_t dispatch_mutex;                               /**< held while the events are dispatched, so that the
+                                                                            tasks running the loop execute the handlers one
+                                                                            at a time and unregistering can wait for them */
     esp_event_loop_nodes_t loop_nodes;                              /**< set of linked lists containing the
                                                                             registered handlers for the loop */
+    _Atomic(esp_event_dispatch_table_t*) dispatch_table;            /**< index of the registered handlers used for dispatch,
+                                                                            rebuilt under the mutex whenever the handlers change.
+                                                                            NULL if the index couldn't be allocated, in that case
+                                                                            the lists are walked under the mutex */
+    atomic_uint_least32_t dispatch_readers;                         /**< number of dispatches in progress */
+    atomic_bool dispatch_retired;                                   /**< set when there are retired tables or handlers */
+    esp_event_dispatch_tables_t retired_tables;                     /**< replaced tables, which may still be used by a dispatch */
+    esp_event_handler_nodes_t retired_handlers;                     /**< removed handlers, which may still be used by a dispatch */
+    bool lists_in_use;                                              /**< set while the handler lists are walked by a dispatch */
+    esp_event_data_pool_t data_pool;                                /**< blocks for the copies of the posted event data */
 #ifdef CONFIG_ESP_EVENT_LOOP_PROFILING
     atomic_uint_least32_t events_received;                          /**< number of events successfully posted to the loop */
     atomic_uint_least32_t events_dropped;                           /**< number of events dropped due to queue being full */
@@ -1297,6 +1297,44 @@ TEST_CASE("can post while handler is executing - dedicated task", "[event][linux
     vSemaphoreDelete(ev2_sem);
 }
 
+typedef struct {
+    SemaphoreHandle_t started;
+    volatile bool returned;
+} slow_handler_data_t;
+
+static void test_handler_slow(void* handler_arg, esp_event_base_t base, int32_t id, void* event_arg)
+{
+    slow_handler_data_t* data = (slow_handler_data_t*) handler_arg;
+    xSemaphoreGive(data->started);
+    vTaskDelay(pdMS_TO_TICKS(50));
+    data->returned = true;
+}
+
+TEST_CASE("unregistering waits for the handler executed by the loop task", "[event][linux]")
+{
+    EV_LoopFix loop_fix(CONFIG_ESP_SYSTEM_EVENT_QUEUE_SIZE, "loop_task");
+
+    slow_handler_data_t data = { .started = xSemaphoreCreateBinary(), .returned = false };
+    TEST_ASSERT(data.started);
+
+    esp_event_handler_instance_t instance;
+    TEST_ESP_OK(esp_event_handler_instance_register_with(loop_fix.loop,
+                                                         s_test_base1,
+                                                         TEST_EVENT_BASE1_EV1,
+                                                         test_handler_slow,
+                                                         &data,
+                                                         &instance));
+
+    TEST_ESP_OK(esp_event_post_to(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, NULL, 0, portMAX_DELAY));
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(data.started, portMAX_DELAY));
+
+    // The handler is running, unregistering returns only after it did, so that its argument can be freed
+    TEST_ESP_OK(esp_event_handler_instance_unregister_with(loop_fix.loop, s_test_base1, TEST_EVENT_BASE1_EV1, instance));
+    TEST_ASSERT_TRUE(data.returned);
+
+    vSemaphoreDelete(data.started);
+}
+
 static void test_post_from_handler_loop_task(void* args)
 {
     esp_event_loop_handle_t event_loop = (esp_event_loop_handle_t) args;
@@ -0,0 +1,242 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/param.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_event.h"
+#include "esp_timer.h"
+#include "esp_http_server.h"
+#include "unity.h"
+
+#define TEST_PORT           8080
+#define TEST_CONNECTIONS    256
+#define TEST_ROUNDS         20
+#define TEST_TIMEOUT_MS     5000
+
+static const char TEST_REQUEST[] = "GET /hello HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+typedef struct {
+    int fd;
+    size_t len;
+    bool done;
+    char data[256];
+} client_t;
+
+static esp_err_t hello_get_handler(httpd_req_t *req)
+{
+    return httpd_resp_sendstr(req, "ok");
+}
+
+/* Headers and body of the responses are sent separately, do not let
+ * Nagle's algorithm delay the body until the headers are acknowledged */
+static esp_err_t set_nodelay(httpd_handle_t hd, int sockfd)
+{
+    int enable = 1;
+    return setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)) == 0 ? ESP_OK : ESP_FAIL;
+}
+
+static httpd_handle_t start_server(uint16_t max_open_sockets)
+{
+    esp_err_t err = esp_event_loop_create_default();
+    TEST_ASSERT(err == ESP_OK || err == ESP_ERR_INVALID_STATE);
+
+    httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+    config.server_port = TEST_PORT;
+    config.max_open_sockets = max_open_sockets;
+    config.backlog_conn = max_open_sockets;
+    config.open_fn = set_nodelay;
+
+    httpd_handle_t server = NULL;
+    TEST_ASSERT_EQUAL(ESP_OK, httpd_start(&server, &config));
+    httpd_uri_t hello = {
+        .uri      = "/hello",
+        .method   = HTTP_GET,
+        .handler  = hello_get_handler,
+        .user_ctx = NULL,
+    };
+    TEST_ASSERT_EQUAL(ESP_OK, httpd_register_uri_handler(server, &hello));
+    return server;
+}
+
+static void connect_clients(client_t *clients, int count)
+{
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons(TEST_PORT),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    for (int i = 0; i < count; i++) {
+        clients[i].fd = socket(AF_INET, SOCK_STREAM, 0);
+        TEST_ASSERT_GREATER_OR_EQUAL(0, clients[i].fd);
+        TEST_ASSERT_EQUAL(0, connect(clients[i].fd, (struct sockaddr *)&addr, sizeof(addr)));
+        // Waiting is done with select(), which lets the server task run
+        TEST_ASSERT_EQUAL(0, fcntl(clients[i].fd, F_SETFL, O_NONBLOCK));
+    }
+}
+
+static void close_clients(client_t *clients, int count)
+{
+    for (int i = 0; i < count; i++) {
+        close(clients[i].fd);
+    }
+}
+
+static void send_requests(client_t *clients, int count)
+{
+    for (int i = 0; i < count; i++) {
+        clients[i].len = 0;
+        clients[i].done = false;
+        TEST_ASSERT_EQUAL(sizeof(TEST_REQUEST) - 1, send(clients[i].fd, TEST_REQUEST, sizeof(TEST_REQUEST) - 1, 0));
+    }
+}
+
+/* Returns the number of clients which received a complete response */
+static int wait_responses(client_t *clients, int count, uint32_t timeout_ms)
+{
+    int responses = 0;
+    int waiting = count;
+    int64_t end = esp_timer_get_time() + timeout_ms * 1000LL;
+
+    while (waiting > 0 && esp_timer_get_time() < end) {
+        fd_set read_set;
+        FD_ZERO(&read_set);
+        int max_fd = -1;
+        for (int i = 0; i < count; i++) {
+            if (!clients[i].done) {
+                FD_SET(clients[i].fd, &read_set);
+                max_fd = MAX(max_fd, clients[i].fd);
+            }
+        }
+        struct timeval tv = { .tv_usec = 10000 };
+        if (select(max_fd + 1, &read_set, NULL, NULL, &tv) <= 0) {
+            continue;
+        }
+        for (int i = 0; i < count; i++) {
+            client_t *client = &clients[i];
+            if (client->done || !FD_ISSET(client->fd, &read_set)) {
+                continue;
+            }
+            int ret = recv(client->fd, client->data + client->len, sizeof(client->data) - 1 - client->len, 0);
+            if (ret <= 0) {
+                client->done = true;
+                waiting--;
+                continue;
+            }
+            client->len += ret;
+            client->data[client->len] = '\0';
+            if (strstr(client->data, "\r\n\r\nok") != NULL) {
+                client->done = true;
+                waiting--;
+                responses++;
+            }
+        }
+    }
+    return responses;
+}
+
+static int get_client_count(httpd_handle_t server)
+{
+    int client_fds[TEST_CONNECTIONS];
+    size_t fds = TEST_CONNECTIONS;
+    TEST_ASSERT_EQUAL(ESP_OK, httpd_get_client_list(server, &fds, client_fds));
+    return fds;
+}
+
+TEST_CASE("server handles requests of hundreds of keep-alive connections", "[HTTP SERVER]")
+{
+    client_t *clients = calloc(TEST_CONNECTIONS, sizeof(client_t));
+    TEST_ASSERT_NOT_NULL(clients);
+    httpd_handle_t server = start_server(TEST_CONNECTIONS);
+    connect_clients(clients, TEST_CONNECTIONS);
+
+    // The first round also waits for all the connections to be accepted
+    send_requests(clients, TEST_CONNECTIONS);
+    TEST_ASSERT_EQUAL(TEST_CONNECTIONS, wait_responses(clients, TEST_CONNECTIONS, TEST_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL(TEST_CONNECTIONS, get_client_count(server));
+
+    int64_t start = esp_timer_get_time();
+    for (int round = 0; round < TEST_ROUNDS; round++) {
+        send_requests(clients, TEST_CONNECTIONS);
+        TEST_ASSERT_EQUAL(TEST_CONNECTIONS, wait_responses(clients, TEST_CONNECTIONS, TEST_TIMEOUT_MS));
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start;
+    printf("%d requests on %d keep-alive connections in %" PRIi64 " ms, %" PRIi64 " requests/s\n",
+           TEST_ROUNDS * TEST_CONNECTIONS, TEST_CONNECTIONS, elapsed_us / 1000,
+           TEST_ROUNDS * TEST_CONNECTIONS * 1000000LL / MAX(elapsed_us, 1));
+
+    // Requests on a single connection, the other ones being idle
+    start = esp_timer_get_time();
+    for (int round = 0; round < TEST_ROUNDS * 10; round++) {
+        send_requests(clients, 1);
+        TEST_ASSERT_EQUAL(1, wait_responses(clients, 1, TEST_TIMEOUT_MS));
+    }
+    elapsed_us = esp_timer_get_time() - start;
+    printf("%d requests on 1 of %d keep-alive connections in %" PRIi64 " ms, %" PRIi64 " us per request\n",
+           TEST_ROUNDS * 10, TEST_CONNECTIONS, elapsed_us / 1000, elapsed_us / (TEST_ROUNDS * 10));
+
+    close_clients(clients, TEST_CONNECTIONS);
+    TEST_ASSERT_EQUAL(ESP_OK, httpd_stop(server));
+    free(clients);
+}
+
+TEST_CASE("server stops watching closed connections", "[HTTP SERVER]")
+{
+    client_t clients[16];
+    httpd_handle_t server = start_server(16);
+    connect_clients(clients, 16);
+    send_requests(clients, 16);
+    TEST_ASSERT_EQUAL(16, wait_responses(clients, 16, TEST_TIMEOUT_MS));
+
+    close_clients(clients, 8);
+    int64_t end = esp_timer_get_time() + TEST_TIMEOUT_MS * 1000LL;
+    while (get_client_count(server) != 8 && esp_timer_get_time() < end) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    TEST_ASSERT_EQUAL(8, get_client_count(server));
+
+    send_requests(&clients[8], 8);
+    TEST_ASSERT_EQUAL(8, wait_responses(&clients[8], 8, TEST_TIMEOUT_MS));
+
+    close_clients(&clients[8], 8);
+    TEST_ASSERT_EQUAL(ESP_OK, httpd_stop(server));
+}
+
+TEST_CASE("server accepts connections again when a session is closed", "[HTTP SERVER]")
+{
+    client_t clients[5];
+    httpd_handle_t server = start_server(4);
+    connect_clients(clients, 5);
+    send_requests(clients, 4);
+    TEST_ASSERT_EQUAL(4, wait_responses(clients, 4, TEST_TIMEOUT_MS));
+
+    // All the sessions are open, the last connection is not accepted
+    send_requests(&clients[4], 1);
+    TEST_ASSERT_EQUAL(0, wait_responses(&clients[4], 1, 200));
+    TEST_ASSERT_EQUAL(4, get_client_count(server));
+
+    close_clients(clients, 1);
+    TEST_ASSERT_EQUAL(1, wait_responses(&clients[4], 1, TEST_TIMEOUT_MS));
+
+    close_clients(&clients[1], 4);
+    TEST_ASSERT_EQUAL(ESP_OK, httpd_stop(server));
+}
+
+void app_main(void)
+{
+    unity_run_menu();
+}
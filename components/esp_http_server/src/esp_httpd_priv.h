@@ -69,6 +69,8 @@ struct sock_db {
     char pending_data[PARSER_BLOCK_SIZE];   /*!< Buffer for pending data to be received */
     size_t pending_len;                     /*!< Length of pending data to be received */
     bool for_async_req;                     /*!< If true, the socket will not be LRU purged */
+    bool poll_async;                        /*!< True if the socket is out of the readiness backend while used by an async request */
+    bool poll_pending;                      /*!< True if the socket has pending data, which the readiness backend does not report */
 #ifdef CONFIG_HTTPD_WS_SUPPORT
     bool ws_handshake_done;                 /*!< True if it has done WebSocket handshake (if this socket is a valid WS) */
     bool ws_close;                          /*!< Set to true to close the socket later (when WS Close frame received) */
@@ -123,6 +125,11 @@ struct httpd_data {
     struct thread_data hd_td;               /*!< Information for the HTTPD thread */
     struct sock_db *hd_sd;                  /*!< The socket database */
     int hd_sd_active_count;                 /*!< The number of the active sockets */
+    int hd_sd_async_count;                  /*!< The number of sockets with poll_async set */
+    int hd_sd_pending_count;                /*!< The number of sockets with poll_pending set */
+    struct httpd_poll *hd_poll;             /*!< Readiness backend of the server loop */
+    void **hd_poll_ready;                   /*!< Contexts of the FDs reported ready by the readiness backend */
+    bool listen_polled;                     /*!< True if the listener FD is in the readiness backend */
     httpd_uri_t **hd_calls;                 /*!< Registered URI handlers */
     struct httpd_req hd_req;                /*!< The current HTTPD request */
     struct httpd_req_aux hd_req_aux;        /*!< Additional data about the HTTPD request kept unexposed */
@@ -238,15 +245,18 @@ void httpd_sess_delete(struct httpd_data *hd, struct sock_db *session);
 void httpd_sess_free_ctx(void **ctx, httpd_free_ctx_fn_t free_fn);
 
 /**
- * @brief   Add descriptors present in the socket database to an fdset and
- *          update the value of maxfd which are needed by the select function
- *          for looking through all available sockets for incoming data.
+ * @brief   Updates the state of a session in the readiness backend after
+ *          it has been processed by the server loop.
  *
- * @param[in]  hd    Server instance data
- * @param[out] fdset File descriptor set to be updated.
- * @param[out] maxfd Maximum value among all file descriptors.
+ * The socket is removed from the backend while the session is used by an
+ * async request, and added back once the request has completed. Sessions
+ * with pending data are flagged to be processed without waiting for the
+ * backend, see httpd_sess_pending().
+ *
+ * @param[in] hd      Server instance data
+ * @param[in] session Session
  */
-void httpd_sess_set_descriptors(struct httpd_data *hd, fd_set *fdset, int *maxfd);
+void httpd_sess_update_poll(struct httpd_data *hd, struct sock_db *session);
 
 /**
  * @brief   Checks if session can accept another connection from new client.
@@ -306,6 +316,75 @@ void httpd_sess_close_all(struct httpd_data *hd);
  * @}
  */
 
+/****************** Group : Readiness Backend ********************/
+/** @name Readiness Backend
+ * Functions keeping the set of descriptors watched by the server loop
+ * and waiting for some of them to be ready. The descriptors are added
+ * and removed as sessions are opened and closed, so that waiting does
+ * not depend on the number of open sessions. The backend is either
+ * select() or, on the Linux target, epoll.
+ * @{
+ */
+
+/**
+ * @brief   Creates the readiness backend of a server instance
+ *
+ * @param[in] hd       Server instance data
+ * @param[in] max_fds  Maximum number of descriptors in the backend at the same time
+ *
+ * @return
+ *  - ESP_OK   : on success
+ *  - ESP_ERR_HTTPD_ALLOC_MEM : if the backend could not be created
+ */
+esp_err_t httpd_poll_init(struct httpd_data *hd, int max_fds);
+
+/**
+ * @brief   Deletes the readiness backend of a server instance
+ *
+ * @param[in] hd  Server instance data
+ */
+void httpd_poll_deinit(struct httpd_data *hd);
+
+/**
+ * @brief   Adds a descriptor to the readiness backend
+ *
+ * @param[in] hd   Server instance data
+ * @param[in] fd   Descriptor to watch for incoming data
+ * @param[in] ctx  Context reported by httpd_poll_wait() when the descriptor is ready, must not be NULL
+ *
+ * @return
+ *  - ESP_OK   : on success
+ *  - ESP_FAIL : if the descriptor could not be added
+ */
+esp_err_t httpd_poll_add(struct httpd_data *hd, int fd, void *ctx);
+
+/**
+ * @brief   Removes a descriptor from the readiness backend
+ *
+ * @note    Must be called before the descriptor is closed.
+ *
+ * @param[in] hd  Server instance data
+ * @param[in] fd  Descriptor previously added with httpd_poll_add()
+ */
+void httpd_poll_remove(struct httpd_data *hd, int fd);
+
+/**
+ * @brief   Waits for descriptors of the readiness backend to be ready
+ *
+ * @param[in]  hd     Server instance data
+ * @param[out] ready  Contexts of the ready descriptors, with room for max_fds entries
+ * @param[in]  block  Wait until a descriptor is ready if true, only poll otherwise
+ *
+ * @return
+ *  - Number of ready descriptors (may be 0)
+ *  - -1 on error, with errno set
+ */
+int httpd_poll_wait(struct httpd_data *hd, void **ready, bool block);
+
+/** End of Group : Readiness Backend
+ * @}
+ */
+
 /****************** Group : URI Handling ********************/
 /** @name URI Handling
  * Methods for accessing URI handlers
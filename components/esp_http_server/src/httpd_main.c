@@ -31,11 +31,6 @@ static const int DEFAULT_KEEP_ALIVE_IDLE = 5;
 static const int DEFAULT_KEEP_ALIVE_INTERVAL= 5;
 static const int DEFAULT_KEEP_ALIVE_COUNT= 3;
 
-typedef struct {
-    fd_set *fdset;
-    struct httpd_data *hd;
-} process_session_context_t;
-
 static const char *TAG = "httpd";
 
 ESP_EVENT_DEFINE_BASE(ESP_HTTP_SERVER_EVENT);
@@ -244,30 +239,41 @@ static void httpd_process_ctrl_msg(struct httpd_data *hd)
 #endif
 }
 
-// Called for each session from httpd_server
-static int httpd_process_session(struct sock_db *session, void *context)
+// Called for each session which is ready or has pending data
+static void httpd_process_session(struct httpd_data *hd, struct sock_db *session)
 {
-    if ((!session) || (!context)) {
-        return 0;
-    }
-
     if (session->fd < 0) {
-        return 1;
+        return;
     }
 
     // session is busy in an async task, do not process here.
     if (session->for_async_req) {
-        return 1;
+        return;
+    }
+
+    ESP_LOGD(TAG, LOG_FMT("processing socket %d"), session->fd);
+    if (httpd_sess_process(hd, session) != ESP_OK) {
+        httpd_sess_delete(hd, session); // Delete session
+        return;
     }
+    httpd_sess_update_poll(hd, session);
+}
 
-    process_session_context_t *ctx = (process_session_context_t *)context;
-    int fd = session->fd;
+// Called for each session from httpd_server, when some sessions are not watched
+// by the readiness backend or have pending data
+static int httpd_process_deferred_session(struct sock_db *session, void *context)
+{
+    struct httpd_data *hd = (struct httpd_data *)context;
+    if (session->fd < 0) {
+        return 1;
+    }
 
-    if (FD_ISSET(fd, ctx->fdset) || httpd_sess_pending(ctx->hd, session)) {
-        ESP_LOGD(TAG, LOG_FMT("processing socket %d"), fd);
-        if (httpd_sess_process(ctx->hd, session) != ESP_OK) {
-            httpd_sess_delete(ctx->hd, session); // Delete session
-        }
+    // watch the socket again if its async request has completed
+    if (session->poll_async) {
+        httpd_sess_update_poll(hd, session);
+    }
+    if (session->poll_pending) {
+        httpd_process_session(hd, session);
     }
     return 1;
 }
@@ -275,32 +281,38 @@ static int httpd_process_session(struct sock_db *session, void *context)
 /* Manage in-coming connection or data requests */
 static esp_err_t httpd_server(struct httpd_data *hd)
 {
-    fd_set read_set;
-    FD_ZERO(&read_set);
-    if (hd->config.lru_purge_enable || httpd_is_sess_available(hd)) {
-        /* Only listen for new connections if server has capacity to
-         * handle more (or when LRU purge is enabled, in which case
-         * older connections will be closed) */
-        FD_SET(hd->listen_fd, &read_set);
-    }
-    FD_SET(hd->ctrl_fd, &read_set);
-
-    int tmp_max_fd;
-    httpd_sess_set_descriptors(hd, &read_set, &tmp_max_fd);
-    int maxfd = MAX(hd->listen_fd, tmp_max_fd);
-    tmp_max_fd = maxfd;
-    maxfd = MAX(hd->ctrl_fd, tmp_max_fd);
-
-    ESP_LOGD(TAG, LOG_FMT("doing select maxfd+1 = %d"), maxfd + 1);
-    int active_cnt = select(maxfd + 1, &read_set, NULL, NULL, NULL);
-    if (active_cnt < 0) {
-        ESP_LOGE(TAG, LOG_FMT("error in select (%d)"), errno);
+    /* Only listen for new connections if server has capacity to
+     * handle more (or when LRU purge is enabled, in which case
+     * older connections will be closed) */
+    bool can_accept = hd->config.lru_purge_enable ||
+                      hd->hd_sd_active_count < hd->config.max_open_sockets;
+    if (can_accept && !hd->listen_polled) {
+        hd->listen_polled = (httpd_poll_add(hd, hd->listen_fd, &hd->listen_fd) == ESP_OK);
+    } else if (!can_accept && hd->listen_polled) {
+        httpd_poll_remove(hd, hd->listen_fd);
+        hd->listen_polled = false;
+    }
+
+    /* Sessions with pending data must be processed without waiting */
+    int ready_cnt = httpd_poll_wait(hd, hd->hd_poll_ready, hd->hd_sd_pending_count == 0);
+    if (ready_cnt < 0) {
+        ESP_LOGE(TAG, LOG_FMT("error waiting for sockets (%d)"), errno);
         httpd_sess_delete_invalid(hd);
         return ESP_OK;
     }
 
+    bool ctrl_ready = false;
+    bool listen_ready = false;
+    for (int i = 0; i < ready_cnt; i++) {
+        if (hd->hd_poll_ready[i] == &hd->ctrl_fd) {
+            ctrl_ready = true;
+        } else if (hd->hd_poll_ready[i] == &hd->listen_fd) {
+            listen_ready = true;
+        }
+    }
+
     /* Case0: Do we have a control message? */
-    if (FD_ISSET(hd->ctrl_fd, &read_set)) {
+    if (ctrl_ready) {
         ESP_LOGD(TAG, LOG_FMT("processing ctrl message"));
         httpd_process_ctrl_msg(hd);
         if (hd->hd_td.status == THREAD_STOPPING) {
@@ -311,15 +323,18 @@ static esp_err_t httpd_server(struct httpd_data *hd)
 
     /* Case1: Do we have any activity on the current data
      * sessions? */
-    process_session_context_t context = {
-        .fdset = &read_set,
-        .hd = hd
-    };
-    httpd_sess_enum(hd, httpd_process_session, &context);
+    for (int i = 0; i < ready_cnt; i++) {
+        if (hd->hd_poll_ready[i] != &hd->ctrl_fd && hd->hd_poll_ready[i] != &hd->listen_fd) {
+            httpd_process_session(hd, (struct sock_db *)hd->hd_poll_ready[i]);
+        }
+    }
+    if (hd->hd_sd_pending_count || hd->hd_sd_async_count) {
+        httpd_sess_enum(hd, httpd_process_deferred_session, hd);
+    }
 
     /* Case2: Do we have any incoming connection requests to
      * process? */
-    if (FD_ISSET(hd->listen_fd, &read_set)) {
+    if (listen_ready) {
         ESP_LOGD(TAG, LOG_FMT("processing listen socket %d"), hd->listen_fd);
         if (httpd_accept_conn(hd, hd->listen_fd) != ESP_OK) {
             ESP_LOGW(TAG, LOG_FMT("error accepting new connection"));
@@ -420,6 +435,14 @@ static esp_err_t httpd_server_init(struct httpd_data *hd)
     hd->listen_fd = fd;
     hd->ctrl_fd = ctrl_fd;
     hd->msg_fd  = msg_fd;
+
+    /* The listener FD is added by the server loop, depending on the number of open sessions */
+    if (httpd_poll_add(hd, hd->ctrl_fd, &hd->ctrl_fd) != ESP_OK) {
+        close(fd);
+        close(ctrl_fd);
+        close(msg_fd);
+        return ESP_FAIL;
+    }
     return ESP_OK;
 }
 
@@ -462,6 +485,18 @@ static struct httpd_data *httpd_create(const httpd_config_t *config)
         free(hd);
         return NULL;
     }
+    /* The readiness backend watches the sessions, the listener and the ctrl FDs */
+    hd->hd_poll_ready = calloc(config->max_open_sockets + 2, sizeof(void *));
+    if (!hd->hd_poll_ready || httpd_poll_init(hd, config->max_open_sockets + 2) != ESP_OK) {
+        ESP_LOGE(TAG, LOG_FMT("Failed to create the readiness backend"));
+        free(hd->hd_poll_ready);
+        free(hd->err_handler_fns);
+        free(ra->resp_hdrs);
+        free(hd->hd_sd);
+        free(hd->hd_calls);
+        free(hd);
+        return NULL;
+    }
     /* Save the configuration for this instance */
     hd->config = *config;
     return hd;
@@ -471,6 +506,8 @@ static void httpd_delete(struct httpd_data *hd)
 {
     struct httpd_req_aux *ra = &hd->hd_req_aux;
     /* Free memory of httpd instance data */
+    httpd_poll_deinit(hd);
+    free(hd->hd_poll_ready);
     free(hd->err_handler_fns);
     free(ra->resp_hdrs);
     free(hd->hd_sd);
@@ -495,14 +532,18 @@ esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config)
      *     1) listening for new TCP connections
      *     2) for sending control messages over UDP
      *     3) for receiving control messages over UDP
-     * So the total number of required sockets is max_open_sockets + 3
+     * So the total number of required sockets is max_open_sockets + 3.
+     * With the epoll backend, sockets of the host are used, which are only
+     * limited by the number of files the process can open.
      */
+#if !CONFIG_HTTPD_POLL_EPOLL
     if (HTTPD_MAX_SOCKETS < config->max_open_sockets + 3) {
         ESP_LOGE(TAG, "Config option max_open_sockets is too large (max allowed %d, 3 sockets used by HTTP server internally)\n\t"
                  "Either decrease this or configure LWIP_MAX_SOCKETS to a larger value",
                  HTTPD_MAX_SOCKETS - 3);
         return ESP_ERR_INVALID_ARG;
     }
+#endif
 
     struct httpd_data *hd = httpd_create(config);
     if (hd == NULL) {
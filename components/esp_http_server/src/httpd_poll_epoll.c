@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <esp_log.h>
+#include <esp_err.h>
+
+#include <esp_http_server.h>
+#include "esp_httpd_priv.h"
+
+static const char *TAG = "httpd_poll";
+
+/* The interest set is kept by the kernel, epoll_wait() only returns the
+ * ready descriptors, whatever the number of descriptors watched. */
+struct httpd_poll {
+    int epoll_fd;
+    int max_events;
+    struct epoll_event events[];
+};
+
+esp_err_t httpd_poll_init(struct httpd_data *hd, int max_fds)
+{
+    struct httpd_poll *poll = calloc(1, sizeof(struct httpd_poll) + max_fds * sizeof(struct epoll_event));
+    if (!poll) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    poll->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (poll->epoll_fd < 0) {
+        ESP_LOGE(TAG, LOG_FMT("error in epoll_create1 (%d)"), errno);
+        free(poll);
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    poll->max_events = max_fds;
+    hd->hd_poll = poll;
+    return ESP_OK;
+}
+
+void httpd_poll_deinit(struct httpd_data *hd)
+{
+    if (hd->hd_poll) {
+        close(hd->hd_poll->epoll_fd);
+        free(hd->hd_poll);
+        hd->hd_poll = NULL;
+    }
+}
+
+esp_err_t httpd_poll_add(struct httpd_data *hd, int fd, void *ctx)
+{
+    struct epoll_event event = {
+        .events = EPOLLIN,
+        .data.ptr = ctx,
+    };
+    if (epoll_ctl(hd->hd_poll->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        ESP_LOGE(TAG, LOG_FMT("error adding fd %d (%d)"), fd, errno);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+void httpd_poll_remove(struct httpd_data *hd, int fd)
+{
+    /* Fails if the descriptor was already closed, which removed it */
+    if (epoll_ctl(hd->hd_poll->epoll_fd, EPOLL_CTL_DEL, fd, NULL) < 0) {
+        ESP_LOGD(TAG, LOG_FMT("error removing fd %d (%d)"), fd, errno);
+    }
+}
+
+int httpd_poll_wait(struct httpd_data *hd, void **ready, bool block)
+{
+    struct httpd_poll *poll = hd->hd_poll;
+    int count = epoll_wait(poll->epoll_fd, poll->events, poll->max_events, block ? -1 : 0);
+    if (count < 0) {
+        /* Interrupted by a signal of the host, nothing to recover */
+        return (errno == EINTR) ? 0 : -1;
+    }
+    for (int i = 0; i < count; i++) {
+        ready[i] = poll->events[i].data.ptr;
+    }
+    return count;
+}
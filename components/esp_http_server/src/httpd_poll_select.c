@@ -0,0 +1,107 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <sys/select.h>
+#include <sys/param.h>
+#include <errno.h>
+#include <esp_log.h>
+#include <esp_err.h>
+
+#include <esp_http_server.h>
+#include "esp_httpd_priv.h"
+
+static const char *TAG = "httpd_poll";
+
+/* The set of descriptors is kept between the calls to select(), only the
+ * entries of the descriptors are scanned to find the ready ones. */
+struct httpd_poll {
+    fd_set fds;         /*!< Descriptors of the entries */
+    int max_fd;         /*!< Largest descriptor of the entries, -1 if there is none */
+    int max_entries;    /*!< Number of entries */
+    struct {
+        int fd;         /*!< Descriptor, -1 if the entry is free */
+        void *ctx;
+    } entries[];
+};
+
+esp_err_t httpd_poll_init(struct httpd_data *hd, int max_fds)
+{
+    struct httpd_poll *poll = calloc(1, sizeof(struct httpd_poll) + max_fds * sizeof(poll->entries[0]));
+    if (!poll) {
+        return ESP_ERR_HTTPD_ALLOC_MEM;
+    }
+    FD_ZERO(&poll->fds);
+    poll->max_fd = -1;
+    poll->max_entries = max_fds;
+    for (int i = 0; i < max_fds; i++) {
+        poll->entries[i].fd = -1;
+    }
+    hd->hd_poll = poll;
+    return ESP_OK;
+}
+
+void httpd_poll_deinit(struct httpd_data *hd)
+{
+    free(hd->hd_poll);
+    hd->hd_poll = NULL;
+}
+
+esp_err_t httpd_poll_add(struct httpd_data *hd, int fd, void *ctx)
+{
+    struct httpd_poll *poll = hd->hd_poll;
+    if (fd < 0 || fd >= FD_SETSIZE) {
+        ESP_LOGE(TAG, LOG_FMT("invalid fd %d"), fd);
+        return ESP_FAIL;
+    }
+    for (int i = 0; i < poll->max_entries; i++) {
+        if (poll->entries[i].fd == -1) {
+            poll->entries[i].fd = fd;
+            poll->entries[i].ctx = ctx;
+            FD_SET(fd, &poll->fds);
+            poll->max_fd = MAX(poll->max_fd, fd);
+            return ESP_OK;
+        }
+    }
+    ESP_LOGE(TAG, LOG_FMT("no free entry for fd %d"), fd);
+    return ESP_FAIL;
+}
+
+void httpd_poll_remove(struct httpd_data *hd, int fd)
+{
+    struct httpd_poll *poll = hd->hd_poll;
+    int max_fd = -1;
+    for (int i = 0; i < poll->max_entries; i++) {
+        if (poll->entries[i].fd == fd) {
+            poll->entries[i].fd = -1;
+            FD_CLR(fd, &poll->fds);
+        } else {
+            max_fd = MAX(max_fd, poll->entries[i].fd);
+        }
+    }
+    poll->max_fd = max_fd;
+}
+
+int httpd_poll_wait(struct httpd_data *hd, void **ready, bool block)
+{
+    struct httpd_poll *poll = hd->hd_poll;
+    fd_set read_set = poll->fds;
+    struct timeval no_wait = { 0 };
+
+    ESP_LOGD(TAG, LOG_FMT("doing select maxfd+1 = %d"), poll->max_fd + 1);
+    int active_cnt = select(poll->max_fd + 1, &read_set, NULL, NULL, block ? NULL : &no_wait);
+    if (active_cnt <= 0) {
+        return active_cnt;
+    }
+
+    int count = 0;
+    for (int i = 0; i < poll->max_entries && count < active_cnt; i++) {
+        if (poll->entries[i].fd != -1 && FD_ISSET(poll->entries[i].fd, &read_set)) {
+            ready[count++] = poll->entries[i].ctx;
+        }
+    }
+    return count;
+}
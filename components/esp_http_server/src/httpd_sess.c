@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2018-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2018-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -21,7 +21,6 @@ typedef enum {
     HTTPD_TASK_GET_ACTIVE,      // Get active session (fd!=-1)
     HTTPD_TASK_GET_FREE,        // Get free session slot (fd<0)
     HTTPD_TASK_FIND_FD,         // Find session with specific fd
-    HTTPD_TASK_SET_DESCRIPTOR,  // Set descriptor
     HTTPD_TASK_DELETE_INVALID,  // Delete invalid session
     HTTPD_TASK_FIND_LOWEST_LRU, // Find session with lowest lru
     HTTPD_TASK_CLOSE            // Close session
@@ -30,8 +29,6 @@ typedef enum {
 typedef struct {
     task_t task;
     int fd;
-    fd_set *fdset;
-    int max_fd;
     struct httpd_data *hd;
     uint64_t lru_counter;
     struct sock_db    *session;
@@ -86,15 +83,6 @@ static int enum_function(struct sock_db *session, void *context)
     case HTTPD_TASK_FIND_FD:
         found = (session->fd == ctx->fd);
         break;
-    // Set descriptor
-    case HTTPD_TASK_SET_DESCRIPTOR:
-        if (session->fd != -1 && !session->for_async_req) {
-            FD_SET(session->fd, ctx->fdset);
-            if (session->fd > ctx->max_fd) {
-                ctx->max_fd = session->fd;
-            }
-        }
-        break;
     // Delete invalid session
     case HTTPD_TASK_DELETE_INVALID:
         if (!fd_is_valid(session->fd)) {
@@ -222,6 +210,11 @@ esp_err_t httpd_sess_new(struct httpd_data *hd, int newfd)
         }
     }
 
+    // Watch the socket in the server loop
+    if (httpd_poll_add(hd, session->fd, session) != ESP_OK) {
+        httpd_sess_delete(hd, session);
+        return ESP_FAIL;
+    }
 
     ESP_LOGD(TAG, LOG_FMT("active sockets: %d"), hd->hd_sd_active_count);
     return ESP_OK;
@@ -330,16 +323,30 @@ void httpd_sess_set_transport_ctx(httpd_handle_t handle, int sockfd, void *ctx,
     session->free_transport_ctx = free_fn;
 }
 
-void httpd_sess_set_descriptors(struct httpd_data *hd, fd_set *fdset, int *maxfd)
+void httpd_sess_update_poll(struct httpd_data *hd, struct sock_db *session)
 {
-    enum_context_t context = {
-        .task = HTTPD_TASK_SET_DESCRIPTOR,
-        .max_fd = -1,
-        .fdset = fdset
-    };
-    httpd_sess_enum(hd, enum_function, &context);
-    if (maxfd) {
-        *maxfd = context.max_fd;
+    if ((!hd) || (!session) || (session->fd < 0)) {
+        return;
+    }
+
+    if (session->for_async_req && !session->poll_async) {
+        // The socket is read by the async request until it completes
+        httpd_poll_remove(hd, session->fd);
+        session->poll_async = true;
+        hd->hd_sd_async_count++;
+    } else if (!session->for_async_req && session->poll_async) {
+        if (httpd_poll_add(hd, session->fd, session) != ESP_OK) {
+            httpd_sess_delete(hd, session);
+            return;
+        }
+        session->poll_async = false;
+        hd->hd_sd_async_count--;
+    }
+
+    bool pending = !session->poll_async && httpd_sess_pending(hd, session);
+    if (pending != session->poll_pending) {
+        session->poll_pending = pending;
+        hd->hd_sd_pending_count += pending ? 1 : -1;
     }
 }
 
@@ -369,6 +376,18 @@ void httpd_sess_delete(struct httpd_data *hd, struct sock_db *session)
         }
     }
 
+    // Stop watching the socket before it is closed
+    if (session->poll_async) {
+        hd->hd_sd_async_count--;
+    } else {
+        httpd_poll_remove(hd, session->fd);
+    }
+    if (session->poll_pending) {
+        hd->hd_sd_pending_count--;
+    }
+    session->poll_async = false;
+    session->poll_pending = false;
+
     // Call close function if defined
     if (hd->config.close_fn) {
         hd->config.close_fn(hd, session->fd);
@@ -406,7 +425,7 @@ bool httpd_sess_pending(struct httpd_data *hd, struct sock_db *session)
         return false;
     }
     if (session->pending_fn) {
-        // test if there's any data to be read (besides read() function, which is handled by select() in the main httpd loop)
+        // test if there's any data to be read (besides read() function, which is handled by the readiness backend of the main httpd loop)
         // this should check e.g. for the SSL data buffer
         if (session->pending_fn(hd, session->fd) > 0) {
             return true;
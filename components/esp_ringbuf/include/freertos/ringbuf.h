@@ -41,6 +41,15 @@ typedef enum {
      * time.
      */
     RINGBUF_TYPE_BYTEBUF,
+    /**
+     * Single-producer/single-consumer no-split buffers store items the same
+     * way as no-split buffers, but are only ever sent to from one task or ISR
+     * and received from by one task or ISR. Sending, receiving and returning
+     * items then do not take the ring buffer's lock unless the other side is
+     * blocked. The maximum item size is 4 bytes smaller than that of a
+     * no-split buffer of the same size.
+     */
+    RINGBUF_TYPE_NOSPLIT_SPSC,
     RINGBUF_TYPE_MAX,
 } RingbufferType_t;
 
@@ -65,6 +74,17 @@ typedef struct xSTATIC_RINGBUFFER {
     /** @endcond */
 } StaticRingbuffer_t;
 
+/**
+ * @brief Fragment of an item sent by xRingbufferSendv()
+ *
+ * The layout of this struct is the same as the layout of struct iovec, so an array of struct iovec can be cast
+ * and passed to xRingbufferSendv().
+ */
+typedef struct {
+    const void *pvData;     /**< Pointer to the data of the fragment. NULL is allowed if xSize is 0. */
+    size_t xSize;           /**< Size of the fragment in bytes */
+} RingbufferFragment_t;
+
 /**
  * @brief       Create a ring buffer
  *
@@ -139,6 +159,32 @@ BaseType_t xRingbufferSend(RingbufHandle_t xRingbuffer,
                            size_t xItemSize,
                            TickType_t xTicksToWait);
 
+/**
+ * @brief       Insert an item made of several fragments into the ring buffer
+ *
+ * Attempt to insert an item into the ring buffer, where the data of the item
+ * is gathered from multiple fragments (e.g., a header and a payload). The
+ * fragments are copied directly into the ring buffer, in order, as a single
+ * item. This function will block until enough free space is available for the
+ * whole item or until it times out.
+ *
+ * @param[in]   xRingbuffer     Ring buffer to insert the item into
+ * @param[in]   pxFragments     Array of fragments forming the item. NULL is allowed if uxFragmentCount is 0.
+ * @param[in]   uxFragmentCount Number of fragments in pxFragments
+ * @param[in]   xTicksToWait    Ticks to wait for room in the ring buffer.
+ *
+ * @note    The size of the item is the sum of the sizes of the fragments. It is
+ *          subject to the same rules as the size of an item sent by xRingbufferSend().
+ *
+ * @return
+ *      - pdTRUE if succeeded
+ *      - pdFALSE on time-out or when the data is larger than the maximum permissible size of the buffer
+ */
+BaseType_t xRingbufferSendv(RingbufHandle_t xRingbuffer,
+                            const RingbufferFragment_t *pxFragments,
+                            UBaseType_t uxFragmentCount,
+                            TickType_t xTicksToWait);
+
 /**
  * @brief       Insert an item into the ring buffer in an ISR
  *
@@ -364,6 +410,36 @@ void *xRingbufferReceiveUpTo(RingbufHandle_t xRingbuffer,
  */
 void *xRingbufferReceiveUpToFromISR(RingbufHandle_t xRingbuffer, size_t *pxItemSize, size_t xMaxSize);
 
+/**
+ * @brief   Retrieve multiple items from a no-split ring buffer
+ *
+ * Attempt to retrieve up to uxMaxItems items from a no-split ring buffer in a
+ * single call. All items available for retrieval (up to uxMaxItems) are
+ * retrieved at once. This function will block until at least one item is
+ * available or until it times out.
+ *
+ * @param[in]   xRingbuffer     Ring buffer to retrieve the items from
+ * @param[out]  ppvItems        Array of at least uxMaxItems elements to which pointers to the retrieved items will be written.
+ * @param[out]  pxItemSizes     Array of at least uxMaxItems elements to which the sizes of the retrieved items will be written.
+ * @param[in]   uxMaxItems      Maximum number of items to retrieve
+ * @param[in]   xTicksToWait    Ticks to wait for items in the ring buffer.
+ *
+ * @note    The retrieved items must be freed by a call to vRingbufferReturnItems(), or by
+ *          calling vRingbufferReturnItem() for each item.
+ * @note    This function should only be called on no-split buffers (RINGBUF_TYPE_NOSPLIT or RINGBUF_TYPE_NOSPLIT_SPSC)
+ * @note    If the ring buffer was added to a queue set, xQueueSelectFromSet() will still return the ring buffer once
+ *          for every item sent. The subsequent calls of this function for items that were already retrieved return 0.
+ *
+ * @return
+ *      - Number of items retrieved, ppvItems and pxItemSizes are filled for that many items
+ *      - 0 on timeout or if uxMaxItems is 0
+ */
+UBaseType_t xRingbufferReceiveMultiple(RingbufHandle_t xRingbuffer,
+                                       void **ppvItems,
+                                       size_t *pxItemSizes,
+                                       UBaseType_t uxMaxItems,
+                                       TickType_t xTicksToWait);
+
 /**
  * @brief   Return a previously-retrieved item to the ring buffer
  *
@@ -386,6 +462,18 @@ void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void *pvItem);
  */
 void vRingbufferReturnItemFromISR(RingbufHandle_t xRingbuffer, void *pvItem, BaseType_t *pxHigherPriorityTaskWoken);
 
+/**
+ * @brief   Return multiple previously-retrieved items to the ring buffer
+ *
+ * The items are freed in a single call. A task waiting for free space is only unblocked once, after
+ * all the items have been returned.
+ *
+ * @param[in]   xRingbuffer     Ring buffer the items were retrieved from
+ * @param[in]   ppvItems        Array of items that were received earlier
+ * @param[in]   uxItemCount     Number of items in ppvItems
+ */
+void vRingbufferReturnItems(RingbufHandle_t xRingbuffer, void *const *ppvItems, UBaseType_t uxItemCount);
+
 /**
  * @brief   Delete a ring buffer
  *
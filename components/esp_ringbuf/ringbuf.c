@@ -27,6 +27,9 @@
 #define rbBUFFER_FULL_FLAG          ( ( UBaseType_t ) 4 )   //The ring buffer is currently full (write pointer == free pointer)
 #define rbBUFFER_STATIC_FLAG        ( ( UBaseType_t ) 8 )   //The ring buffer is statically allocated
 #define rbUSING_QUEUE_SET           ( ( UBaseType_t ) 16 )  //The ring buffer has been added to a queue set
+#define rbSPSC_FLAG                 ( ( UBaseType_t ) 32 )  //The ring buffer has a single producer and a single consumer, which do not take the lock
+#define rbSENDER_WAITING_FLAG       ( ( UBaseType_t ) 64 )  //Valid for RINGBUF_TYPE_NOSPLIT_SPSC, the producer is about to block waiting for free space
+#define rbRECEIVER_WAITING_FLAG     ( ( UBaseType_t ) 128 ) //Valid for RINGBUF_TYPE_NOSPLIT_SPSC, the consumer is about to block waiting for an item
 
 //Item flags
 #define rbITEM_FREE_FLAG            ( ( UBaseType_t ) 1 )   //Item has been retrieved and returned by application, free to overwrite
@@ -43,7 +46,7 @@ typedef struct {
 #define rbHEADER_SIZE     sizeof(ItemHeader_t)
 typedef struct RingbufferDefinition Ringbuffer_t;
 typedef BaseType_t (*CheckItemFitsFunction_t)(Ringbuffer_t *pxRingbuffer, size_t xItemSize);
-typedef void (*CopyItemFunction_t)(Ringbuffer_t *pxRingbuffer, const uint8_t *pcItem, size_t xItemSize);
+typedef void (*CopyItemFunction_t)(Ringbuffer_t *pxRingbuffer, const RingbufferFragment_t *pxFragments, size_t xItemSize);
 typedef BaseType_t (*CheckItemAvailFunction_t)(Ringbuffer_t *pxRingbuffer);
 typedef void *(*GetItemFunction_t)(Ringbuffer_t *pxRingbuffer, BaseType_t *pxIsSplit, size_t xMaxSize, size_t *pxItemSize);
 typedef void (*ReturnItemFunction_t)(Ringbuffer_t *pxRingbuffer, uint8_t *pvItem);
@@ -103,6 +106,20 @@ static BaseType_t prvCheckItemFitsDefault(Ringbuffer_t *pxRingbuffer, size_t xIt
 //Checks if an item will currently fit in a byte buffer
 static BaseType_t prvCheckItemFitsByteBuffer(Ringbuffer_t *pxRingbuffer, size_t xItemSize);
 
+/*
+Get the largest item (including its header) that currently fits in a SPSC ring buffer
+    - Only called by the producer, does not require the lock
+    - pucAcquire is never allowed to catch up with pucFree, so pucAcquire == pucFree always means the buffer is empty
+      and the full flag (which would have to be written by both sides) is never used
+*/
+static size_t prvGetMaxTotalSizeSPSC(Ringbuffer_t *pxRingbuffer);
+
+//Checks if an item will currently fit in a SPSC ring buffer
+static BaseType_t prvCheckItemFitsSPSC(Ringbuffer_t *pxRingbuffer, size_t xItemSize);
+
+//Copies xLen bytes, starting at xOffset bytes into the data described by pxFragments, to pucDest
+static void prvCopyFragments(uint8_t *pucDest, const RingbufferFragment_t *pxFragments, size_t xOffset, size_t xLen);
+
 /*
 Copies an item to a no-split ring buffer
 Entry:
@@ -112,7 +129,7 @@ Exit:
     - pucAcquire and pucWrite updated.
     - Dummy item added if necessary
 */
-static void prvCopyItemNoSplit(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize);
+static void prvCopyItemNoSplit(Ringbuffer_t *pxRingbuffer, const RingbufferFragment_t *pxFragments, size_t xItemSize);
 
 /*
 Copies an item to a allow-split ring buffer
@@ -123,10 +140,10 @@ Exit:
     - pucAcquire and pucWrite updated
     - Item may be split
 */
-static void prvCopyItemAllowSplit(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize);
+static void prvCopyItemAllowSplit(Ringbuffer_t *pxRingbuffer, const RingbufferFragment_t *pxFragments, size_t xItemSize);
 
 //Copies an item to a byte buffer. Only call this function  after calling prvCheckItemFitsByteBuffer()
-static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize);
+static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const RingbufferFragment_t *pxFragments, size_t xItemSize);
 
 //Retrieve item from no-split/allow-split ring buffer. *pxIsSplit is set to pdTRUE if the retrieved item is split
 /*
@@ -166,16 +183,19 @@ static size_t prvGetCurMaxSizeNoSplit(Ringbuffer_t *pxRingbuffer);
 //Get the maximum size an item that can currently have if sent to a allow-split ring buffer
 static size_t prvGetCurMaxSizeAllowSplit(Ringbuffer_t *pxRingbuffer);
 
+//Get the maximum size an item that can currently have if sent to a SPSC ring buffer
+static size_t prvGetCurMaxSizeSPSC(Ringbuffer_t *pxRingbuffer);
+
 //Get the maximum size an item that can currently have if sent to a byte buffer
 static size_t prvGetCurMaxSizeByteBuf(Ringbuffer_t *pxRingbuffer);
 
 /*
 Generic function used to send or acquire an item/buffer.
-- If sending, set ppvItem to NULL. pvItem remains unchanged on failure.
-- If acquiring, set pvItem to NULL. ppvItem remains unchanged on failure.
+- If sending, set ppvItem to NULL. The item's data is described by pxFragments.
+- If acquiring, set pxFragments to NULL. ppvItem remains unchanged on failure.
 */
 static BaseType_t prvSendAcquireGeneric(Ringbuffer_t *pxRingbuffer,
-                                        const void *pvItem,
+                                        const RingbufferFragment_t *pxFragments,
                                         void **ppvItem,
                                         size_t xItemSize,
                                         TickType_t xTicksToWait);
@@ -202,8 +222,65 @@ static BaseType_t prvReceiveGenericFromISR(Ringbuffer_t *pxRingbuffer,
                                            size_t *xItemSize2,
                                            size_t xMaxSize);
 
+/*
+Retrieve up to uxMaxItems items from a no-split ring buffer without blocking. The lock is taken once for all items
+(and not at all for SPSC ring buffers). Returns the number of items retrieved.
+*/
+static UBaseType_t prvReceiveMultipleNoSplit(Ringbuffer_t *pxRingbuffer,
+                                             void **ppvItems,
+                                             size_t *pxItemSizes,
+                                             UBaseType_t uxMaxItems);
+
+/*
+Send or acquire an item in a SPSC ring buffer without taking the lock. Returns pdFALSE if the item does not
+currently fit, the caller then falls back to prvSendAcquireGeneric() if it needs to block.
+*/
+static BaseType_t prvSendAcquireSPSC(Ringbuffer_t *pxRingbuffer,
+                                     const RingbufferFragment_t *pxFragments,
+                                     void **ppvItem,
+                                     size_t xItemSize,
+                                     BaseType_t xInISR,
+                                     BaseType_t *pxHigherPriorityTaskWoken);
+
+//Retrieve an item from a SPSC ring buffer without taking the lock. Returns NULL if no item is available
+static void *prvReceiveSPSC(Ringbuffer_t *pxRingbuffer, size_t *pxItemSize);
+
+//Notify the consumer of a SPSC ring buffer (or its queue set) that an item has been sent
+static void prvNotifyReceiverSPSC(Ringbuffer_t *pxRingbuffer, BaseType_t xInISR, BaseType_t *pxHigherPriorityTaskWoken);
+
+/*
+Unblock the other side of a SPSC ring buffer after a pointer has been published without the lock. The lock is only
+taken if the other side has set uxWaitingFlag (see prvSetWaitingSPSC())
+*/
+static void prvWakeWaitingSPSC(Ringbuffer_t *pxRingbuffer,
+                               UBaseType_t uxWaitingFlag,
+                               List_t *pxTasksWaiting,
+                               BaseType_t xInISR,
+                               BaseType_t *pxHigherPriorityTaskWoken);
+
 // ------------------------------------------------ Static Functions ---------------------------------------------------
 
+static inline void prvAddItemsWaiting(Ringbuffer_t *pxRingbuffer, BaseType_t xCount)
+{
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //Updated by both the producer and the consumer of a SPSC buffer without the lock
+        __atomic_fetch_add(&pxRingbuffer->xItemsWaiting, xCount, __ATOMIC_RELAXED);
+    } else {
+        pxRingbuffer->xItemsWaiting += xCount;
+    }
+}
+
+/*
+Called with the lock held by one side of a SPSC ring buffer before it checks the buffer and possibly blocks. The
+barrier pairs with the one in prvWakeWaitingSPSC(): either the other side sees the flag and takes the lock to unblock
+us, or we see the pointer it has published.
+*/
+static inline void prvSetWaitingSPSC(Ringbuffer_t *pxRingbuffer, UBaseType_t uxWaitingFlag)
+{
+    __atomic_store_n(&pxRingbuffer->uxRingbufferFlags, pxRingbuffer->uxRingbufferFlags | uxWaitingFlag, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
 static void prvInitializeNewRingbuffer(size_t xBufferSize,
                                        RingbufferType_t xBufferType,
                                        Ringbuffer_t *pxNewRingbuffer,
@@ -241,6 +318,15 @@ static void prvInitializeNewRingbuffer(size_t xBufferSize,
         //Worst case an item is split into two, incurring two headers of overhead
         pxNewRingbuffer->xMaxItemSize = pxNewRingbuffer->xSize - (sizeof(ItemHeader_t) * 2);
         pxNewRingbuffer->xGetCurMaxSize = prvGetCurMaxSizeAllowSplit;
+    } else if (xBufferType == RINGBUF_TYPE_NOSPLIT_SPSC) {
+        pxNewRingbuffer->uxRingbufferFlags |= rbSPSC_FLAG;
+        pxNewRingbuffer->xCheckItemFits = prvCheckItemFitsSPSC;
+        pxNewRingbuffer->vCopyItem = prvCopyItemNoSplit;
+        pxNewRingbuffer->pvGetItem = prvGetItemDefault;
+        pxNewRingbuffer->vReturnItem = prvReturnItemDefault;
+        //Same worst case as no-split buffers, minus the aligned word that always separates pucAcquire from pucFree
+        pxNewRingbuffer->xMaxItemSize = rbALIGN_SIZE(pxNewRingbuffer->xSize / 2) - rbHEADER_SIZE - (rbALIGN_MASK + 1);
+        pxNewRingbuffer->xGetCurMaxSize = prvGetCurMaxSizeSPSC;
     } else { //Byte Buffer
         pxNewRingbuffer->uxRingbufferFlags |= rbBYTE_BUFFER_FLAG;
         pxNewRingbuffer->xCheckItemFits = prvCheckItemFitsByteBuffer;
@@ -321,6 +407,38 @@ static BaseType_t prvCheckItemFitsByteBuffer(Ringbuffer_t *pxRingbuffer, size_t
     return (xItemSize <= pxRingbuffer->xSize - (pxRingbuffer->pucAcquire - pxRingbuffer->pucFree)) ? pdTRUE : pdFALSE;
 }
 
+static size_t prvGetMaxTotalSizeSPSC(Ringbuffer_t *pxRingbuffer)
+{
+    //pucFree is moved by the consumer, the items before it may be overwritten once it has been read
+    uint8_t *pucFree = __atomic_load_n(&pxRingbuffer->pucFree, __ATOMIC_ACQUIRE);
+    uint8_t *pucAcquire = pxRingbuffer->pucAcquire;
+    configASSERT(rbCHECK_ALIGNED(pucAcquire));
+    configASSERT(pucAcquire >= pxRingbuffer->pucHead && pucAcquire < pxRingbuffer->pucTail);
+
+    if (pucFree > pucAcquire) {
+        //Free space does not wrap around. Leave an aligned word so that pucAcquire stays behind pucFree
+        return pucFree - pucAcquire - (rbALIGN_MASK + 1);
+    }
+    //Free space wraps around, or the buffer is empty (pucAcquire == pucFree)
+    size_t xTailSize = pxRingbuffer->pucTail - pucAcquire;
+    if (pucFree == pxRingbuffer->pucHead) {
+        //pucAcquire must not wrap around onto pucFree after the item, so the item must leave room for a header
+        xTailSize = (xTailSize > rbHEADER_SIZE) ? xTailSize - rbHEADER_SIZE : 0;
+    }
+    size_t xHeadSize = pucFree - pxRingbuffer->pucHead;
+    xHeadSize = (xHeadSize > rbALIGN_MASK + 1) ? xHeadSize - (rbALIGN_MASK + 1) : 0;
+    return (xTailSize > xHeadSize) ? xTailSize : xHeadSize;
+}
+
+static BaseType_t prvCheckItemFitsSPSC(Ringbuffer_t *pxRingbuffer, size_t xItemSize)
+{
+    /*
+     * prvAcquireItemNoSplit() only wraps around if the item does not fit at the tail. If pucFree is at pucHead the
+     * tail size is reduced but the head size is 0, so an item that fits is always placed where it was checked.
+     */
+    return (rbALIGN_SIZE(xItemSize) + rbHEADER_SIZE <= prvGetMaxTotalSizeSPSC(pxRingbuffer)) ? pdTRUE : pdFALSE;
+}
+
 static uint8_t* prvAcquireItemNoSplit(Ringbuffer_t *pxRingbuffer, size_t xItemSize)
 {
     //Check arguments and buffer state
@@ -375,7 +493,7 @@ static void prvSendItemDoneNoSplit(Ringbuffer_t *pxRingbuffer, uint8_t* pucItem)
     pxCurHeader->uxItemFlags &= ~rbITEM_SPLIT_FLAG;                         //Clear wrap flag if set (not strictly necessary)
     pxCurHeader->uxItemFlags |= rbITEM_WRITTEN_FLAG;                           //Mark as written
 
-    pxRingbuffer->xItemsWaiting++;
+    prvAddItemsWaiting(pxRingbuffer, 1);
 
     /*
      * Items might not be written in the order they were acquired. Move the
@@ -384,45 +502,69 @@ static void prvSendItemDoneNoSplit(Ringbuffer_t *pxRingbuffer, uint8_t* pucItem)
      * pointer, items that have already been written or items with dummy data
      * should be skipped over
      */
-    pxCurHeader = (ItemHeader_t *)pxRingbuffer->pucWrite;
+    uint8_t *pucWrite = pxRingbuffer->pucWrite;
+    pxCurHeader = (ItemHeader_t *)pucWrite;
     //Skip over Items that have already been written or are dummy items
     while (((pxCurHeader->uxItemFlags & rbITEM_WRITTEN_FLAG) || (pxCurHeader->uxItemFlags & rbITEM_DUMMY_DATA_FLAG))) {
         if (pxCurHeader->uxItemFlags & rbITEM_DUMMY_DATA_FLAG) {
             pxCurHeader->uxItemFlags |= rbITEM_WRITTEN_FLAG;   //Mark as freed (not strictly necessary but adds redundancy)
-            pxRingbuffer->pucWrite = pxRingbuffer->pucHead;    //Wrap around due to dummy data
+            pucWrite = pxRingbuffer->pucHead;                   //Wrap around due to dummy data
         } else {
             //Item with data that has already been written, advance write pointer past this item
             size_t xAlignedItemSize = rbALIGN_SIZE(pxCurHeader->xItemLen);
-            pxRingbuffer->pucWrite += xAlignedItemSize + rbHEADER_SIZE;
+            pucWrite += xAlignedItemSize + rbHEADER_SIZE;
             //Redundancy check to ensure write pointer has not overshot buffer bounds
-            configASSERT(pxRingbuffer->pucWrite <= pxRingbuffer->pucHead + pxRingbuffer->xSize);
+            configASSERT(pucWrite <= pxRingbuffer->pucHead + pxRingbuffer->xSize);
         }
         //Check if pucWrite requires wrap around
-        if ((pxRingbuffer->pucTail - pxRingbuffer->pucWrite) < rbHEADER_SIZE) {
-            pxRingbuffer->pucWrite = pxRingbuffer->pucHead;
+        if ((pxRingbuffer->pucTail - pucWrite) < rbHEADER_SIZE) {
+            pucWrite = pxRingbuffer->pucHead;
         }
 
         // If the write pointer has caught up to the acquire pointer, we can break out of the loop
-        if (pxRingbuffer->pucWrite == pxRingbuffer->pucAcquire) {
+        if (pucWrite == pxRingbuffer->pucAcquire) {
             break;
         }
 
-        pxCurHeader = (ItemHeader_t *)pxRingbuffer->pucWrite;      //Update header to point to item
+        pxCurHeader = (ItemHeader_t *)pucWrite;      //Update header to point to item
+    }
+    //Publish the write pointer once all items before it are written. SPSC consumers read it without the lock.
+    __atomic_store_n(&pxRingbuffer->pucWrite, pucWrite, __ATOMIC_RELEASE);
+}
+
+static void prvCopyFragments(uint8_t *pucDest, const RingbufferFragment_t *pxFragments, size_t xOffset, size_t xLen)
+{
+    while (xLen > 0) {
+        if (xOffset >= pxFragments->xSize) {
+            //Skip fragments that have already been copied
+            xOffset -= pxFragments->xSize;
+        } else {
+            size_t xCopyLen = pxFragments->xSize - xOffset;
+            if (xCopyLen > xLen) {
+                xCopyLen = xLen;
+            }
+            memcpy(pucDest, (const uint8_t *)pxFragments->pvData + xOffset, xCopyLen);
+            pucDest += xCopyLen;
+            xLen -= xCopyLen;
+            xOffset = 0;
+        }
+        pxFragments++;
     }
 }
 
-static void prvCopyItemNoSplit(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize)
+static void prvCopyItemNoSplit(Ringbuffer_t *pxRingbuffer, const RingbufferFragment_t *pxFragments, size_t xItemSize)
 {
     uint8_t* item_addr = prvAcquireItemNoSplit(pxRingbuffer, xItemSize);
-    memcpy(item_addr, pucItem, xItemSize);
+    prvCopyFragments(item_addr, pxFragments, 0, xItemSize);
     prvSendItemDoneNoSplit(pxRingbuffer, item_addr);
 }
 
-static void prvCopyItemAllowSplit(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize)
+static void prvCopyItemAllowSplit(Ringbuffer_t *pxRingbuffer, const RingbufferFragment_t *pxFragments, size_t xItemSize)
 {
     //Check arguments and buffer state
     size_t xAlignedItemSize = rbALIGN_SIZE(xItemSize);                  //Rounded up aligned item size
     size_t xRemLen = pxRingbuffer->pucTail - pxRingbuffer->pucAcquire;    //Length from pucAcquire until end of buffer
+    size_t xOffset = 0;                                                 //Offset of the data still to be copied
     configASSERT(rbCHECK_ALIGNED(pxRingbuffer->pucAcquire));              //pucAcquire is always aligned in split ring buffers
     configASSERT(pxRingbuffer->pucAcquire >= pxRingbuffer->pucHead && pxRingbuffer->pucAcquire < pxRingbuffer->pucTail);    //Check write pointer is within bounds
     configASSERT(xRemLen >= rbHEADER_SIZE);                             //Remaining length must be able to at least fit an item header
@@ -436,10 +578,10 @@ static void prvCopyItemAllowSplit(Ringbuffer_t *pxRingbuffer, const uint8_t *puc
         pxRingbuffer->pucAcquire += rbHEADER_SIZE;            //Advance pucAcquire past header
         xRemLen -= rbHEADER_SIZE;
         if (xRemLen > 0) {
-            memcpy(pxRingbuffer->pucAcquire, pucItem, xRemLen);
+            prvCopyFragments(pxRingbuffer->pucAcquire, pxFragments, 0, xRemLen);
             pxRingbuffer->xItemsWaiting++;
             //Update item arguments to account for data already copied
-            pucItem += xRemLen;
+            xOffset = xRemLen;
             xItemSize -= xRemLen;
             xAlignedItemSize -= xRemLen;
             pxFirstHeader->uxItemFlags |= rbITEM_SPLIT_FLAG;        //There must be more data
@@ -455,7 +597,7 @@ static void prvCopyItemAllowSplit(Ringbuffer_t *pxRingbuffer, const uint8_t *puc
     pxSecondHeader->xItemLen = xItemSize;
     pxSecondHeader->uxItemFlags = 0;
     pxRingbuffer->pucAcquire += rbHEADER_SIZE;     //Advance acquire pointer past header
-    memcpy(pxRingbuffer->pucAcquire, pucItem, xItemSize);
+    prvCopyFragments(pxRingbuffer->pucAcquire, pxFragments, xOffset, xItemSize);
     pxRingbuffer->xItemsWaiting++;
     pxRingbuffer->pucAcquire += xAlignedItemSize;  //Advance pucAcquire past item to next aligned address
 
@@ -473,23 +615,24 @@ static void prvCopyItemAllowSplit(Ringbuffer_t *pxRingbuffer, const uint8_t *puc
     pxRingbuffer->pucWrite = pxRingbuffer->pucAcquire;
 }
 
-static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucItem, size_t xItemSize)
+static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const RingbufferFragment_t *pxFragments, size_t xItemSize)
 {
     //Check arguments and buffer state
     configASSERT(pxRingbuffer->pucAcquire >= pxRingbuffer->pucHead && pxRingbuffer->pucAcquire < pxRingbuffer->pucTail);    //Check acquire pointer is within bounds
 
     size_t xRemLen = pxRingbuffer->pucTail - pxRingbuffer->pucAcquire;    //Length from pucAcquire until end of buffer
+    size_t xOffset = 0;                                                 //Offset of the data still to be copied
     if (xRemLen < xItemSize) {
         //Copy as much as possible into remaining length
-        memcpy(pxRingbuffer->pucAcquire, pucItem, xRemLen);
+        prvCopyFragments(pxRingbuffer->pucAcquire, pxFragments, 0, xRemLen);
         pxRingbuffer->xItemsWaiting += xRemLen;
         //Update item arguments to account for data already written
-        pucItem += xRemLen;
+        xOffset = xRemLen;
         xItemSize -= xRemLen;
         pxRingbuffer->pucAcquire = pxRingbuffer->pucHead;     //Reset acquire pointer to start of buffer
     }
     //Copy all or remaining portion of the item
-    memcpy(pxRingbuffer->pucAcquire, pucItem, xItemSize);
+    prvCopyFragments(pxRingbuffer->pucAcquire, pxFragments, xOffset, xItemSize);
     pxRingbuffer->xItemsWaiting += xItemSize;
     pxRingbuffer->pucAcquire += xItemSize;
 
@@ -508,6 +651,10 @@ static void prvCopyItemByteBuf(Ringbuffer_t *pxRingbuffer, const uint8_t *pucIte
 
 static BaseType_t prvCheckItemAvail(Ringbuffer_t *pxRingbuffer)
 {
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //SPSC buffers are never marked as full, and pucWrite is only moved past items that have been written
+        return (pxRingbuffer->pucRead != __atomic_load_n(&pxRingbuffer->pucWrite, __ATOMIC_ACQUIRE)) ? pdTRUE : pdFALSE;
+    }
     if ((pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG) && pxRingbuffer->pucRead != pxRingbuffer->pucFree) {
         return pdFALSE;     //Byte buffers do not allow multiple retrievals before return
     }
@@ -555,7 +702,7 @@ static void *prvGetItemDefault(Ringbuffer_t *pxRingbuffer,
         configASSERT(pcReturn >= pxRingbuffer->pucHead && pcReturn < pxRingbuffer->pucTail);
     }
     *pxItemSize = pxHeader->xItemLen;   //Get length of item
-    pxRingbuffer->xItemsWaiting --;     //Update item count
+    prvAddItemsWaiting(pxRingbuffer, -1);   //Update item count
     *pxIsSplit = (pxHeader->uxItemFlags & rbITEM_SPLIT_FLAG) ? pdTRUE : pdFALSE;
 
     pxRingbuffer->pucRead += rbHEADER_SIZE + rbALIGN_SIZE(pxHeader->xItemLen);   //Update pucRead
@@ -628,25 +775,28 @@ static void prvReturnItemDefault(Ringbuffer_t *pxRingbuffer, uint8_t *pucItem)
      * till the read pointer. When advancing the free pointer, items that have already been
      * freed or items with dummy data should be skipped over
      */
-    pxCurHeader = (ItemHeader_t *)pxRingbuffer->pucFree;
+    uint8_t *pucFree = pxRingbuffer->pucFree;
+    pxCurHeader = (ItemHeader_t *)pucFree;
     //Skip over Items that have already been freed or are dummy items
-    while (((pxCurHeader->uxItemFlags & rbITEM_FREE_FLAG) || (pxCurHeader->uxItemFlags & rbITEM_DUMMY_DATA_FLAG)) && pxRingbuffer->pucFree != pxRingbuffer->pucRead) {
+    while (((pxCurHeader->uxItemFlags & rbITEM_FREE_FLAG) || (pxCurHeader->uxItemFlags & rbITEM_DUMMY_DATA_FLAG)) && pucFree != pxRingbuffer->pucRead) {
         if (pxCurHeader->uxItemFlags & rbITEM_DUMMY_DATA_FLAG) {
             pxCurHeader->uxItemFlags |= rbITEM_FREE_FLAG;   //Mark as freed (not strictly necessary but adds redundancy)
-            pxRingbuffer->pucFree = pxRingbuffer->pucHead;    //Wrap around due to dummy data
+            pucFree = pxRingbuffer->pucHead;                  //Wrap around due to dummy data
         } else {
             //Item with data that has already been freed, advance free pointer past this item
             size_t xAlignedItemSize = rbALIGN_SIZE(pxCurHeader->xItemLen);
-            pxRingbuffer->pucFree += xAlignedItemSize + rbHEADER_SIZE;
+            pucFree += xAlignedItemSize + rbHEADER_SIZE;
             //Redundancy check to ensure free pointer has not overshot buffer bounds
-            configASSERT(pxRingbuffer->pucFree <= pxRingbuffer->pucHead + pxRingbuffer->xSize);
+            configASSERT(pucFree <= pxRingbuffer->pucHead + pxRingbuffer->xSize);
         }
         //Check if pucFree requires wrap around
-        if ((pxRingbuffer->pucTail - pxRingbuffer->pucFree) < rbHEADER_SIZE) {
-            pxRingbuffer->pucFree = pxRingbuffer->pucHead;
+        if ((pxRingbuffer->pucTail - pucFree) < rbHEADER_SIZE) {
+            pucFree = pxRingbuffer->pucHead;
         }
-        pxCurHeader = (ItemHeader_t *)pxRingbuffer->pucFree;      //Update header to point to item
+        pxCurHeader = (ItemHeader_t *)pucFree;      //Update header to point to item
     }
+    //Publish the free pointer once the items before it are no longer used. SPSC producers read it without the lock.
+    __atomic_store_n(&pxRingbuffer->pucFree, pucFree, __ATOMIC_RELEASE);
 
     //Check if the buffer full flag should be reset
     if (pxRingbuffer->uxRingbufferFlags & rbBUFFER_FULL_FLAG) {
@@ -736,6 +886,17 @@ static size_t prvGetCurMaxSizeAllowSplit(Ringbuffer_t *pxRingbuffer)
     return xFreeSize;
 }
 
+static size_t prvGetCurMaxSizeSPSC(Ringbuffer_t *pxRingbuffer)
+{
+    size_t xFreeSize = prvGetMaxTotalSizeSPSC(pxRingbuffer);
+    //SPSC ring buffer items need space for a header
+    if (xFreeSize < rbHEADER_SIZE) {
+        return 0;
+    }
+    xFreeSize -= rbHEADER_SIZE;
+    return (xFreeSize > pxRingbuffer->xMaxItemSize) ? pxRingbuffer->xMaxItemSize : xFreeSize;
+}
+
 static size_t prvGetCurMaxSizeByteBuf(Ringbuffer_t *pxRingbuffer)
 {
     BaseType_t xFreeSize;
@@ -756,7 +917,7 @@ static size_t prvGetCurMaxSizeByteBuf(Ringbuffer_t *pxRingbuffer)
 }
 
 static BaseType_t prvSendAcquireGeneric(Ringbuffer_t *pxRingbuffer,
-                                        const void *pvItem,
+                                        const RingbufferFragment_t *pxFragments,
                                         void **ppvItem,
                                         size_t xItemSize,
                                         TickType_t xTicksToWait)
@@ -769,6 +930,10 @@ static BaseType_t prvSendAcquireGeneric(Ringbuffer_t *pxRingbuffer,
 
     while (xExitLoop == pdFALSE) {
         portENTER_CRITICAL(&pxRingbuffer->mux);
+        if ((pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) && xTicksToWait != 0) {
+            //The consumer of a SPSC buffer returns items without the lock, let it know it has to unblock us
+            prvSetWaitingSPSC(pxRingbuffer, rbSENDER_WAITING_FLAG);
+        }
         if (pxRingbuffer->xCheckItemFits(pxRingbuffer, xItemSize) == pdTRUE) {
             //xItemSize will fit. Copy or acquire the buffer immediately
             if (ppvItem) {
@@ -776,7 +941,7 @@ static BaseType_t prvSendAcquireGeneric(Ringbuffer_t *pxRingbuffer,
                 *ppvItem = prvAcquireItemNoSplit(pxRingbuffer, xItemSize);
             } else {
                 //Copy item into buffer
-                pxRingbuffer->vCopyItem(pxRingbuffer, pvItem, xItemSize);
+                pxRingbuffer->vCopyItem(pxRingbuffer, pxFragments, xItemSize);
                 if (pxRingbuffer->xQueueSet) {
                     //If ring buffer was added to a queue set, notify the queue set
                     xNotifyQueueSet = pdTRUE;
@@ -812,6 +977,9 @@ static BaseType_t prvSendAcquireGeneric(Ringbuffer_t *pxRingbuffer,
             xExitLoop = pdTRUE;
         }
 loop_end:
+        if (xExitLoop == pdTRUE) {
+            pxRingbuffer->uxRingbufferFlags &= ~rbSENDER_WAITING_FLAG;
+        }
         portEXIT_CRITICAL(&pxRingbuffer->mux);
     }
     //Defer notifying the queue set until we are outside the loop and critical section.
@@ -839,6 +1007,10 @@ static BaseType_t prvReceiveGeneric(Ringbuffer_t *pxRingbuffer,
 
     while (xExitLoop == pdFALSE) {
         portENTER_CRITICAL(&pxRingbuffer->mux);
+        if ((pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) && xTicksToWait != 0) {
+            //The producer of a SPSC buffer sends items without the lock, let it know it has to unblock us
+            prvSetWaitingSPSC(pxRingbuffer, rbRECEIVER_WAITING_FLAG);
+        }
         if (prvCheckItemAvail(pxRingbuffer) == pdTRUE) {
             //Item/data is available for retrieval
             BaseType_t xIsSplit = pdFALSE;
@@ -882,6 +1054,9 @@ static BaseType_t prvReceiveGeneric(Ringbuffer_t *pxRingbuffer,
             xExitLoop = pdTRUE;
         }
 loop_end:
+        if (xExitLoop == pdTRUE) {
+            pxRingbuffer->uxRingbufferFlags &= ~rbRECEIVER_WAITING_FLAG;
+        }
         portEXIT_CRITICAL(&pxRingbuffer->mux);
     }
 
@@ -929,6 +1104,109 @@ static BaseType_t prvReceiveGenericFromISR(Ringbuffer_t *pxRingbuffer,
     return xReturn;
 }
 
+static UBaseType_t prvReceiveMultipleNoSplit(Ringbuffer_t *pxRingbuffer,
+                                             void **ppvItems,
+                                             size_t *pxItemSizes,
+                                             UBaseType_t uxMaxItems)
+{
+    UBaseType_t uxItemCount = 0;
+    BaseType_t xIsSplit;
+    BaseType_t xLocked = (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) ? pdFALSE : pdTRUE;
+
+    if (xLocked) {
+        portENTER_CRITICAL(&pxRingbuffer->mux);
+    }
+    while (uxItemCount < uxMaxItems && prvCheckItemAvail(pxRingbuffer) == pdTRUE) {
+        ppvItems[uxItemCount] = pxRingbuffer->pvGetItem(pxRingbuffer, &xIsSplit, 0, &pxItemSizes[uxItemCount]);
+        uxItemCount++;
+    }
+    if (xLocked) {
+        portEXIT_CRITICAL(&pxRingbuffer->mux);
+    }
+    return uxItemCount;
+}
+
+static BaseType_t prvSendAcquireSPSC(Ringbuffer_t *pxRingbuffer,
+                                     const RingbufferFragment_t *pxFragments,
+                                     void **ppvItem,
+                                     size_t xItemSize,
+                                     BaseType_t xInISR,
+                                     BaseType_t *pxHigherPriorityTaskWoken)
+{
+    //Only the producer moves pucAcquire and pucWrite, it only has to observe pucFree
+    if (prvCheckItemFitsSPSC(pxRingbuffer, xItemSize) == pdFALSE) {
+        return pdFALSE;
+    }
+    if (ppvItem) {
+        *ppvItem = prvAcquireItemNoSplit(pxRingbuffer, xItemSize);
+    } else {
+        prvCopyItemNoSplit(pxRingbuffer, pxFragments, xItemSize);
+        prvNotifyReceiverSPSC(pxRingbuffer, xInISR, pxHigherPriorityTaskWoken);
+    }
+    return pdTRUE;
+}
+
+static void *prvReceiveSPSC(Ringbuffer_t *pxRingbuffer, size_t *pxItemSize)
+{
+    //Only the consumer moves pucRead, it only has to observe pucWrite
+    if (prvCheckItemAvail(pxRingbuffer) == pdFALSE) {
+        return NULL;
+    }
+    BaseType_t xIsSplit;
+    return prvGetItemDefault(pxRingbuffer, &xIsSplit, 0, pxItemSize);
+}
+
+static void prvNotifyReceiverSPSC(Ringbuffer_t *pxRingbuffer, BaseType_t xInISR, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    if (pxRingbuffer->xQueueSet) {
+        //If ring buffer was added to a queue set, notify the queue set
+        if (xInISR) {
+            xQueueSendFromISR((QueueHandle_t)pxRingbuffer->xQueueSet, (QueueSetMemberHandle_t *)&pxRingbuffer, pxHigherPriorityTaskWoken);
+        } else {
+            xQueueSend((QueueHandle_t)pxRingbuffer->xQueueSet, (QueueSetMemberHandle_t *)&pxRingbuffer, 0);
+        }
+    } else {
+        prvWakeWaitingSPSC(pxRingbuffer, rbRECEIVER_WAITING_FLAG, &pxRingbuffer->xTasksWaitingToReceive, xInISR, pxHigherPriorityTaskWoken);
+    }
+}
+
+static void prvWakeWaitingSPSC(Ringbuffer_t *pxRingbuffer,
+                               UBaseType_t uxWaitingFlag,
+                               List_t *pxTasksWaiting,
+                               BaseType_t xInISR,
+                               BaseType_t *pxHigherPriorityTaskWoken)
+{
+    //Pairs with the barrier in prvSetWaitingSPSC()
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if ((__atomic_load_n(&pxRingbuffer->uxRingbufferFlags, __ATOMIC_RELAXED) & uxWaitingFlag) == 0) {
+        return;
+    }
+
+    if (xInISR) {
+        portENTER_CRITICAL_ISR(&pxRingbuffer->mux);
+    } else {
+        portENTER_CRITICAL(&pxRingbuffer->mux);
+    }
+    //The waiting task releases the lock only after it has been placed on the list, or after it stopped waiting
+    if (listLIST_IS_EMPTY(pxTasksWaiting) == pdFALSE) {
+        if (xTaskRemoveFromEventList(pxTasksWaiting) == pdTRUE) {
+            //The unblocked task will preempt us
+            if (xInISR) {
+                if (pxHigherPriorityTaskWoken != NULL) {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+            } else {
+                portYIELD_WITHIN_API();
+            }
+        }
+    }
+    if (xInISR) {
+        portEXIT_CRITICAL_ISR(&pxRingbuffer->mux);
+    } else {
+        portEXIT_CRITICAL(&pxRingbuffer->mux);
+    }
+}
+
 // ------------------------------------------------ Public Functions ---------------------------------------------------
 
 RingbufHandle_t xRingbufferCreate(size_t xBufferSize, RingbufferType_t xBufferType)
@@ -994,6 +1272,9 @@ BaseType_t xRingbufferSendAcquire(RingbufHandle_t xRingbuffer, void **ppvItem, s
     if (xItemSize > pxRingbuffer->xMaxItemSize) {
         return pdFALSE;     //Data will never ever fit in the queue.
     }
+    if ((pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) && prvSendAcquireSPSC(pxRingbuffer, NULL, ppvItem, xItemSize, pdFALSE, NULL) == pdTRUE) {
+        return pdTRUE;
+    }
 
     return prvSendAcquireGeneric(pxRingbuffer, NULL, ppvItem, xItemSize, xTicksToWait);
 }
@@ -1008,6 +1289,12 @@ BaseType_t xRingbufferSendComplete(RingbufHandle_t xRingbuffer, void *pvItem)
     configASSERT(pvItem != NULL);
     configASSERT((pxRingbuffer->uxRingbufferFlags & (rbBYTE_BUFFER_FLAG | rbALLOW_SPLIT_FLAG)) == 0);
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        prvSendItemDoneNoSplit(pxRingbuffer, pvItem);
+        prvNotifyReceiverSPSC(pxRingbuffer, pdFALSE, NULL);
+        return pdTRUE;
+    }
+
     portENTER_CRITICAL(&pxRingbuffer->mux);
     prvSendItemDoneNoSplit(pxRingbuffer, pvItem);
     if (pxRingbuffer->xQueueSet) {
@@ -1046,8 +1333,42 @@ BaseType_t xRingbufferSend(RingbufHandle_t xRingbuffer,
     if ((pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG) && xItemSize == 0) {
         return pdTRUE;      //Sending 0 bytes to byte buffer has no effect
     }
+    RingbufferFragment_t xFragment = { .pvData = pvItem, .xSize = xItemSize };
+    if ((pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) && prvSendAcquireSPSC(pxRingbuffer, &xFragment, NULL, xItemSize, pdFALSE, NULL) == pdTRUE) {
+        return pdTRUE;
+    }
+
+    return prvSendAcquireGeneric(pxRingbuffer, &xFragment, NULL, xItemSize, xTicksToWait);
+}
+
+BaseType_t xRingbufferSendv(RingbufHandle_t xRingbuffer,
+                            const RingbufferFragment_t *pxFragments,
+                            UBaseType_t uxFragmentCount,
+                            TickType_t xTicksToWait)
+{
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+
+    //Check arguments
+    configASSERT(pxRingbuffer);
+    configASSERT(pxFragments != NULL || uxFragmentCount == 0);
+    size_t xItemSize = 0;
+    for (UBaseType_t i = 0; i < uxFragmentCount; i++) {
+        configASSERT(pxFragments[i].pvData != NULL || pxFragments[i].xSize == 0);
+        //Compared to the space left below the maximum so that the sum can't overflow
+        if (pxFragments[i].xSize > pxRingbuffer->xMaxItemSize - xItemSize) {
+            return pdFALSE;     //Data will never ever fit in the queue.
+        }
+        xItemSize += pxFragments[i].xSize;
+    }
+    if ((pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG) && xItemSize == 0) {
+        return pdTRUE;      //Sending 0 bytes to byte buffer has no effect
+    }
+    //All fragments are copied into a single item, after a single check for free space
+    if ((pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) && prvSendAcquireSPSC(pxRingbuffer, pxFragments, NULL, xItemSize, pdFALSE, NULL) == pdTRUE) {
+        return pdTRUE;
+    }
 
-    return prvSendAcquireGeneric(pxRingbuffer, pvItem, NULL, xItemSize, xTicksToWait);
+    return prvSendAcquireGeneric(pxRingbuffer, pxFragments, NULL, xItemSize, xTicksToWait);
 }
 
 BaseType_t xRingbufferSendFromISR(RingbufHandle_t xRingbuffer,
@@ -1068,10 +1389,14 @@ BaseType_t xRingbufferSendFromISR(RingbufHandle_t xRingbuffer,
     if ((pxRingbuffer->uxRingbufferFlags & rbBYTE_BUFFER_FLAG) && xItemSize == 0) {
         return pdTRUE;      //Sending 0 bytes to byte buffer has no effect
     }
+    RingbufferFragment_t xFragment = { .pvData = pvItem, .xSize = xItemSize };
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        return prvSendAcquireSPSC(pxRingbuffer, &xFragment, NULL, xItemSize, pdTRUE, pxHigherPriorityTaskWoken);
+    }
 
     portENTER_CRITICAL_ISR(&pxRingbuffer->mux);
     if (pxRingbuffer->xCheckItemFits(xRingbuffer, xItemSize) == pdTRUE) {
-        pxRingbuffer->vCopyItem(xRingbuffer, pvItem, xItemSize);
+        pxRingbuffer->vCopyItem(xRingbuffer, &xFragment, xItemSize);
         if (pxRingbuffer->xQueueSet) {
             //If ring buffer was added to a queue set, notify the queue set
             xNotifyQueueSet = pdTRUE;
@@ -1108,6 +1433,12 @@ void *xRingbufferReceive(RingbufHandle_t xRingbuffer, size_t *pxItemSize, TickTy
 
     //Attempt to retrieve an item
     void *pvTempItem;
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        pvTempItem = prvReceiveSPSC(pxRingbuffer, pxItemSize);
+        if (pvTempItem != NULL || xTicksToWait == 0) {
+            return pvTempItem;
+        }
+    }
     if (prvReceiveGeneric(pxRingbuffer, &pvTempItem, NULL, pxItemSize, NULL, 0, xTicksToWait) == pdTRUE) {
         return pvTempItem;
     } else {
@@ -1123,6 +1454,10 @@ void *xRingbufferReceiveFromISR(RingbufHandle_t xRingbuffer, size_t *pxItemSize)
     configASSERT(pxRingbuffer && pxItemSize);
     configASSERT((pxRingbuffer->uxRingbufferFlags & rbALLOW_SPLIT_FLAG) == 0);    // This function must not be called for allow-split buffers
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        return prvReceiveSPSC(pxRingbuffer, pxItemSize);
+    }
+
     //Attempt to retrieve an item
     void *pvTempItem;
     if (prvReceiveGenericFromISR(pxRingbuffer, &pvTempItem, NULL, pxItemSize, NULL, 0) == pdTRUE) {
@@ -1206,12 +1541,46 @@ void *xRingbufferReceiveUpToFromISR(RingbufHandle_t xRingbuffer, size_t *pxItemS
     }
 }
 
+UBaseType_t xRingbufferReceiveMultiple(RingbufHandle_t xRingbuffer,
+                                       void **ppvItems,
+                                       size_t *pxItemSizes,
+                                       UBaseType_t uxMaxItems,
+                                       TickType_t xTicksToWait)
+{
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+
+    //Check arguments
+    configASSERT(pxRingbuffer && ppvItems && pxItemSizes);
+    configASSERT((pxRingbuffer->uxRingbufferFlags & (rbALLOW_SPLIT_FLAG | rbBYTE_BUFFER_FLAG)) == 0);    //This function should only be called for no-split buffers
+
+    if (uxMaxItems == 0) {
+        return 0;
+    }
+    //Attempt to retrieve all available items at once
+    UBaseType_t uxItemCount = prvReceiveMultipleNoSplit(pxRingbuffer, ppvItems, pxItemSizes, uxMaxItems);
+    if (uxItemCount > 0 || xTicksToWait == 0) {
+        return uxItemCount;
+    }
+    //Block until an item is available, then retrieve the items that were sent along with it
+    if (prvReceiveGeneric(pxRingbuffer, &ppvItems[0], NULL, &pxItemSizes[0], NULL, 0, xTicksToWait) == pdFALSE) {
+        return 0;
+    }
+    return 1 + prvReceiveMultipleNoSplit(pxRingbuffer, &ppvItems[1], &pxItemSizes[1], uxMaxItems - 1);
+}
+
 void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void *pvItem)
 {
     Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
     configASSERT(pxRingbuffer);
     configASSERT(pvItem != NULL);
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //Only the consumer moves pucFree
+        prvReturnItemDefault(pxRingbuffer, (uint8_t *)pvItem);
+        prvWakeWaitingSPSC(pxRingbuffer, rbSENDER_WAITING_FLAG, &pxRingbuffer->xTasksWaitingToSend, pdFALSE, NULL);
+        return;
+    }
+
     portENTER_CRITICAL(&pxRingbuffer->mux);
     pxRingbuffer->vReturnItem(pxRingbuffer, (uint8_t *)pvItem);
     //If a task was waiting for space to send, unblock it immediately.
@@ -1230,6 +1599,13 @@ void vRingbufferReturnItemFromISR(RingbufHandle_t xRingbuffer, void *pvItem, Bas
     configASSERT(pxRingbuffer);
     configASSERT(pvItem != NULL);
 
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //Only the consumer moves pucFree
+        prvReturnItemDefault(pxRingbuffer, (uint8_t *)pvItem);
+        prvWakeWaitingSPSC(pxRingbuffer, rbSENDER_WAITING_FLAG, &pxRingbuffer->xTasksWaitingToSend, pdTRUE, pxHigherPriorityTaskWoken);
+        return;
+    }
+
     portENTER_CRITICAL_ISR(&pxRingbuffer->mux);
     pxRingbuffer->vReturnItem(pxRingbuffer, (uint8_t *)pvItem);
     //If a task was waiting for space to send, unblock it immediately.
@@ -1244,6 +1620,42 @@ void vRingbufferReturnItemFromISR(RingbufHandle_t xRingbuffer, void *pvItem, Bas
     portEXIT_CRITICAL_ISR(&pxRingbuffer->mux);
 }
 
+void vRingbufferReturnItems(RingbufHandle_t xRingbuffer, void *const *ppvItems, UBaseType_t uxItemCount)
+{
+    Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
+    configASSERT(pxRingbuffer);
+    configASSERT(ppvItems != NULL || uxItemCount == 0);
+
+    if (uxItemCount == 0) {
+        return;
+    }
+
+    if (pxRingbuffer->uxRingbufferFlags & rbSPSC_FLAG) {
+        //Only the consumer moves pucFree
+        for (UBaseType_t i = 0; i < uxItemCount; i++) {
+            configASSERT(ppvItems[i] != NULL);
+            prvReturnItemDefault(pxRingbuffer, (uint8_t *)ppvItems[i]);
+        }
+        prvWakeWaitingSPSC(pxRingbuffer, rbSENDER_WAITING_FLAG, &pxRingbuffer->xTasksWaitingToSend, pdFALSE, NULL);
+        return;
+    }
+
+    portENTER_CRITICAL(&pxRingbuffer->mux);
+    //Items retrieved in FIFO order are also returned in that order, so each return only advances the free pointer by one item
+    for (UBaseType_t i = 0; i < uxItemCount; i++) {
+        configASSERT(ppvItems[i] != NULL);
+        pxRingbuffer->vReturnItem(pxRingbuffer, (uint8_t *)ppvItems[i]);
+    }
+    //If a task was waiting for space to send, unblock it immediately.
+    if (listLIST_IS_EMPTY(&pxRingbuffer->xTasksWaitingToSend) == pdFALSE) {
+        if (xTaskRemoveFromEventList(&pxRingbuffer->xTasksWaitingToSend) == pdTRUE) {
+            //The unblocked task will preempt us. Trigger a yield here.
+            portYIELD_WITHIN_API();
+        }
+    }
+    portEXIT_CRITICAL(&pxRingbuffer->mux);
+}
+
 void vRingbufferDelete(RingbufHandle_t xRingbuffer)
 {
     Ringbuffer_t *pxRingbuffer = (Ringbuffer_t *)xRingbuffer;
@@ -12,6 +12,8 @@
 #include "sdkconfig.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
@@ -756,7 +758,7 @@ void read_from_buffer(RingbufHandle_t buffer, RingbufferType_t buf_type, size_t
             char *item_data, *item_data2;
 
             //Select appropriate receive function for type of ring buffer
-            if (buf_type ==  RINGBUF_TYPE_NOSPLIT) {
+            if (buf_type == RINGBUF_TYPE_NOSPLIT || buf_type == RINGBUF_TYPE_NOSPLIT_SPSC) {
                 item_data = (char *)xRingbufferReceive(buffer, &item_size, TIMEOUT_TICKS);
             } else if (buf_type == RINGBUF_TYPE_ALLOWSPLIT) {
                 BaseType_t ret = xRingbufferReceiveSplit(buffer, (void **)&item_data, (void **)&item_data2, &item_size, &item_size2, TIMEOUT_TICKS);
@@ -1124,3 +1126,273 @@ TEST_CASE("Test no-split buffers can receive items if the acquire pointer wraps
     // Cleanup
     vRingbufferDelete(buffer_handle);
 }
+
+/* ------------------------- Test SPSC no-split ring buffers -------------------------
+ * The following test case tests the single-producer/single-consumer no-split ring buffer. The test case will do the
+ * following...
+ * 1) Create an SPSC ring buffer and check that its maximum item size is one alignment unit smaller than that of a
+ *    no-split ring buffer of the same size.
+ * 2) Send items until the buffer is full. The SPSC buffer always keeps a gap between the acquire and free pointers,
+ *    hence it holds one item less than the no-split buffer.
+ * 3) Return the items out of order and check that the space is only freed once the first item is returned.
+ * 4) Send and receive items so that the buffer wraps around.
+ * 5) Check that a task blocked on receive is woken up by a send, and a task blocked on send is woken up by a return.
+ */
+
+static void spsc_blocked_task(void *args)
+{
+    RingbufHandle_t buffer = (RingbufHandle_t)args;
+    size_t item_size;
+
+    //Block until the test task sends an item
+    void *item = xRingbufferReceive(buffer, &item_size, portMAX_DELAY);
+    TEST_ASSERT_MESSAGE(item != NULL && item_size == SMALL_ITEM_SIZE, "Failed to receive item");
+    vRingbufferReturnItem(buffer, item);
+    xSemaphoreGive(done_sem);
+
+    //Wait for the test task to fill the buffer, then block until it frees space
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    TEST_ASSERT_MESSAGE(xRingbufferSend(buffer, large_item, MEDIUM_ITEM_SIZE, portMAX_DELAY) == pdTRUE, "Failed to send item");
+    xSemaphoreGive(done_sem);
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Test SPSC no-split buffers", "[esp_ringbuf][linux]")
+{
+    RingbufHandle_t no_split_rb = xRingbufferCreate(BUFFER_SIZE, RINGBUF_TYPE_NOSPLIT);
+    RingbufHandle_t buffer_handle = xRingbufferCreate(BUFFER_SIZE, RINGBUF_TYPE_NOSPLIT_SPSC);
+    TEST_ASSERT_MESSAGE(no_split_rb && buffer_handle, "Failed to create ring buffers");
+    TEST_ASSERT_EQUAL(xRingbufferGetMaxItemSize(no_split_rb) - 4, xRingbufferGetMaxItemSize(buffer_handle));
+    vRingbufferDelete(no_split_rb);
+
+    //Fill the buffer
+    for (int i = 0; i < MAX_NUM_ITEMS - 1; i++) {
+        send_item_and_check(buffer_handle, large_item, MEDIUM_ITEM_SIZE, 0, false);
+    }
+    send_item_and_check_failure(buffer_handle, large_item, MEDIUM_ITEM_SIZE, 0, false);
+    TEST_ASSERT_LESS_THAN(MEDIUM_ITEM_SIZE, xRingbufferGetCurFreeSize(buffer_handle));
+
+    //Return the items out of order. Space is only freed when the first item is returned.
+    void *items[MAX_NUM_ITEMS - 1];
+    size_t item_size;
+    for (int i = 0; i < MAX_NUM_ITEMS - 1; i++) {
+        items[i] = xRingbufferReceive(buffer_handle, &item_size, 0);
+        TEST_ASSERT_MESSAGE(items[i] != NULL && item_size == MEDIUM_ITEM_SIZE, "Failed to receive item");
+    }
+    TEST_ASSERT_NULL(xRingbufferReceive(buffer_handle, &item_size, 0));
+    for (int i = MAX_NUM_ITEMS - 2; i > 0; i--) {
+        vRingbufferReturnItem(buffer_handle, items[i]);
+        send_item_and_check_failure(buffer_handle, large_item, MEDIUM_ITEM_SIZE, 0, false);
+    }
+    vRingbufferReturnItem(buffer_handle, items[0]);
+
+    //Send and receive items so that the buffer wraps around several times
+    for (int i = 0; i < 4 * MAX_NUM_ITEMS; i++) {
+        send_item_and_check(buffer_handle, small_item, SMALL_ITEM_SIZE, 0, false);
+        send_item_and_check(buffer_handle, large_item, MEDIUM_ITEM_SIZE, 0, false);
+        receive_check_and_return_item_no_split(buffer_handle, small_item, SMALL_ITEM_SIZE, 0, false);
+        receive_check_and_return_item_no_split(buffer_handle, large_item, MEDIUM_ITEM_SIZE, 0, false);
+    }
+    UBaseType_t items_waiting;
+    vRingbufferGetInfo(buffer_handle, NULL, NULL, NULL, NULL, &items_waiting);
+    TEST_ASSERT_MESSAGE(items_waiting == 0, "Incorrect items waiting");
+
+    //Wake up a task blocked on receive, then fill the buffer and wake up the same task blocked on send
+    done_sem = xSemaphoreCreateBinary();
+    TaskHandle_t task_handle;
+    xTaskCreatePinnedToCore(spsc_blocked_task, "spsc tsk", 2048, (void *)buffer_handle, 10, &task_handle, 0);
+    vTaskDelay(TIMEOUT_TICKS);
+    send_item_and_check(buffer_handle, small_item, SMALL_ITEM_SIZE, 0, false);
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done_sem, TIMEOUT_TICKS));
+    for (int i = 0; i < MAX_NUM_ITEMS - 1; i++) {
+        send_item_and_check(buffer_handle, large_item, MEDIUM_ITEM_SIZE, 0, false);
+    }
+    xTaskNotifyGive(task_handle);
+    vTaskDelay(TIMEOUT_TICKS);
+    TEST_ASSERT_EQUAL(pdFALSE, xSemaphoreTake(done_sem, 0));
+    receive_check_and_return_item_no_split(buffer_handle, large_item, MEDIUM_ITEM_SIZE, 0, false);
+    TEST_ASSERT_EQUAL(pdTRUE, xSemaphoreTake(done_sem, TIMEOUT_TICKS));
+    vRingbufferGetInfo(buffer_handle, NULL, NULL, NULL, NULL, &items_waiting);
+    TEST_ASSERT_MESSAGE(items_waiting == MAX_NUM_ITEMS - 1, "Incorrect items waiting");
+
+    //Cleanup
+    vSemaphoreDelete(done_sem);
+    vRingbufferDelete(buffer_handle);
+    vTaskDelay(1);
+}
+
+/* ------------------------- Test receiving multiple items -------------------------
+ * The following test case tests xRingbufferReceiveMultiple() and vRingbufferReturnItems() on each type of no-split
+ * ring buffer. The test case will do the following...
+ * 1) Check that nothing is received from an empty buffer, with and without a timeout.
+ * 2) Send items, then receive them in batches limited by the maximum number of items.
+ * 3) Return all items at once and check that the whole buffer is free again.
+ * 4) Repeat the above so that the buffer wraps around.
+ */
+
+TEST_CASE("Test no-split buffers receive multiple items", "[esp_ringbuf][linux]")
+{
+    const RingbufferType_t buf_types[] = {RINGBUF_TYPE_NOSPLIT, RINGBUF_TYPE_NOSPLIT_SPSC};
+    for (int type = 0; type < sizeof(buf_types) / sizeof(buf_types[0]); type++) {
+        RingbufHandle_t buffer_handle = xRingbufferCreate(BUFFER_SIZE, buf_types[type]);
+        TEST_ASSERT_MESSAGE(buffer_handle != NULL, "Failed to create ring buffer");
+        const size_t max_free_size = xRingbufferGetCurFreeSize(buffer_handle);
+
+        void *items[4];
+        size_t item_sizes[4];
+        TEST_ASSERT_EQUAL(0, xRingbufferReceiveMultiple(buffer_handle, items, item_sizes, 4, 0));
+        TEST_ASSERT_EQUAL(0, xRingbufferReceiveMultiple(buffer_handle, items, item_sizes, 4, TIMEOUT_TICKS));
+
+        for (int iter = 0; iter < 4; iter++) {
+            //Send three items, then receive them in a batch of two and a batch of one
+            send_item_and_check(buffer_handle, small_item, SMALL_ITEM_SIZE, 0, false);
+            send_item_and_check(buffer_handle, large_item, LARGE_ITEM_SIZE, 0, false);
+            send_item_and_check(buffer_handle, small_item, 0, 0, false);
+            TEST_ASSERT_EQUAL(0, xRingbufferReceiveMultiple(buffer_handle, items, item_sizes, 0, 0));
+            TEST_ASSERT_EQUAL(2, xRingbufferReceiveMultiple(buffer_handle, items, item_sizes, 2, 0));
+            TEST_ASSERT_EQUAL(1, xRingbufferReceiveMultiple(buffer_handle, &items[2], &item_sizes[2], 2, TIMEOUT_TICKS));
+            TEST_ASSERT_EQUAL(0, xRingbufferReceiveMultiple(buffer_handle, &items[3], &item_sizes[3], 1, 0));
+
+            //Check the received items
+            TEST_ASSERT_EQUAL(SMALL_ITEM_SIZE, item_sizes[0]);
+            TEST_ASSERT_EQUAL_MEMORY(small_item, items[0], SMALL_ITEM_SIZE);
+            TEST_ASSERT_EQUAL(LARGE_ITEM_SIZE, item_sizes[1]);
+            TEST_ASSERT_EQUAL_MEMORY(large_item, items[1], LARGE_ITEM_SIZE);
+            TEST_ASSERT_EQUAL(0, item_sizes[2]);
+
+            //Return the items at once
+            vRingbufferReturnItems(buffer_handle, items, 3);
+            UBaseType_t items_waiting;
+            vRingbufferGetInfo(buffer_handle, NULL, NULL, NULL, NULL, &items_waiting);
+            TEST_ASSERT_MESSAGE(items_waiting == 0, "Incorrect items waiting");
+            TEST_ASSERT_EQUAL(max_free_size, xRingbufferGetCurFreeSize(buffer_handle));
+        }
+        vRingbufferDelete(buffer_handle);
+    }
+}
+
+/* ------------------------- Test sending items made of fragments -------------------------
+ * The following test case tests xRingbufferSendv() on each type of ring buffer. The test case will do the following...
+ * 1) Send an item made of several fragments, including an empty one.
+ * 2) Receive the item (in several parts for allow-split and byte buffers) and check that it is the concatenation of
+ *    the fragments.
+ * 3) Repeat the above so that the item wraps around (and is split) at different offsets.
+ * 4) Check that an item larger than the maximum item size is rejected.
+ */
+
+static void receive_fragmented_item(RingbufHandle_t handle, RingbufferType_t buf_type, uint8_t *dest, size_t item_size)
+{
+    size_t received = 0;
+    while (received < item_size) {
+        size_t size1 = 0, size2 = 0;
+        void *item1 = NULL, *item2 = NULL;
+        if (buf_type == RINGBUF_TYPE_ALLOWSPLIT) {
+            TEST_ASSERT_EQUAL(pdTRUE, xRingbufferReceiveSplit(handle, &item1, &item2, &size1, &size2, 0));
+        } else if (buf_type == RINGBUF_TYPE_BYTEBUF) {
+            item1 = xRingbufferReceiveUpTo(handle, &size1, 0, item_size - received);
+        } else {
+            item1 = xRingbufferReceive(handle, &size1, 0);
+        }
+        TEST_ASSERT_MESSAGE(item1 != NULL, "Failed to receive item");
+        TEST_ASSERT_LESS_THAN(item_size - received + 1, size1 + size2);
+        memcpy(dest + received, item1, size1);
+        vRingbufferReturnItem(handle, item1);
+        if (item2 != NULL) {
+            memcpy(dest + received + size1, item2, size2);
+            vRingbufferReturnItem(handle, item2);
+        }
+        received += size1 + size2;
+    }
+}
+
+TEST_CASE("Test ring buffer send with fragments", "[esp_ringbuf][linux]")
+{
+    static const uint8_t header[] = {0xA0, 0xA1, 0xA2};
+    const RingbufferFragment_t fragments[] = {
+        { .pvData = header, .xSize = sizeof(header) },
+        { .pvData = NULL, .xSize = 0 },
+        { .pvData = large_item, .xSize = LARGE_ITEM_SIZE },
+        { .pvData = small_item, .xSize = 5 },
+    };
+    const size_t fragment_count = sizeof(fragments) / sizeof(fragments[0]);
+    uint8_t expected[sizeof(header) + LARGE_ITEM_SIZE + 5];
+    memcpy(expected, header, sizeof(header));
+    memcpy(expected + sizeof(header), large_item, LARGE_ITEM_SIZE);
+    memcpy(expected + sizeof(header) + LARGE_ITEM_SIZE, small_item, 5);
+
+    for (int buf_type = 0; buf_type < RINGBUF_TYPE_MAX; buf_type++) {
+        RingbufHandle_t buffer_handle = xRingbufferCreate(BUFFER_SIZE, buf_type);
+        TEST_ASSERT_MESSAGE(buffer_handle != NULL, "Failed to create ring buffer");
+
+        for (int iter = 0; iter < 8; iter++) {
+            uint8_t received[sizeof(expected)];
+            TEST_ASSERT_EQUAL(pdTRUE, xRingbufferSendv(buffer_handle, fragments, fragment_count, 0));
+            receive_fragmented_item(buffer_handle, buf_type, received, sizeof(expected));
+            TEST_ASSERT_EQUAL_MEMORY(expected, received, sizeof(expected));
+        }
+        UBaseType_t items_waiting;
+        vRingbufferGetInfo(buffer_handle, NULL, NULL, NULL, NULL, &items_waiting);
+        TEST_ASSERT_MESSAGE(items_waiting == 0, "Incorrect items waiting");
+
+        //The fragments are not accessed if the item can never fit
+        const RingbufferFragment_t too_large[] = {
+            { .pvData = small_item, .xSize = xRingbufferGetMaxItemSize(buffer_handle) },
+            { .pvData = small_item, .xSize = 1 },
+        };
+        TEST_ASSERT_EQUAL(pdFALSE, xRingbufferSendv(buffer_handle, too_large, 2, 0));
+        //Sizes whose sum wraps around to a size which fits
+        const RingbufferFragment_t wrapping[] = {
+            { .pvData = small_item, .xSize = SIZE_MAX },
+            { .pvData = small_item, .xSize = 2 },
+        };
+        TEST_ASSERT_EQUAL(pdFALSE, xRingbufferSendv(buffer_handle, wrapping, 2, 0));
+        vRingbufferDelete(buffer_handle);
+    }
+}
+
+/* ------------------------- Test ring buffer throughput -------------------------
+ * The following test case compares the throughput of no-split and SPSC no-split ring buffers for several item sizes.
+ * Items are sent until the buffer is full, then received and returned by the same task, so that the measured time is
+ * spent in the ring buffer functions rather than in context switches. The results are only printed.
+ */
+
+#define THROUGHPUT_BUFFER_SIZE          1024
+#define THROUGHPUT_TEST_TICKS           pdMS_TO_TICKS(200)
+
+static uint32_t measure_throughput(RingbufferType_t buf_type, size_t item_size)
+{
+    static uint8_t item[256];
+    RingbufHandle_t buffer_handle = xRingbufferCreate(THROUGHPUT_BUFFER_SIZE, buf_type);
+    TEST_ASSERT_MESSAGE(buffer_handle != NULL, "Failed to create ring buffer");
+
+    uint32_t items_done = 0;
+    TickType_t start = xTaskGetTickCount();
+    TickType_t elapsed;
+    do {
+        int items_sent = 0;
+        while (xRingbufferSend(buffer_handle, item, item_size, 0) == pdTRUE) {
+            items_sent++;
+        }
+        for (int i = 0; i < items_sent; i++) {
+            size_t rec_size;
+            void *rec_item = xRingbufferReceive(buffer_handle, &rec_size, 0);
+            TEST_ASSERT_MESSAGE(rec_item != NULL && rec_size == item_size, "Failed to receive item");
+            vRingbufferReturnItem(buffer_handle, rec_item);
+        }
+        items_done += items_sent;
+        elapsed = xTaskGetTickCount() - start;
+    } while (elapsed < THROUGHPUT_TEST_TICKS);
+
+    vRingbufferDelete(buffer_handle);
+    return (uint32_t)(((uint64_t)items_done * configTICK_RATE_HZ) / elapsed);
+}
+
+TEST_CASE("Test ring buffer throughput", "[esp_ringbuf][linux]")
+{
+    const size_t item_sizes[] = {4, 16, 64, 256};
+    for (int i = 0; i < sizeof(item_sizes) / sizeof(item_sizes[0]); i++) {
+        uint32_t no_split = measure_throughput(RINGBUF_TYPE_NOSPLIT, item_sizes[i]);
+        uint32_t spsc = measure_throughput(RINGBUF_TYPE_NOSPLIT_SPSC, item_sizes[i]);
+        printf("Item size %3d: no-split %8"PRIu32" items/s, SPSC %8"PRIu32" items/s\n", (int)item_sizes[i], no_split, spsc);
+    }
+}
@@ -13,6 +13,9 @@
 #include "esp_check.h"
 #include "esp_system.h"
 #include "esp_private/log_util.h"
+#if CONFIG_LOG_ASYNC
+#include "esp_private/log_async.h"
+#endif
 #include "esp_log.h"
 #include "esp_private/cache_utils.h"
 #include "spi_flash_mmap.h"
@@ -174,6 +177,13 @@ ESP_SYSTEM_INIT_FN(init_bootloader_offset, SECONDARY, BIT(0), 205)
 }
 #endif // SOC_RECOVERY_BOOTLOADER_SUPPORTED
 
+#if CONFIG_LOG_ASYNC
+ESP_SYSTEM_INIT_FN(init_log_async, SECONDARY, BIT(0), 206)
+{
+    return esp_log_async_init();
+}
+#endif // CONFIG_LOG_ASYNC
+
 #ifndef CONFIG_BOOTLOADER_WDT_DISABLE_IN_USER_CODE
 ESP_SYSTEM_INIT_FN(init_disable_rtc_wdt, SECONDARY, BIT(0), 999)
 {
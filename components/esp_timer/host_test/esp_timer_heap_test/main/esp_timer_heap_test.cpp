@@ -0,0 +1,239 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <cstdio>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <set>
+#include <vector>
+#include <sys/queue.h>
+#include "esp_timer_heap.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std;
+
+namespace {
+
+struct TestHeap {
+    TestHeap(size_t n) : timers(n), storage(n)
+    {
+        heap.timers = storage.data();
+        heap.capacity = n;
+        heap.count = 0;
+        heap.reserved = n;
+    }
+
+    void check()
+    {
+        for (uint32_t i = 0; i < heap.count; i++) {
+            REQUIRE(heap.timers[i]->heap_index == i);
+            if (i > 0) {
+                REQUIRE(heap.timers[(i - 1) / 2]->alarm <= heap.timers[i]->alarm);
+            }
+        }
+    }
+
+    vector<struct esp_timer> timers;
+    vector<esp_timer_handle_t> storage;
+    esp_timer_heap_t heap;
+};
+
+/* Sorted list insertion, as done in esp_timer.c when CONFIG_ESP_TIMER_QUEUE_LIST is enabled,
+ * used as a baseline in the benchmark.
+ */
+struct list_timer {
+    uint64_t alarm;
+    LIST_ENTRY(list_timer) list_entry;
+};
+LIST_HEAD(list_timer_head, list_timer);
+
+void list_insert(list_timer_head *head, list_timer *timer)
+{
+    list_timer *it, *last = NULL;
+    if (LIST_FIRST(head) == NULL) {
+        LIST_INSERT_HEAD(head, timer, list_entry);
+        return;
+    }
+    LIST_FOREACH(it, head, list_entry) {
+        if (timer->alarm < it->alarm) {
+            LIST_INSERT_BEFORE(it, timer, list_entry);
+            return;
+        }
+        last = it;
+    }
+    LIST_INSERT_AFTER(last, timer, list_entry);
+}
+
+using bench_clock = chrono::steady_clock;
+
+double ns_per_op(bench_clock::time_point start, size_t ops)
+{
+    return (double) chrono::duration_cast<chrono::nanoseconds>(bench_clock::now() - start).count() / ops;
+}
+
+} // namespace
+
+TEST_CASE("first timer of an empty heap is NULL")
+{
+    TestHeap t(4);
+    CHECK(esp_timer_heap_first(&t.heap) == nullptr);
+}
+
+TEST_CASE("timers expire in alarm order")
+{
+    const uint64_t alarms[] = { 50, 10, 40, 10, 30, 20, 60, 5 };
+    const size_t n = sizeof(alarms) / sizeof(alarms[0]);
+    TestHeap t(n);
+    for (size_t i = 0; i < n; i++) {
+        t.timers[i].alarm = alarms[i];
+        esp_timer_heap_insert(&t.heap, &t.timers[i]);
+        t.check();
+    }
+    uint64_t last = 0;
+    for (size_t i = 0; i < n; i++) {
+        esp_timer_handle_t first = esp_timer_heap_first(&t.heap);
+        REQUIRE(first != nullptr);
+        CHECK(first->alarm >= last);
+        last = first->alarm;
+        esp_timer_heap_remove(&t.heap, first);
+        t.check();
+    }
+    CHECK(esp_timer_heap_first(&t.heap) == nullptr);
+}
+
+TEST_CASE("random insert, remove and update keep the heap consistent")
+{
+    const size_t n = 200;
+    TestHeap t(n);
+    vector<bool> armed(n);
+    multiset<uint64_t> reference;
+    mt19937 rng(42);
+
+    for (int step = 0; step < 20000; step++) {
+        size_t i = rng() % n;
+        esp_timer_handle_t timer = &t.timers[i];
+        if (!armed[i]) {
+            timer->alarm = 1 + rng() % 1000;
+            esp_timer_heap_insert(&t.heap, timer);
+            reference.insert(timer->alarm);
+            armed[i] = true;
+        } else if (rng() % 2) {
+            reference.erase(reference.find(timer->alarm));
+            esp_timer_heap_remove(&t.heap, timer);
+            armed[i] = false;
+        } else {
+            // reschedule, in both directions
+            reference.erase(reference.find(timer->alarm));
+            timer->alarm = 1 + rng() % 1000;
+            reference.insert(timer->alarm);
+            esp_timer_heap_update(&t.heap, timer);
+        }
+        REQUIRE(t.heap.count == reference.size());
+        if (!reference.empty()) {
+            REQUIRE(esp_timer_heap_first(&t.heap)->alarm == *reference.begin());
+        }
+        if (step % 100 == 0) {
+            t.check();
+        }
+    }
+    t.check();
+}
+
+TEST_CASE("earliest end of the slack windows is found")
+{
+    const size_t n = 100;
+    TestHeap t(n);
+    mt19937 rng(7);
+    CHECK(esp_timer_heap_min_deadline(&t.heap) == UINT64_MAX);
+    for (size_t i = 0; i < n; i++) {
+        t.timers[i].alarm = 1000 + rng() % 1000;
+        t.timers[i].slack = (rng() % 4 == 0) ? 0 : rng() % 2000;
+        esp_timer_heap_insert(&t.heap, &t.timers[i]);
+        uint64_t expected = UINT64_MAX;
+        for (size_t j = 0; j <= i; j++) {
+            expected = min(expected, t.timers[j].alarm + t.timers[j].slack);
+        }
+        REQUIRE(esp_timer_heap_min_deadline(&t.heap) == expected);
+    }
+}
+
+TEST_CASE("armed timers are kept when the storage is replaced")
+{
+    TestHeap t(16);
+    vector<esp_timer_handle_t> small(4);
+    t.heap.timers = small.data();
+    t.heap.capacity = small.size();
+    for (size_t i = 0; i < 4; i++) {
+        t.timers[i].alarm = 100 - i;
+        esp_timer_heap_insert(&t.heap, &t.timers[i]);
+    }
+    vector<esp_timer_handle_t> large(16);
+    CHECK(esp_timer_heap_set_storage(&t.heap, large.data(), large.size()) == small.data());
+    CHECK(t.heap.capacity == 16);
+    for (size_t i = 4; i < 16; i++) {
+        t.timers[i].alarm = 1000 + i;
+        esp_timer_heap_insert(&t.heap, &t.timers[i]);
+    }
+    t.check();
+    CHECK(esp_timer_heap_first(&t.heap) == &t.timers[3]);
+}
+
+TEST_CASE("benchmark: arm, disarm and expire cost against the number of armed timers")
+{
+    const size_t counts[] = { 10, 100, 300, 1000, 3000 };
+    const int rounds = 20;
+    mt19937 rng(1);
+
+    printf("%-8s  %-16s  %-16s  %-16s  %-16s\n", "Timers", "List arm [ns]", "Heap arm [ns]", "Heap disarm [ns]", "Heap expire [ns]");
+    for (size_t n : counts) {
+        vector<uint64_t> alarms(n);
+        for (auto &alarm : alarms) {
+            alarm = 1 + rng() % (n * 1000);
+        }
+        double list_arm = 0, heap_arm = 0, heap_disarm = 0, heap_expire = 0;
+
+        for (int round = 0; round < rounds; round++) {
+            // baseline: arm the timers in a sorted list
+            vector<list_timer> list_timers(n);
+            list_timer_head head = LIST_HEAD_INITIALIZER(head);
+            auto start = bench_clock::now();
+            for (size_t i = 0; i < n; i++) {
+                list_timers[i].alarm = alarms[i];
+                list_insert(&head, &list_timers[i]);
+            }
+            list_arm += ns_per_op(start, n);
+
+            // arm the timers in the heap
+            TestHeap t(n);
+            start = bench_clock::now();
+            for (size_t i = 0; i < n; i++) {
+                t.timers[i].alarm = alarms[i];
+                esp_timer_heap_insert(&t.heap, &t.timers[i]);
+            }
+            heap_arm += ns_per_op(start, n);
+
+            // expire: every timer is periodic and gets rescheduled when it fires
+            start = bench_clock::now();
+            for (size_t i = 0; i < n; i++) {
+                esp_timer_handle_t first = esp_timer_heap_first(&t.heap);
+                first->alarm += n * 1000;
+                esp_timer_heap_update(&t.heap, first);
+            }
+            heap_expire += ns_per_op(start, n);
+
+            // disarm all the timers in creation order, i.e. from random positions of the heap
+            start = bench_clock::now();
+            for (size_t i = 0; i < n; i++) {
+                esp_timer_heap_remove(&t.heap, &t.timers[i]);
+            }
+            heap_disarm += ns_per_op(start, n);
+            REQUIRE(t.heap.count == 0);
+        }
+        printf("%-8zu  %-16.1f  %-16.1f  %-16.1f  %-16.1f\n", n,
+               list_arm / rounds, heap_arm / rounds, heap_disarm / rounds, heap_expire / rounds);
+    }
+}
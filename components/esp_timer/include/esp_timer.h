@@ -76,8 +76,27 @@ typedef struct {
     //                                !< `CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD`
     const char* name;               //!< Timer name, used in esp_timer_dump() function
     bool skip_unhandled_events;     //!< Setting to skip unhandled events in light sleep for periodic timers
+    uint32_t slack_us;              //!< Time by which the callback may be delayed after the timer expires, so that
+    //                                !< it can be dispatched together with other timers; 0 means no delay
 } esp_timer_create_args_t;
 
+/**
+ * @brief Number of buckets in the histograms returned by esp_timer_get_histogram()
+ */
+#define ESP_TIMER_HISTOGRAM_BUCKETS 16
+
+/**
+ * @brief Log-scale histograms of the dispatch latency and of the callback execution time of a timer
+ *
+ * Bucket 0 counts values below 1 microsecond. Bucket i (i > 0) counts values from 2^(i-1) to 2^i - 1
+ * microseconds, except for the last bucket, which also counts all larger values.
+ */
+typedef struct {
+    uint32_t latency[ESP_TIMER_HISTOGRAM_BUCKETS];     //!< Time from the alarm to the start of the callback, not
+                                                       //!< counting the slack of the timer
+    uint32_t run_time[ESP_TIMER_HISTOGRAM_BUCKETS];    //!< Time taken by the callback to execute
+} esp_timer_histogram_t;
+
 /**
  * @brief Minimal initialization of esp_timer
  *
@@ -292,6 +311,9 @@ esp_err_t esp_timer_get_expiry_time(esp_timer_handle_t timer, uint64_t *expiry);
  * - Times_skipped - number of times the callback was skipped
  * - Callback_exec_time - total time taken by callback to execute, across all calls
  *
+ * If Kconfig option `CONFIG_ESP_TIMER_HISTOGRAMS` is enabled, each timer is followed by two lines with
+ * the counts of its latency and callback execution time histograms (see esp_timer_histogram_t).
+ *
  * @param stream stream (such as stdout) to which to dump the information
  * @return
  *      - ESP_OK on success
@@ -321,6 +343,32 @@ void esp_timer_isr_dispatch_need_yield(void);
  */
 bool esp_timer_is_active(esp_timer_handle_t timer);
 
+/**
+ * @brief Get the dispatch latency and callback execution time histograms of a timer
+ *
+ * The histograms are recorded when Kconfig option `CONFIG_ESP_TIMER_HISTOGRAMS` is enabled.
+ * They accumulate from the creation of the timer or from the last call to esp_timer_reset_histogram().
+ *
+ * @param timer timer handle created using esp_timer_create()
+ * @param[out] histogram memory to store the histograms in
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the arguments are invalid
+ *      - ESP_ERR_NOT_SUPPORTED if `CONFIG_ESP_TIMER_HISTOGRAMS` is disabled
+ */
+esp_err_t esp_timer_get_histogram(esp_timer_handle_t timer, esp_timer_histogram_t *histogram);
+
+/**
+ * @brief Clear the histograms of a timer
+ *
+ * @param timer timer handle created using esp_timer_create()
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if the timer handle is NULL
+ *      - ESP_ERR_NOT_SUPPORTED if `CONFIG_ESP_TIMER_HISTOGRAMS` is disabled
+ */
+esp_err_t esp_timer_reset_histogram(esp_timer_handle_t timer);
+
 /**
  * @brief Get the ETM event handle of esp_timer underlying alarm event
  *
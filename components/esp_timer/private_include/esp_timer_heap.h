@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+/**
+ * @file private_include/esp_timer_heap.h
+ *
+ * @brief Binary min-heap of armed timers, ordered by alarm time.
+ *
+ * Used by esp_timer.c instead of the sorted list when CONFIG_ESP_TIMER_QUEUE_HEAP is enabled.
+ * Inserting, removing and rescheduling a timer takes O(log n) time, finding the earliest
+ * timer takes O(1) time. The heap does not allocate memory: the caller provides the storage
+ * and makes sure it is large enough before inserting. None of the functions are thread-safe,
+ * the caller is expected to hold the timer lock.
+ */
+
+#include <stdint.h>
+#include "esp_attr.h"
+#include "esp_timer_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    esp_timer_handle_t *timers;     //!< Armed timers; timers[0] has the earliest alarm
+    uint32_t count;                 //!< Number of armed timers
+    uint32_t capacity;              //!< Number of elements in the timers array
+    uint32_t reserved;              //!< Number of elements promised to created timers, count <= reserved <= capacity
+} esp_timer_heap_t;
+
+/**
+ * @brief Add a timer to the heap, using timer->alarm as the key
+ *
+ * @note heap->count must be less than heap->capacity
+ */
+void esp_timer_heap_insert(esp_timer_heap_t *heap, esp_timer_handle_t timer);
+
+/**
+ * @brief Remove a timer which is in the heap
+ */
+void esp_timer_heap_remove(esp_timer_heap_t *heap, esp_timer_handle_t timer);
+
+/**
+ * @brief Move a timer which is in the heap to the right position after its alarm has changed
+ */
+void esp_timer_heap_update(esp_timer_heap_t *heap, esp_timer_handle_t timer);
+
+/**
+ * @brief Get the earliest end of the slack window (alarm + slack) of the timers in the heap
+ *
+ * Only the timers whose window starts before the result are visited, without recursion or extra memory.
+ *
+ * @return Timestamp, or UINT64_MAX if the heap is empty
+ */
+uint64_t esp_timer_heap_min_deadline(const esp_timer_heap_t *heap);
+
+/**
+ * @brief Replace the storage of the heap with a larger one
+ *
+ * Armed timers are copied to the new array.
+ *
+ * @param heap      Heap
+ * @param timers    New array, must have room for at least heap->count elements
+ * @param capacity  Number of elements in the new array
+ * @return The previous array, which the caller may free once the timer lock is released
+ */
+esp_timer_handle_t *esp_timer_heap_set_storage(esp_timer_heap_t *heap, esp_timer_handle_t *timers, uint32_t capacity);
+
+/**
+ * @brief Get the timer with the earliest alarm
+ *
+ * @return Timer handle, or NULL if the heap is empty
+ */
+FORCE_INLINE_ATTR esp_timer_handle_t esp_timer_heap_first(const esp_timer_heap_t *heap)
+{
+    return (heap->count > 0) ? heap->timers[0] : NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,70 @@
+/*
+ * SPDX-FileCopyrightText: 2017-2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+/**
+ * @file private_include/esp_timer_types.h
+ *
+ * @brief Definition of the timer object, shared by esp_timer.c and the
+ * structures which keep track of armed timers (see esp_timer_heap.h).
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_ESP_TIMER_PROFILING
+#define WITH_PROFILING 1
+#endif
+
+#ifndef NDEBUG
+// Enable built-in checks in queue.h in debug builds
+#define INVARIANTS
+#endif
+#include "sys/queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FL_ISR_DISPATCH_METHOD   = (1 << 0),  //!< 0=Callback is called from timer task, 1=Callback is called from timer ISR
+    FL_SKIP_UNHANDLED_EVENTS = (1 << 1),  //!< 0=NOT skip unhandled events for periodic timers, 1=Skip unhandled events for periodic timers
+} flags_t;
+
+struct esp_timer {
+    uint64_t alarm;
+    uint64_t period: 56;
+    flags_t flags: 8;
+    union {
+        esp_timer_cb_t callback;
+        uint32_t event_id;
+    };
+    void* arg;
+    uint32_t slack;                     //!< The callback may be dispatched anywhere between alarm and alarm + slack
+#if WITH_PROFILING
+    const char* name;
+    size_t times_triggered;
+    size_t times_armed;
+    size_t times_skipped;
+    uint64_t total_callback_run_time;
+#endif // WITH_PROFILING
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+    esp_timer_histogram_t histogram;
+#endif // CONFIG_ESP_TIMER_HISTOGRAMS
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+    uint32_t heap_index;                //!< Position of the timer in the heap, valid only while armed
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
+#if !CONFIG_ESP_TIMER_QUEUE_HEAP || WITH_PROFILING
+    LIST_ENTRY(esp_timer) list_entry;   //!< Link in the list of armed timers, or in the list of inactive timers when profiling
+#endif
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -6,6 +6,7 @@
 
 #include <sys/param.h>
 #include <string.h>
+#include <inttypes.h>
 #include "soc/soc.h"
 #include "esp_types.h"
 #include "esp_attr.h"
@@ -17,52 +18,28 @@
 #include "freertos/semphr.h"
 #include "esp_timer.h"
 #include "esp_timer_impl.h"
+#include "esp_timer_types.h"
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+#include "esp_timer_heap.h"
+#endif
 #include "esp_compiler.h"
 #include "esp_private/startup_internal.h"
 #include "esp_private/esp_timer_private.h"
 #include "esp_private/system_internal.h"
 #include "sdkconfig.h"
 
-#ifdef CONFIG_ESP_TIMER_PROFILING
-#define WITH_PROFILING 1
-#endif
-
-#ifndef NDEBUG
-// Enable built-in checks in queue.h in debug builds
-#define INVARIANTS
-#endif
-#include "sys/queue.h"
-
 #define EVENT_ID_DELETE_TIMER   0xF0DE1E1E
 
-typedef enum {
-    FL_ISR_DISPATCH_METHOD   = (1 << 0),  //!< 0=Callback is called from timer task, 1=Callback is called from timer ISR
-    FL_SKIP_UNHANDLED_EVENTS = (1 << 1),  //!< 0=NOT skip unhandled events for periodic timers, 1=Skip unhandled events for periodic timers
-} flags_t;
-
-struct esp_timer {
-    uint64_t alarm;
-    uint64_t period: 56;
-    flags_t flags: 8;
-    union {
-        esp_timer_cb_t callback;
-        uint32_t event_id;
-    };
-    void* arg;
-#if WITH_PROFILING
-    const char* name;
-    size_t times_triggered;
-    size_t times_armed;
-    size_t times_skipped;
-    uint64_t total_callback_run_time;
-#endif // WITH_PROFILING
-    LIST_ENTRY(esp_timer) list_entry;
-};
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+// initial number of timers the heap storage is allocated for, doubled each time it gets full
+#define TIMER_HEAP_MIN_CAPACITY 8
+#endif
 
 static inline bool is_initialized(void);
 static esp_err_t timer_insert(esp_timer_handle_t timer, bool without_update_alarm);
 static esp_err_t timer_remove(esp_timer_handle_t timer);
 static bool timer_armed(esp_timer_handle_t timer);
+static uint64_t timer_queue_deadline(esp_timer_dispatch_t dispatch_method);
 static void timer_list_lock(esp_timer_dispatch_t timer_type);
 static void timer_list_unlock(esp_timer_dispatch_t timer_type);
 
@@ -70,13 +47,24 @@ static void timer_list_unlock(esp_timer_dispatch_t timer_type);
 static void timer_insert_inactive(esp_timer_handle_t timer);
 static void timer_remove_inactive(esp_timer_handle_t timer);
 #endif // WITH_PROFILING
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+static esp_err_t timer_heap_reserve(esp_timer_dispatch_t dispatch_method);
+static void timer_heap_release(esp_timer_dispatch_t dispatch_method);
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
 
 __attribute__((unused)) static const char* TAG = "esp_timer";
 
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+// heaps of currently armed timers for two dispatch methods: ISR and TASK
+static esp_timer_heap_t s_timers[ESP_TIMER_MAX];
+#define TIMER_QUEUE_FIRST(dispatch_method)  esp_timer_heap_first(&s_timers[dispatch_method])
+#else
 // lists of currently armed timers for two dispatch methods: ISR and TASK
 static LIST_HEAD(esp_timer_list, esp_timer) s_timers[ESP_TIMER_MAX] = {
     [0 ...(ESP_TIMER_MAX - 1)] = LIST_HEAD_INITIALIZER(s_timers)
 };
+#define TIMER_QUEUE_FIRST(dispatch_method)  LIST_FIRST(&s_timers[dispatch_method])
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
 #if WITH_PROFILING
 // lists of unarmed timers for two dispatch methods: ISR and TASK,
 // used only to be able to dump statistics about all the timers
@@ -87,11 +75,17 @@ static LIST_HEAD(esp_inactive_timer_list, esp_timer) s_inactive_timers[ESP_TIMER
 // task used to dispatch timer callbacks
 static TaskHandle_t s_timer_task;
 
-// lock protecting s_timers, s_inactive_timers
+// lock protecting s_timers, s_inactive_timers, s_running_timers
 static portMUX_TYPE s_timer_lock[ESP_TIMER_MAX] = {
     [0 ...(ESP_TIMER_MAX - 1)] = portMUX_INITIALIZER_UNLOCKED
 };
 
+#if WITH_PROFILING || CONFIG_ESP_TIMER_HISTOGRAMS
+// timers whose callback is being run for two dispatch methods: ISR and TASK, reset by esp_timer_delete()
+// so that the statistics of a timer deleted while its callback runs are not updated once it may be freed
+static esp_timer_handle_t s_running_timers[ESP_TIMER_MAX];
+#endif
+
 #ifdef CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
 // For ISR dispatch method, a callback function of the timer may require a context switch
 static volatile BaseType_t s_isr_dispatch_need_yield = pdFALSE;
@@ -113,11 +107,32 @@ esp_err_t esp_timer_create(const esp_timer_create_args_t* args,
     }
     result->callback = args->callback;
     result->arg = args->arg;
+    result->slack = args->slack_us;
     result->flags = (args->dispatch_method ? FL_ISR_DISPATCH_METHOD : 0) |
                     (args->skip_unhandled_events ? FL_SKIP_UNHANDLED_EVENTS : 0);
+#if CONFIG_ESP_TIMER_QUEUE_HEAP || WITH_PROFILING
+    esp_timer_dispatch_t dispatch_method = result->flags & FL_ISR_DISPATCH_METHOD;
+#endif
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+    /* Reserve room for the timer in the heaps now, as memory can't be allocated when the timer is armed.
+     * Every timer ends up in the TASK heap when it is deleted, ISR timers also need room in the ISR heap.
+     */
+    esp_err_t err = timer_heap_reserve(ESP_TIMER_TASK);
+    if (err == ESP_OK && dispatch_method != ESP_TIMER_TASK) {
+        err = timer_heap_reserve(dispatch_method);
+        if (err != ESP_OK) {
+            timer_list_lock(ESP_TIMER_TASK);
+            timer_heap_release(ESP_TIMER_TASK);
+            timer_list_unlock(ESP_TIMER_TASK);
+        }
+    }
+    if (err != ESP_OK) {
+        free(result);
+        return err;
+    }
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
 #if WITH_PROFILING
     result->name = args->name;
-    esp_timer_dispatch_t dispatch_method = result->flags & FL_ISR_DISPATCH_METHOD;
     timer_list_lock(dispatch_method);
     timer_insert_inactive(result);
     timer_list_unlock(dispatch_method);
@@ -270,6 +285,17 @@ esp_err_t esp_timer_delete(esp_timer_handle_t timer)
     }
 
     int64_t alarm = esp_timer_get_time();
+#if CONFIG_ESP_TIMER_QUEUE_HEAP || WITH_PROFILING || CONFIG_ESP_TIMER_HISTOGRAMS
+    esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
+#endif
+#if WITH_PROFILING || CONFIG_ESP_TIMER_HISTOGRAMS
+    // The timer may be freed by the timer task as soon as it is inserted into the TASK list below
+    timer_list_lock(dispatch_method);
+    if (s_running_timers[dispatch_method] == timer) {
+        s_running_timers[dispatch_method] = NULL;
+    }
+    timer_list_unlock(dispatch_method);
+#endif
     esp_err_t err;
     timer_list_lock(ESP_TIMER_TASK);
 
@@ -288,6 +314,14 @@ esp_err_t esp_timer_delete(esp_timer_handle_t timer)
         err = timer_insert(timer, false);
     }
     timer_list_unlock(ESP_TIMER_TASK);
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+    if (err == ESP_OK && dispatch_method != ESP_TIMER_TASK) {
+        // The timer will not be armed in the ISR heap anymore
+        timer_list_lock(dispatch_method);
+        timer_heap_release(dispatch_method);
+        timer_list_unlock(dispatch_method);
+    }
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
     return err;
 }
 
@@ -296,8 +330,11 @@ static ESP_TIMER_IRAM_ATTR esp_err_t timer_insert(esp_timer_handle_t timer, bool
 #if WITH_PROFILING
     timer_remove_inactive(timer);
 #endif
-    esp_timer_handle_t it, last = NULL;
     esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+    esp_timer_heap_insert(&s_timers[dispatch_method], timer);
+#else
+    esp_timer_handle_t it, last = NULL;
     if (LIST_FIRST(&s_timers[dispatch_method]) == NULL) {
         LIST_INSERT_HEAD(&s_timers[dispatch_method], timer, list_entry);
     } else {
@@ -313,8 +350,12 @@ static ESP_TIMER_IRAM_ATTR esp_err_t timer_insert(esp_timer_handle_t timer, bool
             LIST_INSERT_AFTER(last, timer, list_entry);
         }
     }
-    if (without_update_alarm == false && timer == LIST_FIRST(&s_timers[dispatch_method])) {
-        esp_timer_impl_set_alarm_id(timer->alarm, dispatch_method);
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
+    if (without_update_alarm == false) {
+        uint64_t deadline = timer_queue_deadline(dispatch_method);
+        if (timer->alarm <= deadline) { // if this timer belongs to the earliest batch, the alarm may have to fire earlier.
+            esp_timer_impl_set_alarm_id(deadline, dispatch_method);
+        }
     }
     return ESP_OK;
 }
@@ -323,18 +364,17 @@ static ESP_TIMER_IRAM_ATTR esp_err_t timer_remove(esp_timer_handle_t timer)
 {
     esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
     timer_list_lock(dispatch_method);
-    esp_timer_handle_t first_timer = LIST_FIRST(&s_timers[dispatch_method]);
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+    esp_timer_heap_remove(&s_timers[dispatch_method], timer);
+#else
     LIST_REMOVE(timer, list_entry);
+#endif
+    uint64_t deadline = timer_queue_deadline(dispatch_method); // UINT64_MAX if no timers are left
+    if (timer->alarm <= deadline) { // if this timer belonged to the earliest batch, the alarm may fire later now.
+        esp_timer_impl_set_alarm_id(deadline, dispatch_method);
+    }
     timer->alarm = 0;
     timer->period = 0;
-    if (timer == first_timer) { // if this timer was the first in the list.
-        uint64_t next_timestamp = UINT64_MAX;
-        first_timer = LIST_FIRST(&s_timers[dispatch_method]);
-        if (first_timer) { // if after removing the timer from the list, this list is not empty.
-            next_timestamp = first_timer->alarm;
-        }
-        esp_timer_impl_set_alarm_id(next_timestamp, dispatch_method);
-    }
 #if WITH_PROFILING
     timer_insert_inactive(timer);
 #endif
@@ -368,6 +408,98 @@ static ESP_TIMER_IRAM_ATTR void timer_remove_inactive(esp_timer_handle_t timer)
 
 #endif // WITH_PROFILING
 
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+
+static esp_err_t timer_heap_reserve(esp_timer_dispatch_t dispatch_method)
+{
+    /* Memory can't be allocated while holding the lock, so when the heap is full a larger
+     * storage is allocated first, then swapped in if nobody else has grown the heap meanwhile.
+     */
+    esp_timer_heap_t* heap = &s_timers[dispatch_method];
+    esp_timer_handle_t* new_timers = NULL;
+    uint32_t new_capacity = 0;
+    while (true) {
+        esp_timer_handle_t* unused_timers = NULL;
+        bool reserved = true;
+        timer_list_lock(dispatch_method);
+        if (heap->reserved < heap->capacity) {
+            unused_timers = new_timers;
+        } else if (new_capacity > heap->capacity) {
+            unused_timers = esp_timer_heap_set_storage(heap, new_timers, new_capacity);
+        } else {
+            reserved = false;
+            unused_timers = new_timers;
+            new_capacity = MAX(heap->capacity * 2, TIMER_HEAP_MIN_CAPACITY);
+        }
+        if (reserved) {
+            heap->reserved++;
+        }
+        timer_list_unlock(dispatch_method);
+        free(unused_timers);
+        if (reserved) {
+            return ESP_OK;
+        }
+        new_timers = heap_caps_malloc(new_capacity * sizeof(esp_timer_handle_t), MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+        if (new_timers == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+}
+
+static void timer_heap_release(esp_timer_dispatch_t dispatch_method)
+{
+    /* Called with the lock held. The storage is never shrunk, as timers are usually re-created. */
+    assert(s_timers[dispatch_method].reserved > 0);
+    s_timers[dispatch_method].reserved--;
+}
+
+static int timer_alarm_cmp(const void* a, const void* b)
+{
+    const uint64_t alarm_a = (*(const esp_timer_handle_t*) a)->alarm;
+    const uint64_t alarm_b = (*(const esp_timer_handle_t*) b)->alarm;
+    return (alarm_a > alarm_b) - (alarm_a < alarm_b);
+}
+
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
+
+/*
+ * Timers may be dispatched anywhere between their alarm and the end of their slack window, so the
+ * alarm is set to the earliest end of window among the armed timers. When it fires, all the timers
+ * whose window has started by then are processed together. Only the timers whose window starts
+ * before the result need to be checked, which is just the first timer if none of them has slack.
+ */
+static ESP_TIMER_IRAM_ATTR uint64_t timer_queue_deadline(esp_timer_dispatch_t dispatch_method)
+{
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+    return esp_timer_heap_min_deadline(&s_timers[dispatch_method]);
+#else
+    uint64_t deadline = UINT64_MAX;
+    esp_timer_handle_t it;
+    LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
+        if (it->alarm > deadline) {
+            break;
+        }
+        deadline = MIN(deadline, it->alarm + it->slack);
+    }
+    return deadline;
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
+}
+
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+
+static ESP_TIMER_IRAM_ATTR void timer_histogram_add(uint32_t* buckets, uint64_t value_us)
+{
+    // bucket i counts the values which are i bits long
+    unsigned bucket = 0;
+    while (value_us > 0 && bucket < ESP_TIMER_HISTOGRAM_BUCKETS - 1) {
+        value_us >>= 1;
+        ++bucket;
+    }
+    ++buckets[bucket];
+}
+
+#endif // CONFIG_ESP_TIMER_HISTOGRAMS
+
 static ESP_TIMER_IRAM_ATTR bool timer_armed(esp_timer_handle_t timer)
 {
     return timer->alarm > 0;
@@ -393,7 +525,7 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
     bool processed = false;
     esp_timer_handle_t it;
     while (1) {
-        it = LIST_FIRST(&s_timers[dispatch_method]);
+        it = TIMER_QUEUE_FIRST(dispatch_method);
         int64_t now = esp_timer_impl_get_time();
         ESP_COMPILER_DIAGNOSTIC_PUSH_IGNORE("-Wanalyzer-use-after-free") // False-positive detection. TODO GCC-366
         if (it == NULL || it->alarm > now) {
@@ -401,14 +533,28 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
         }
         ESP_COMPILER_DIAGNOSTIC_POP("-Wanalyzer-use-after-free")
         processed = true;
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+        // A periodic timer stays in the heap and is moved to its next position below
+        if (it->event_id == EVENT_ID_DELETE_TIMER || it->period == 0) {
+            esp_timer_heap_remove(&s_timers[dispatch_method], it);
+        }
+#else
         LIST_REMOVE(it, list_entry);
+#endif
         if (it->event_id == EVENT_ID_DELETE_TIMER) {
             // It is handled only by ESP_TIMER_TASK (see esp_timer_delete()).
             // All the ESP_TIMER_ISR timers which should be deleted are moved by esp_timer_delete() to the ESP_TIMER_TASK list.
             // We want to free memory of the timer in a task context instead of an isr context.
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+            timer_heap_release(ESP_TIMER_TASK);
+#endif
             free(it);
             it = NULL;
         } else {
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+            // the slack is a delay the timer allows, only the time past the end of the slack window counts
+            timer_histogram_add(it->histogram.latency, (now > it->alarm + it->slack) ? now - (it->alarm + it->slack) : 0);
+#endif
             if (it->period > 0) {
                 int skipped = (now - it->alarm) / it->period;
                 if ((it->flags & FL_SKIP_UNHANDLED_EVENTS) && (skipped > 1)) {
@@ -419,30 +565,45 @@ static bool timer_process_alarm(esp_timer_dispatch_t dispatch_method)
                 } else {
                     it->alarm += it->period;
                 }
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+                esp_timer_heap_update(&s_timers[dispatch_method], it);
+#else
                 timer_insert(it, true);
+#endif
             } else {
                 it->alarm = 0;
 #if WITH_PROFILING
                 timer_insert_inactive(it);
 #endif
             }
-#if WITH_PROFILING
+#if WITH_PROFILING || CONFIG_ESP_TIMER_HISTOGRAMS
             uint64_t callback_start = now;
+            s_running_timers[dispatch_method] = it;
 #endif
             esp_timer_cb_t callback = it->callback;
             void* arg = it->arg;
             timer_list_unlock(dispatch_method);
             (*callback)(arg);
             timer_list_lock(dispatch_method);
+#if WITH_PROFILING || CONFIG_ESP_TIMER_HISTOGRAMS
+            // Skipped if the timer was deleted meanwhile, by the callback or by another task
+            if (s_running_timers[dispatch_method] == it) {
+                uint64_t callback_run_time = esp_timer_impl_get_time() - callback_start;
 #if WITH_PROFILING
-            it->times_triggered++;
-            it->total_callback_run_time += esp_timer_impl_get_time() - callback_start;
+                it->times_triggered++;
+                it->total_callback_run_time += callback_run_time;
+#endif
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+                timer_histogram_add(it->histogram.run_time, callback_run_time);
+#endif
+            }
+            s_running_timers[dispatch_method] = NULL;
 #endif
         }
     } // while(1)
     if (it) {
         if (dispatch_method == ESP_TIMER_TASK || (dispatch_method != ESP_TIMER_TASK && processed == true)) {
-            esp_timer_impl_set_alarm_id(it->alarm, dispatch_method);
+            esp_timer_impl_set_alarm_id(timer_queue_deadline(dispatch_method), dispatch_method);
         }
     } else {
         if (processed) {
@@ -575,7 +736,7 @@ esp_err_t esp_timer_deinit(void)
 
     /* Check if there are any active timers */
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
-        if (!LIST_EMPTY(&s_timers[dispatch_method])) {
+        if (TIMER_QUEUE_FIRST(dispatch_method) != NULL) {
             return ESP_ERR_INVALID_STATE;
         }
     }
@@ -596,6 +757,17 @@ esp_err_t esp_timer_deinit(void)
     return ESP_OK;
 }
 
+/* snprintf returns the length the output would have had without truncation. The position in the buffer is kept on
+ * the terminating null character, so that the remaining size can't wrap around once the buffer is full.
+ */
+static size_t timer_info_clamp(size_t cb, size_t dst_size)
+{
+    if (cb < dst_size) {
+        return cb;
+    }
+    return (dst_size > 0) ? dst_size - 1 : 0;
+}
+
 static void print_timer_info(esp_timer_handle_t t, char** dst, size_t* dst_size)
 {
 #if WITH_PROFILING
@@ -606,15 +778,33 @@ static void print_timer_info(esp_timer_handle_t t, char** dst, size_t* dst_size)
     } else {
         cb = snprintf(*dst, *dst_size, "timer@%-10p  ", t);
     }
+    cb = timer_info_clamp(cb, *dst_size);
 
     cb += snprintf(*dst + cb, *dst_size - cb, "%-10lld  %-12lld  %-12d  %-12d  %-12d  %-12lld\n",
                    (uint64_t)t->period, t->alarm, t->times_armed,
                    t->times_triggered, t->times_skipped, t->total_callback_run_time);
+    cb = timer_info_clamp(cb, *dst_size);
     /* keep this in sync with the format string, used in esp_timer_dump */
 #define TIMER_INFO_LINE_LEN 103
 #else
     size_t cb = snprintf(*dst, *dst_size, "timer@%-14p  %-10lld  %-12lld\n", t, (uint64_t)t->period, t->alarm);
+    cb = timer_info_clamp(cb, *dst_size);
 #define TIMER_INFO_LINE_LEN 47
+#endif
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+    const char* labels[] = { "  latency: ", "  run time:" };
+    const uint32_t* histograms[] = { t->histogram.latency, t->histogram.run_time };
+    for (size_t i = 0; i < 2; ++i) {
+        cb = timer_info_clamp(cb + snprintf(*dst + cb, *dst_size - cb, "%s", labels[i]), *dst_size);
+        for (size_t bucket = 0; bucket < ESP_TIMER_HISTOGRAM_BUCKETS; ++bucket) {
+            cb = timer_info_clamp(cb + snprintf(*dst + cb, *dst_size - cb, " %" PRIu32, histograms[i][bucket]), *dst_size);
+        }
+        cb = timer_info_clamp(cb + snprintf(*dst + cb, *dst_size - cb, "\n"), *dst_size);
+    }
+    /* label, up to 10 digits and a space per bucket and a newline, for each of the two lines */
+#define TIMER_HISTOGRAM_LINES_LEN (2 * (11 + 11 * ESP_TIMER_HISTOGRAM_BUCKETS + 1))
+#else
+#define TIMER_HISTOGRAM_LINES_LEN 0
 #endif
     *dst += cb;
     *dst_size -= cb;
@@ -628,15 +818,21 @@ esp_err_t esp_timer_dump(FILE* stream)
      * print to it, then dump this memory to stdout.
      */
 
+#if !CONFIG_ESP_TIMER_QUEUE_HEAP || WITH_PROFILING
     esp_timer_handle_t it;
+#endif
 
     /* First count the number of timers */
     size_t timer_count = 0;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+        timer_count += s_timers[dispatch_method].count;
+#else
         LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
             ++timer_count;
         }
+#endif
 #if WITH_PROFILING
         LIST_FOREACH(it, &s_inactive_timers[dispatch_method], list_entry) {
             ++timer_count;
@@ -650,19 +846,39 @@ esp_err_t esp_timer_dump(FILE* stream)
      * for this (can't allocate from a critical section), but we allocate
      * slightly more and the output will be truncated if that is not enough.
      */
-    size_t buf_size = TIMER_INFO_LINE_LEN * (timer_count + 3);
+    size_t buf_size = (TIMER_INFO_LINE_LEN + TIMER_HISTOGRAM_LINES_LEN) * (timer_count + 3);
     char* print_buf = calloc(1, buf_size + 1);
     if (print_buf == NULL) {
         return ESP_ERR_NO_MEM;
     }
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+    /* The heap is not sorted, armed timers are copied here and sorted by alarm before printing */
+    const size_t sorted_size = timer_count + 3;
+    esp_timer_handle_t* sorted = calloc(sorted_size, sizeof(esp_timer_handle_t));
+    if (sorted == NULL) {
+        free(print_buf);
+        return ESP_ERR_NO_MEM;
+    }
+#endif
 
     /* Print to the buffer */
     char* pos = print_buf;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+        size_t sorted_count = MIN(s_timers[dispatch_method].count, sorted_size);
+        if (sorted_count > 0) {
+            memcpy(sorted, s_timers[dispatch_method].timers, sorted_count * sizeof(esp_timer_handle_t));
+        }
+        qsort(sorted, sorted_count, sizeof(esp_timer_handle_t), timer_alarm_cmp);
+        for (size_t i = 0; i < sorted_count; ++i) {
+            print_timer_info(sorted[i], &pos, &buf_size);
+        }
+#else
         LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
             print_timer_info(it, &pos, &buf_size);
         }
+#endif
 #if WITH_PROFILING
         LIST_FOREACH(it, &s_inactive_timers[dispatch_method], list_entry) {
             print_timer_info(it, &pos, &buf_size);
@@ -679,11 +895,17 @@ esp_err_t esp_timer_dump(FILE* stream)
 #else
         fprintf(stream, "%-20s  %-10s  %-12s\n", "Name", "Period", "Alarm");
 #endif
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+        fprintf(stream, "Histogram buckets [us]: 0, 1, 2-3, 4-7, ..., >=%d\n", 1 << (ESP_TIMER_HISTOGRAM_BUCKETS - 2));
+#endif
 
         /* Print the buffer */
         fputs(print_buf, stream);
     }
 
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+    free(sorted);
+#endif
     free(print_buf);
     return ESP_OK;
 }
@@ -693,7 +915,7 @@ int64_t ESP_TIMER_IRAM_ATTR esp_timer_get_next_alarm(void)
     int64_t next_alarm = INT64_MAX;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
-        esp_timer_handle_t it = LIST_FIRST(&s_timers[dispatch_method]);
+        esp_timer_handle_t it = TIMER_QUEUE_FIRST(dispatch_method);
         if (it) {
             if (next_alarm > it->alarm) {
                 next_alarm = it->alarm;
@@ -709,16 +931,28 @@ int64_t ESP_TIMER_IRAM_ATTR esp_timer_get_next_alarm_for_wake_up(void)
     int64_t next_alarm = INT64_MAX;
     for (esp_timer_dispatch_t dispatch_method = ESP_TIMER_TASK; dispatch_method < ESP_TIMER_MAX; ++dispatch_method) {
         timer_list_lock(dispatch_method);
+#if CONFIG_ESP_TIMER_QUEUE_HEAP
+        // The heap is not sorted, all the timers need to be checked
+        for (uint32_t i = 0; i < s_timers[dispatch_method].count; ++i) {
+            esp_timer_handle_t it = s_timers[dispatch_method].timers[i];
+            // timers with the SKIP_UNHANDLED_EVENTS flag do not want to wake up CPU from a sleep mode.
+            if ((it->flags & FL_SKIP_UNHANDLED_EVENTS) == 0 && next_alarm > it->alarm + it->slack) {
+                next_alarm = it->alarm + it->slack;
+            }
+        }
+#else
         esp_timer_handle_t it = NULL;
         LIST_FOREACH(it, &s_timers[dispatch_method], list_entry) {
-            // timers with the SKIP_UNHANDLED_EVENTS flag do not want to wake up CPU from a sleep mode.
-            if ((it->flags & FL_SKIP_UNHANDLED_EVENTS) == 0) {
-                if (next_alarm > it->alarm) {
-                    next_alarm = it->alarm;
-                }
+            // the list is sorted by alarm, later timers can't end their slack window earlier.
+            if (next_alarm <= it->alarm) {
                 break;
             }
+            // timers with the SKIP_UNHANDLED_EVENTS flag do not want to wake up CPU from a sleep mode.
+            if ((it->flags & FL_SKIP_UNHANDLED_EVENTS) == 0 && next_alarm > it->alarm + it->slack) {
+                next_alarm = it->alarm + it->slack;
+            }
         }
+#endif // CONFIG_ESP_TIMER_QUEUE_HEAP
         timer_list_unlock(dispatch_method);
     }
     return next_alarm;
@@ -759,6 +993,44 @@ esp_err_t ESP_TIMER_IRAM_ATTR esp_timer_get_expiry_time(esp_timer_handle_t timer
     return ESP_OK;
 }
 
+esp_err_t esp_timer_get_histogram(esp_timer_handle_t timer, esp_timer_histogram_t *histogram)
+{
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+    if (timer == NULL || histogram == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
+
+    timer_list_lock(dispatch_method);
+    *histogram = timer->histogram;
+    timer_list_unlock(dispatch_method);
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t esp_timer_reset_histogram(esp_timer_handle_t timer)
+{
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+    if (timer == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_timer_dispatch_t dispatch_method = timer->flags & FL_ISR_DISPATCH_METHOD;
+
+    timer_list_lock(dispatch_method);
+    memset(&timer->histogram, 0, sizeof(timer->histogram));
+    timer_list_unlock(dispatch_method);
+
+    return ESP_OK;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
 bool ESP_TIMER_IRAM_ATTR esp_timer_is_active(esp_timer_handle_t timer)
 {
     if (timer == NULL) {
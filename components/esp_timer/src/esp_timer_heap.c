@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <sys/param.h>
+#include "esp_attr.h"
+#include "esp_timer_impl.h"
+#include "esp_timer_heap.h"
+
+/* The heap is stored in an array: the children of the element at index i are at 2*i+1 and 2*i+2.
+ * Each timer keeps its own index so that it can be removed or moved without searching for it.
+ */
+
+static ESP_TIMER_IRAM_ATTR void heap_place(esp_timer_heap_t *heap, esp_timer_handle_t timer, uint32_t index)
+{
+    heap->timers[index] = timer;
+    timer->heap_index = index;
+}
+
+static ESP_TIMER_IRAM_ATTR void heap_sift_up(esp_timer_heap_t *heap, esp_timer_handle_t timer, uint32_t index)
+{
+    while (index > 0) {
+        uint32_t parent = (index - 1) / 2;
+        if (heap->timers[parent]->alarm <= timer->alarm) {
+            break;
+        }
+        heap_place(heap, heap->timers[parent], index);
+        index = parent;
+    }
+    heap_place(heap, timer, index);
+}
+
+static ESP_TIMER_IRAM_ATTR void heap_sift_down(esp_timer_heap_t *heap, esp_timer_handle_t timer, uint32_t index)
+{
+    const uint32_t count = heap->count;
+    while (true) {
+        uint32_t child = 2 * index + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && heap->timers[child + 1]->alarm < heap->timers[child]->alarm) {
+            child++;
+        }
+        if (timer->alarm <= heap->timers[child]->alarm) {
+            break;
+        }
+        heap_place(heap, heap->timers[child], index);
+        index = child;
+    }
+    heap_place(heap, timer, index);
+}
+
+static ESP_TIMER_IRAM_ATTR void heap_restore(esp_timer_heap_t *heap, esp_timer_handle_t timer, uint32_t index)
+{
+    if (index > 0 && timer->alarm < heap->timers[(index - 1) / 2]->alarm) {
+        heap_sift_up(heap, timer, index);
+    } else {
+        heap_sift_down(heap, timer, index);
+    }
+}
+
+void ESP_TIMER_IRAM_ATTR esp_timer_heap_insert(esp_timer_heap_t *heap, esp_timer_handle_t timer)
+{
+    assert(heap->count < heap->capacity);
+    heap_sift_up(heap, timer, heap->count++);
+}
+
+void ESP_TIMER_IRAM_ATTR esp_timer_heap_remove(esp_timer_heap_t *heap, esp_timer_handle_t timer)
+{
+    uint32_t index = timer->heap_index;
+    assert(index < heap->count && heap->timers[index] == timer);
+    esp_timer_handle_t last = heap->timers[--heap->count];
+    if (last != timer) {
+        heap_restore(heap, last, index);
+    }
+}
+
+void ESP_TIMER_IRAM_ATTR esp_timer_heap_update(esp_timer_heap_t *heap, esp_timer_handle_t timer)
+{
+    uint32_t index = timer->heap_index;
+    assert(index < heap->count && heap->timers[index] == timer);
+    heap_restore(heap, timer, index);
+}
+
+/* Called from the critical section, so the subtrees are visited in pre-order without recursion: the position in
+ * the array tells whether an element is a left (odd index) or a right child, which is enough to find the next one.
+ */
+uint64_t ESP_TIMER_IRAM_ATTR esp_timer_heap_min_deadline(const esp_timer_heap_t *heap)
+{
+    uint64_t deadline = UINT64_MAX;
+    uint32_t index = 0;
+    while (true) {
+        if (index < heap->count && heap->timers[index]->alarm <= deadline) {
+            esp_timer_handle_t timer = heap->timers[index];
+            deadline = MIN(deadline, timer->alarm + timer->slack);
+            index = 2 * index + 1;
+            continue;
+        }
+        // neither this timer nor the ones below it can end their window earlier, go to the next right subtree
+        while (index > 0 && index % 2 == 0) {
+            index = (index - 1) / 2;
+        }
+        if (index == 0) {
+            return deadline;
+        }
+        index++;
+    }
+}
+
+esp_timer_handle_t *esp_timer_heap_set_storage(esp_timer_heap_t *heap, esp_timer_handle_t *timers, uint32_t capacity)
+{
+    assert(capacity >= heap->count);
+    esp_timer_handle_t *old_timers = heap->timers;
+    if (heap->count > 0) {
+        memcpy(timers, old_timers, heap->count * sizeof(esp_timer_handle_t));
+    }
+    heap->timers = timers;
+    heap->capacity = capacity;
+    return old_timers;
+}
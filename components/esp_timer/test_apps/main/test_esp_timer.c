@@ -63,8 +63,18 @@ TEST_CASE("esp_timer orders timers correctly", "[esp_timer]")
     char line[128];
     TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), stream));
     TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), stream));
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+    TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), stream));
+#endif
 
     for (size_t i = 0; i < num_timers; ++i) {
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+        /* Discard the histogram lines of the previous timer */
+        if (i > 0) {
+            TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), stream));
+            TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), stream));
+        }
+#endif
         TEST_ASSERT_NOT_NULL(fgets(line, sizeof(line), stream));
 #if WITH_PROFILING
         int timer_id;
@@ -983,6 +993,105 @@ TEST_CASE("one-shot esp_timer can be restarted", "[esp_timer]")
     vTaskDelay(3); // wait for the esp_timer task to delete all timers
 }
 
+static void test_timer_save_time(void* arg)
+{
+    *(int64_t*) arg = esp_timer_get_time();
+}
+
+TEST_CASE("timers with slack are dispatched together", "[esp_timer]")
+{
+    int64_t t_strict = 0;
+    int64_t t_slack = 0;
+    esp_timer_handle_t strict_timer;
+    esp_timer_handle_t slack_timer;
+    esp_timer_create_args_t create_args = {
+        .callback = &test_timer_save_time,
+        .arg = &t_strict,
+        .name = "strict",
+    };
+    TEST_ESP_OK(esp_timer_create(&create_args, &strict_timer));
+    create_args.arg = &t_slack;
+    create_args.name = "slack";
+    create_args.slack_us = 20000;
+    TEST_ESP_OK(esp_timer_create(&create_args, &slack_timer));
+
+    /* The window of the slack timer is [20 ms, 40 ms], the strict timer expires at 30 ms:
+     * the slack timer should not fire on its own, but together with the strict one. */
+    int64_t start = esp_timer_get_time();
+    TEST_ESP_OK(esp_timer_start_once(slack_timer, 20000));
+    TEST_ESP_OK(esp_timer_start_once(strict_timer, 30000));
+    TEST_ASSERT_INT64_WITHIN(1000, start + 30000, esp_timer_get_next_alarm_for_wake_up());
+    vTaskDelay(pdMS_TO_TICKS(60));
+    printf("strict: %lld us, slack: %lld us\n", t_strict - start, t_slack - start);
+    TEST_ASSERT_NOT_EQUAL(0, t_slack);
+    TEST_ASSERT(t_slack >= start + 30000);
+    TEST_ASSERT_INT64_WITHIN(1000, t_strict, t_slack);
+
+    /* Without another timer, the slack timer fires at the end of its window at the latest */
+    t_slack = 0;
+    start = esp_timer_get_time();
+    TEST_ESP_OK(esp_timer_start_once(slack_timer, 20000));
+    TEST_ASSERT_INT64_WITHIN(1000, start + 40000, esp_timer_get_next_alarm_for_wake_up());
+    vTaskDelay(pdMS_TO_TICKS(60));
+    TEST_ASSERT_NOT_EQUAL(0, t_slack);
+    TEST_ASSERT(t_slack >= start + 20000);
+    TEST_ASSERT(t_slack <= start + 41000);
+
+    TEST_ESP_OK(esp_timer_delete(strict_timer));
+    TEST_ESP_OK(esp_timer_delete(slack_timer));
+    vTaskDelay(3); // wait for the esp_timer task to delete all timers
+}
+
+static void test_timer_busy_cb(void* arg)
+{
+    esp_rom_delay_us(500);
+    ++*(int*) arg;
+}
+
+TEST_CASE("esp_timer records latency and run time histograms", "[esp_timer]")
+{
+    int timer_trig = 0;
+    esp_timer_handle_t timer;
+    esp_timer_histogram_t histogram;
+    esp_timer_create_args_t create_args = {
+        .callback = &test_timer_busy_cb,
+        .arg = &timer_trig,
+        .name = "histogram",
+    };
+    TEST_ESP_OK(esp_timer_create(&create_args, &timer));
+#if CONFIG_ESP_TIMER_HISTOGRAMS
+    TEST_ESP_OK(esp_timer_start_periodic(timer, 10000));
+    vTaskDelay(pdMS_TO_TICKS(105));
+    TEST_ESP_OK(esp_timer_stop(timer));
+    TEST_ESP_OK(esp_timer_dump(stdout));
+    TEST_ESP_OK(esp_timer_get_histogram(timer, &histogram));
+
+    int latency_count = 0;
+    int run_time_count = 0;
+    for (int i = 0; i < ESP_TIMER_HISTOGRAM_BUCKETS; ++i) {
+        latency_count += histogram.latency[i];
+        run_time_count += histogram.run_time[i];
+    }
+    TEST_ASSERT_EQUAL(timer_trig, latency_count);
+    TEST_ASSERT_EQUAL(timer_trig, run_time_count);
+    /* 500 us is in the [256, 511] us bucket, the callback may also be preempted */
+    for (int i = 0; i < 9; ++i) {
+        TEST_ASSERT_EQUAL(0, histogram.run_time[i]);
+    }
+
+    TEST_ESP_OK(esp_timer_reset_histogram(timer));
+    TEST_ESP_OK(esp_timer_get_histogram(timer, &histogram));
+    for (int i = 0; i < ESP_TIMER_HISTOGRAM_BUCKETS; ++i) {
+        TEST_ASSERT_EQUAL(0, histogram.latency[i]);
+        TEST_ASSERT_EQUAL(0, histogram.run_time[i]);
+    }
+#else
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_SUPPORTED, esp_timer_get_histogram(timer, &histogram));
+#endif
+    TEST_ESP_OK(esp_timer_delete(timer));
+    vTaskDelay(3); // wait for the esp_timer task to delete all timers
+}
+
 #ifdef CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
 static int64_t old_time[2];
 
@@ -11,6 +11,8 @@ from pytest_embedded_idf.utils import idf_parametrize
     [
         ('general', 'supported_targets'),
         ('release', 'supported_targets'),
+        ('timer_heap', 'supported_targets'),
+        ('histograms', 'supported_targets'),
         ('single_core', 'esp32'),
         ('freertos_compliance', 'esp32'),
         ('isr_dispatch_esp32', 'esp32'),
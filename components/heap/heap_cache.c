@@ -0,0 +1,75 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+#include "heap_cache.h"
+
+static const uint8_t class_sizes[HEAP_CACHE_CLASSES] = { 16, 24, 32, 48, 64, 96, 128 };
+
+/* Class of each size, indexed by the size in 8-byte units (rounded up) */
+static const uint8_t size_classes[HEAP_CACHE_MAX_SIZE / 8 + 1] = {
+    0, 0, 0, 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6
+};
+
+_Static_assert(sizeof(heap_cache_block_t) <= 16, "cached blocks must fit in the smallest class");
+
+int heap_cache_size_class(size_t size)
+{
+    if (size == 0 || size > HEAP_CACHE_MAX_SIZE) {
+        return -1;
+    }
+    return size_classes[(size + 7) / 8];
+}
+
+size_t heap_cache_class_size(int cls)
+{
+    assert(cls >= 0 && cls < HEAP_CACHE_CLASSES);
+    return class_sizes[cls];
+}
+
+void *heap_cache_get(heap_cache_t *cache, int cls, uint32_t caps)
+{
+    heap_cache_block_t *block = cache->blocks[cls];
+    if (block == NULL || (block->caps & caps) != caps) {
+        return NULL;
+    }
+    cache->blocks[cls] = block->next;
+    cache->count[cls]--;
+    return block;
+}
+
+bool heap_cache_put(heap_cache_t *cache, int cls, void *ptr, void *heap, uint32_t caps)
+{
+    if (cache->count[cls] >= cache->depth) {
+        return false;
+    }
+    heap_cache_block_t *block = (heap_cache_block_t *)ptr;
+    block->heap = heap;
+    block->caps = caps;
+    block->next = cache->blocks[cls];
+    cache->blocks[cls] = block;
+    cache->count[cls]++;
+    return true;
+}
+
+heap_cache_block_t *heap_cache_take_all(heap_cache_t *cache)
+{
+    heap_cache_block_t *all = NULL;
+    for (int cls = 0; cls < HEAP_CACHE_CLASSES; cls++) {
+        heap_cache_block_t *block = cache->blocks[cls];
+        while (block != NULL) {
+            heap_cache_block_t *next = block->next;
+            block->next = all;
+            all = block;
+            block = next;
+        }
+        cache->blocks[cls] = NULL;
+        cache->count[cls] = 0;
+    }
+    return all;
+}
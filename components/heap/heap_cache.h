@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Cache of free small blocks, one per CPU core, which heap_caps_base.c places in front of the
+   registered heaps when CONFIG_HEAP_SMALL_BLOCK_CACHE is enabled.
+
+   Blocks in a cache are still allocated as far as multi_heap is concerned. Each size class is a
+   LIFO list threaded through the blocks themselves: the first bytes of a cached block hold the
+   link, the heap the block belongs to and the capabilities of that heap, which is why the
+   smallest class is 16 bytes.
+
+   None of the functions are thread-safe, the caller provides the locking. Like multi_heap.c,
+   this file depends on libc only, so that it can be built by the host tests.
+*/
+
+#define HEAP_CACHE_CLASSES   7      // 16, 24, 32, 48, 64, 96 and 128 bytes
+#define HEAP_CACHE_MAX_SIZE  128
+
+typedef struct heap_cache_block_ {
+    struct heap_cache_block_ *next;
+    void *heap;                     ///< Heap the block must be returned to, opaque to the cache
+    uint32_t caps;                  ///< Capabilities of that heap
+} heap_cache_block_t;
+
+typedef struct {
+    heap_cache_block_t *blocks[HEAP_CACHE_CLASSES];
+    uint8_t count[HEAP_CACHE_CLASSES];
+    uint8_t depth;                  ///< Maximum number of blocks kept in each class
+} heap_cache_t;
+
+/* Return the index of the smallest class which can hold 'size' bytes,
+   or -1 if 'size' is 0 or too large to be cached. */
+int heap_cache_size_class(size_t size);
+
+/* Return the size of the blocks in class 'cls'. */
+size_t heap_cache_class_size(int cls);
+
+/* Take a block of class 'cls' whose heap has all the capabilities in 'caps'.
+
+   Only the most recently cached block of the class is considered, NULL is returned if
+   it does not match. */
+void *heap_cache_get(heap_cache_t *cache, int cls, uint32_t caps);
+
+/* Keep a block of class 'cls', which belongs to 'heap' with capabilities 'caps'.
+
+   Returns false if the class is already full, in which case the caller frees the block. */
+bool heap_cache_put(heap_cache_t *cache, int cls, void *ptr, void *heap, uint32_t caps);
+
+/* Empty the cache. Returns the removed blocks of all classes as a single list, which the
+   caller walks (reading 'next' before freeing each block) to give them back to their heaps. */
+heap_cache_block_t *heap_cache_take_all(heap_cache_t *cache);
+
+#ifdef __cplusplus
+}
+#endif
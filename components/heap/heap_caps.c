@@ -388,6 +388,28 @@ void heap_caps_get_info( multi_heap_info_t *info, uint32_t caps )
     }
 }
 
+uint32_t heap_caps_get_fragmentation_info(uint32_t caps, size_t *hist, size_t hist_len)
+{
+    size_t total_free = 0;
+    size_t largest_free = 0;
+
+    if (hist_len > 0) {
+        memset(hist, 0, hist_len * sizeof(size_t));
+    }
+
+    heap_t *heap;
+    SLIST_FOREACH(heap, &registered_heaps, next) {
+        if (heap_caps_match(heap, caps)) {
+            multi_heap_get_free_histogram(heap->heap, hist, hist_len, &total_free, &largest_free);
+        }
+    }
+
+    if (total_free == 0) {
+        return 0;
+    }
+    return 100 - (uint32_t)(((uint64_t)largest_free * 100) / total_free);
+}
+
 void heap_caps_print_heap_info( uint32_t caps )
 {
     multi_heap_info_t info;
@@ -402,6 +424,13 @@ void heap_caps_print_heap_info( uint32_t caps )
             printf("    largest_free_block %d alloc_blocks %d free_blocks %d total_blocks %d\n",
                    info.largest_free_block, info.allocated_blocks,
                    info.free_blocks, info.total_blocks);
+
+            heap_caps_pool_info_t pool_info;
+            for (size_t n = 0; heap_caps_pool_get_nth_info(heap, n, &pool_info); n++) {
+                printf("    pool at %p obj_size %d count %d free %d min_free %d\n",
+                       pool_info.start, pool_info.obj_size, pool_info.total_count,
+                       pool_info.free_count, pool_info.minimum_free_count);
+            }
         }
     }
     printf("  Totals:\n");
@@ -420,6 +449,7 @@ bool heap_caps_check_integrity(uint32_t caps, bool print_errors)
         if (heap->heap != NULL
             && (all_heaps || (get_all_caps(heap) & caps) == caps)) {
             valid = multi_heap_check(heap->heap, print_errors) && valid;
+            valid = heap_caps_pool_check_heap(heap, print_errors) && valid;
         }
     }
 
@@ -437,7 +467,8 @@ bool heap_caps_check_integrity_addr(intptr_t addr, bool print_errors)
     if (heap == NULL) {
         return false;
     }
-    return multi_heap_check(heap->heap, print_errors);
+    bool valid = multi_heap_check(heap->heap, print_errors);
+    return heap_caps_pool_check_heap(heap, print_errors) && valid;
 }
 
 void heap_caps_dump(uint32_t caps)
@@ -584,6 +615,13 @@ __attribute__((noinline)) static bool heap_caps_walker(void *block_ptr, size_t b
         (intptr_t)walker_data->heap->start,
         (intptr_t)walker_data->heap->end
     };
+    // the objects of a pool are reported instead of the block which holds them
+    bool proceed;
+    if (block_used && heap_caps_pool_walk_block(block_ptr, block_size, heap_info,
+                                                walker_data->cb_func, walker_data->opaque_ptr, &proceed)) {
+        return proceed;
+    }
+
     walker_block_info_t block_info = {
         block_ptr,
         block_size,
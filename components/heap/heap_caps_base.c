@@ -17,6 +17,9 @@
 #include "esp_heap_task_info_internal.h"
 #include "multi_heap_internal.h"
 #endif
+#if CONFIG_HEAP_SMALL_BLOCK_CACHE
+#include "heap_cache.h"
+#endif
 
 #ifdef CONFIG_HEAP_USE_HOOKS
 #define CALL_HOOK(hook, ...) {      \
@@ -61,14 +64,88 @@ HEAP_IRAM_ATTR static void *dram_alloc_to_iram_addr(void *addr, size_t len)
     return iptr + 1;
 }
 
+#if CONFIG_HEAP_SMALL_BLOCK_CACHE
+/* Small blocks freed on a core are kept in that core's cache and handed out again by the next
+   allocations of the same size class, without going through the heap search and the heap lock.
+   The per-core lock is normally only taken by its own core, it is needed because a task can be
+   moved to the other core while it uses the cache, and because the caches are flushed from any core.
+*/
+typedef struct {
+    multi_heap_lock_t lock;
+    heap_cache_t cache;
+} core_cache_t;
+
+static core_cache_t s_core_caches[portNUM_PROCESSORS] = {
+    [0 ... portNUM_PROCESSORS - 1] = {
+        .lock = MULTI_HEAP_LOCK_STATIC_INITIALIZER,
+        .cache = { .depth = CONFIG_HEAP_SMALL_BLOCK_CACHE_DEPTH },
+    },
+};
+
+HEAP_IRAM_ATTR static void *core_cache_get(int cls, uint32_t caps)
+{
+    core_cache_t *core_cache = &s_core_caches[xPortGetCoreID()];
+    MULTI_HEAP_LOCK(&core_cache->lock);
+    void *ret = heap_cache_get(&core_cache->cache, cls, caps);
+    MULTI_HEAP_UNLOCK(&core_cache->lock);
+    return ret;
+}
+
+HEAP_IRAM_ATTR static bool core_cache_put(heap_t *heap, void *ptr)
+{
+    uint32_t caps = get_all_caps(heap);
+    if (!(caps & MALLOC_CAP_INTERNAL)) {
+        return false;
+    }
+    // Only blocks of exactly the size of a class are kept, so that any block of the class can serve any request for it
+    size_t size = multi_heap_get_allocated_size(heap->heap, ptr);
+    int cls = heap_cache_size_class(size);
+    if (cls < 0 || heap_cache_class_size(cls) != size) {
+        return false;
+    }
+    core_cache_t *core_cache = &s_core_caches[xPortGetCoreID()];
+    MULTI_HEAP_LOCK(&core_cache->lock);
+    bool cached = heap_cache_put(&core_cache->cache, cls, ptr, heap, caps);
+    MULTI_HEAP_UNLOCK(&core_cache->lock);
+    return cached;
+}
+
+/* Give all the cached blocks back to their heaps. Returns the number of blocks freed. */
+HEAP_IRAM_ATTR static size_t core_caches_flush(void)
+{
+    size_t count = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        core_cache_t *core_cache = &s_core_caches[core];
+        MULTI_HEAP_LOCK(&core_cache->lock);
+        heap_cache_block_t *block = heap_cache_take_all(&core_cache->cache);
+        MULTI_HEAP_UNLOCK(&core_cache->lock);
+        while (block != NULL) {
+            heap_cache_block_t *next = block->next;
+            multi_heap_free(((heap_t *)block->heap)->heap, block);
+            block = next;
+            count++;
+        }
+    }
+    return count;
+}
+#endif // CONFIG_HEAP_SMALL_BLOCK_CACHE
+
+void heap_caps_cache_flush(void)
+{
+#if CONFIG_HEAP_SMALL_BLOCK_CACHE
+    core_caches_flush();
+#endif
+}
+
 HEAP_IRAM_ATTR void heap_caps_free( void *ptr)
 {
     if (ptr == NULL) {
         return;
     }
 
-    if ((!esp_dram_match_iram() && esp_ptr_in_diram_iram(ptr)) ||
-        (!esp_rtc_dram_match_rtc_iram() && esp_ptr_in_rtc_iram_fast(ptr))) {
+    bool iram_alias = (!esp_dram_match_iram() && esp_ptr_in_diram_iram(ptr)) ||
+                      (!esp_rtc_dram_match_rtc_iram() && esp_ptr_in_rtc_iram_fast(ptr));
+    if (iram_alias) {
         //Memory allocated here is actually allocated in the DRAM alias region and
         //cannot be de-allocated as usual. dram_alloc_to_iram_addr stores a pointer to
         //the equivalent DRAM address, though; free that.
@@ -83,6 +160,13 @@ HEAP_IRAM_ATTR void heap_caps_free( void *ptr)
     heap_caps_update_per_task_info_free(heap, ptr);
 #endif
 
+#if CONFIG_HEAP_SMALL_BLOCK_CACHE
+    if (!iram_alias && core_cache_put(heap, ptr)) {
+        CALL_HOOK(esp_heap_trace_free_hook, ptr);
+        return;
+    }
+#endif
+
     multi_heap_free(heap->heap, block_owner_ptr);
 
     CALL_HOOK(esp_heap_trace_free_hook, ptr);
@@ -96,44 +180,11 @@ HEAP_IRAM_ATTR static inline void *aligned_or_unaligned_alloc(multi_heap_handle_
     }
 }
 
-/*
-This function should not be called directly as it does not check for failure / call heap_caps_alloc_failed()
-Note that this function does 'unaligned' alloc calls if alignment <= UNALIGNED_MEM_ALIGNMENT_BYTES (=4) as the
-allocator will align to that value by default.
-*/
-HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment, size_t size, uint32_t caps)
+/* Allocate from the first registered heap, in priority order, which has all the capabilities in caps */
+HEAP_IRAM_ATTR static void *alloc_from_registered_heaps(size_t alignment, size_t size, uint32_t caps)
 {
     void *ret = NULL;
 
-    // Alignment, size and caps may need to be modified because of hardware requirements.
-    esp_heap_adjust_alignment_to_hw(&alignment, &size, &caps);
-
-    // remove block owner size to HEAP_SIZE_MAX rather than adding the block owner size
-    // to size to prevent overflows.
-    if (size == 0 || size > MULTI_HEAP_REMOVE_BLOCK_OWNER_SIZE(HEAP_SIZE_MAX) ) {
-        // Avoids int overflow when adding small numbers to size, or
-        // calculating 'end' from start+size, by limiting 'size' to the possible range
-        return NULL;
-    }
-
-    if (caps & MALLOC_CAP_EXEC) {
-        //MALLOC_CAP_EXEC forces an alloc from IRAM. There is a region which has both this as well as the following
-        //caps, but the following caps are not possible for IRAM.  Thus, the combination is impossible and we return
-        //NULL directly, even although our heap capabilities (based on soc_memory_tags & soc_memory_regions) would
-        //indicate there is a tag for this.
-        if ((caps & MALLOC_CAP_8BIT) || (caps & MALLOC_CAP_DMA)) {
-            return NULL;
-        }
-        caps |= MALLOC_CAP_32BIT; // IRAM is 32-bit accessible RAM
-    }
-
-    if (caps & MALLOC_CAP_32BIT) {
-        /* 32-bit accessible RAM should allocated in 4 byte aligned sizes
-         * (Future versions of ESP-IDF should possibly fail if an invalid size is requested)
-         */
-        size = (size + 3) & (~3); // int overflow checked above
-    }
-
     for (int prio = 0; prio < SOC_MEMORY_TYPE_NO_PRIOS; prio++) {
         //Iterate over heaps and check capabilities at this priority
         heap_t *heap;
@@ -197,6 +248,68 @@ HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment
     return NULL;
 }
 
+/*
+This function should not be called directly as it does not check for failure / call heap_caps_alloc_failed()
+Note that this function does 'unaligned' alloc calls if alignment <= UNALIGNED_MEM_ALIGNMENT_BYTES (=4) as the
+allocator will align to that value by default.
+*/
+HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_aligned_alloc_base(size_t alignment, size_t size, uint32_t caps)
+{
+    // Alignment, size and caps may need to be modified because of hardware requirements.
+    esp_heap_adjust_alignment_to_hw(&alignment, &size, &caps);
+
+    // remove block owner size to HEAP_SIZE_MAX rather than adding the block owner size
+    // to size to prevent overflows.
+    if (size == 0 || size > MULTI_HEAP_REMOVE_BLOCK_OWNER_SIZE(HEAP_SIZE_MAX) ) {
+        // Avoids int overflow when adding small numbers to size, or
+        // calculating 'end' from start+size, by limiting 'size' to the possible range
+        return NULL;
+    }
+
+    if (caps & MALLOC_CAP_EXEC) {
+        //MALLOC_CAP_EXEC forces an alloc from IRAM. There is a region which has both this as well as the following
+        //caps, but the following caps are not possible for IRAM.  Thus, the combination is impossible and we return
+        //NULL directly, even although our heap capabilities (based on soc_memory_tags & soc_memory_regions) would
+        //indicate there is a tag for this.
+        if ((caps & MALLOC_CAP_8BIT) || (caps & MALLOC_CAP_DMA)) {
+            return NULL;
+        }
+        caps |= MALLOC_CAP_32BIT; // IRAM is 32-bit accessible RAM
+    }
+
+    if (caps & MALLOC_CAP_32BIT) {
+        /* 32-bit accessible RAM should allocated in 4 byte aligned sizes
+         * (Future versions of ESP-IDF should possibly fail if an invalid size is requested)
+         */
+        size = (size + 3) & (~3); // int overflow checked above
+    }
+
+#if CONFIG_HEAP_SMALL_BLOCK_CACHE
+    int cls = -1;
+    if (alignment <= UNALIGNED_MEM_ALIGNMENT_BYTES && !(caps & MALLOC_CAP_EXEC)) {
+        cls = heap_cache_size_class(size);
+    }
+    if (cls >= 0) {
+        // Allocate the whole class, so that the block can be cached when it is freed
+        size = heap_cache_class_size(cls);
+        void *cached = core_cache_get(cls, caps);
+        if (cached != NULL) {
+            CALL_HOOK(esp_heap_trace_alloc_hook, cached, size, caps);
+            return cached;
+        }
+    }
+
+    void *ret = alloc_from_registered_heaps(alignment, size, caps);
+    if (ret == NULL && core_caches_flush() > 0) {
+        // Memory is low, try again now that the cached blocks are back in the heaps
+        ret = alloc_from_registered_heaps(alignment, size, caps);
+    }
+    return ret;
+#else
+    return alloc_from_registered_heaps(alignment, size, caps);
+#endif
+}
+
 //Wrapper for heap_caps_aligned_alloc_base as that can also do unaligned allocs.
 HEAP_IRAM_ATTR NOINLINE_ATTR void *heap_caps_malloc_base( size_t size, uint32_t caps) {
     return heap_caps_aligned_alloc_base(UNALIGNED_MEM_ALIGNMENT_BYTES, size, caps);
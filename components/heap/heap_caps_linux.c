@@ -9,6 +9,9 @@
 #include <malloc.h>
 #endif
 #include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sys/param.h>
 
 #include "esp_attr.h"
 #include "esp_heap_caps.h"
@@ -117,6 +120,10 @@ void heap_caps_free( void *ptr)
     free(ptr);
 }
 
+void heap_caps_cache_flush(void)
+{
+}
+
 static void *heap_caps_calloc_base( size_t n, size_t size, uint32_t caps)
 {
     size_t size_bytes;
@@ -170,6 +177,14 @@ void heap_caps_get_info( multi_heap_info_t *info, uint32_t caps )
     memset(info, 0, sizeof(multi_heap_info_t));
 }
 
+uint32_t heap_caps_get_fragmentation_info(uint32_t caps, size_t *hist, size_t hist_len)
+{
+    if (hist_len > 0) {
+        memset(hist, 0, hist_len * sizeof(size_t));
+    }
+    return 0;
+}
+
 void heap_caps_print_heap_info( uint32_t caps )
 {
     printf("No heap summary available when building for the linux target");
@@ -238,3 +253,90 @@ void *heap_caps_aligned_calloc(size_t alignment, size_t n, size_t size, uint32_t
 
     return ptr;
 }
+
+/*
+Object pools are emulated: each object is allocated from the system heap, the pool only counts them.
+*/
+struct heap_caps_pool {
+    pthread_mutex_t lock;
+    size_t obj_size;
+    size_t count;
+    size_t free_count;
+    size_t minimum_free_count;
+    uint32_t caps;
+};
+
+heap_caps_pool_handle_t heap_caps_pool_create(size_t obj_size, size_t count, uint32_t caps)
+{
+    if (obj_size == 0 || count == 0 || count > INT32_MAX) {
+        return NULL;
+    }
+
+    heap_caps_pool_handle_t pool = calloc(1, sizeof(struct heap_caps_pool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pool->obj_size = (obj_size + 3) & ~3;
+    pool->count = count;
+    pool->free_count = count;
+    pool->minimum_free_count = count;
+    pool->caps = caps;
+    return pool;
+}
+
+void heap_caps_pool_delete(heap_caps_pool_handle_t pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+void *heap_caps_pool_alloc(heap_caps_pool_handle_t pool)
+{
+    assert(pool != NULL);
+    void *obj = NULL;
+    pthread_mutex_lock(&pool->lock);
+    if (pool->free_count > 0) {
+        obj = malloc(pool->obj_size);
+        if (obj != NULL) {
+            pool->free_count--;
+            pool->minimum_free_count = MIN(pool->minimum_free_count, pool->free_count);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return obj;
+}
+
+void heap_caps_pool_free(heap_caps_pool_handle_t pool, void *ptr)
+{
+    assert(pool != NULL);
+    if (ptr == NULL) {
+        return;
+    }
+    free(ptr);
+    pthread_mutex_lock(&pool->lock);
+    pool->free_count++;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+void heap_caps_pool_get_info(heap_caps_pool_handle_t pool, heap_caps_pool_info_t *info)
+{
+    assert(pool != NULL && info != NULL);
+    pthread_mutex_lock(&pool->lock);
+    info->start = NULL; // objects are not contiguous
+    info->obj_size = pool->obj_size;
+    info->total_count = pool->count;
+    info->free_count = pool->free_count;
+    info->minimum_free_count = pool->minimum_free_count;
+    info->caps = pool->caps;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+bool heap_caps_pool_check_integrity(heap_caps_pool_handle_t pool, bool print_errors)
+{
+    assert(pool != NULL);
+    return true;
+}
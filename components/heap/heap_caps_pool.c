@@ -0,0 +1,279 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/param.h>
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
+#include "multi_heap.h"
+#include "heap_private.h"
+#include "esp_system.h"
+
+/*
+An object pool is a single block allocated from the heaps, divided into objects of the same size.
+Free objects are kept in a LIFO list threaded through the objects themselves, so that allocating
+and freeing an object are O(1). A bitmap records which objects are allocated: it lets
+heap_caps_pool_free() detect invalid and double frees, and the integrity check compare the free
+list against it.
+
+Lock order: heap lock (held by multi_heap_walk), then s_pools_lock, then the lock of a pool.
+*/
+
+struct heap_caps_pool {
+    multi_heap_lock_t lock;
+    uint8_t *start;                     ///< First object
+    void *free_list;                    ///< Most recently freed object, each free object holds the address of the next one
+    size_t obj_size;                    ///< Size of an object, multiple of 4
+    size_t count;
+    size_t free_count;
+    size_t minimum_free_count;
+    uint32_t caps;
+    SLIST_ENTRY(heap_caps_pool) next;
+    uint32_t used[];                    ///< One bit per object, set while the object is allocated
+};
+
+static SLIST_HEAD(pool_ll, heap_caps_pool) s_pools = SLIST_HEAD_INITIALIZER(s_pools);
+static multi_heap_lock_t s_pools_lock = MULTI_HEAP_LOCK_STATIC_INITIALIZER;
+
+#define USED_WORDS(count) (((count) + 31) / 32)
+
+FORCE_INLINE_ATTR bool object_is_used(const heap_caps_pool_handle_t pool, size_t index)
+{
+    return pool->used[index / 32] & (1U << (index % 32));
+}
+
+/* Return the index of the object at ptr, or -1 if ptr is not the address of an object of the pool */
+HEAP_IRAM_ATTR static int object_index(const heap_caps_pool_handle_t pool, const void *ptr)
+{
+    intptr_t offset = (intptr_t)ptr - (intptr_t)pool->start;
+    if (offset < 0 || offset >= (intptr_t)(pool->count * pool->obj_size) || offset % pool->obj_size != 0) {
+        return -1;
+    }
+    return offset / pool->obj_size;
+}
+
+heap_caps_pool_handle_t heap_caps_pool_create(size_t obj_size, size_t count, uint32_t caps)
+{
+    size_t storage_size;
+    if (obj_size == 0 || count == 0 || count > INT32_MAX) {
+        return NULL;
+    }
+    obj_size = (obj_size + 3) & ~3;
+    if (__builtin_mul_overflow(obj_size, count, &storage_size)) {
+        return NULL;
+    }
+
+    heap_caps_pool_handle_t pool = heap_caps_calloc(1, sizeof(struct heap_caps_pool) + USED_WORDS(count) * sizeof(uint32_t),
+                                                    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->start = heap_caps_malloc(storage_size, caps);
+    if (pool->start == NULL) {
+        heap_caps_free(pool);
+        return NULL;
+    }
+    MULTI_HEAP_LOCK_INIT(&pool->lock);
+    pool->obj_size = obj_size;
+    pool->count = count;
+    pool->free_count = count;
+    pool->minimum_free_count = count;
+    pool->caps = caps;
+
+    // objects are handed out in address order
+    for (size_t i = count; i > 0; i--) {
+        void **obj = (void **)(pool->start + (i - 1) * obj_size);
+        *obj = pool->free_list;
+        pool->free_list = obj;
+    }
+
+    MULTI_HEAP_LOCK(&s_pools_lock);
+    SLIST_INSERT_HEAD(&s_pools, pool, next);
+    MULTI_HEAP_UNLOCK(&s_pools_lock);
+    return pool;
+}
+
+void heap_caps_pool_delete(heap_caps_pool_handle_t pool)
+{
+    if (pool == NULL) {
+        return;
+    }
+    MULTI_HEAP_LOCK(&s_pools_lock);
+    SLIST_REMOVE(&s_pools, pool, heap_caps_pool, next);
+    MULTI_HEAP_UNLOCK(&s_pools_lock);
+
+    heap_caps_free(pool->start);
+    heap_caps_free(pool);
+}
+
+HEAP_IRAM_ATTR void *heap_caps_pool_alloc(heap_caps_pool_handle_t pool)
+{
+    assert(pool != NULL);
+    MULTI_HEAP_LOCK(&pool->lock);
+    void **obj = pool->free_list;
+    if (obj != NULL) {
+        size_t index = ((uint8_t *)obj - pool->start) / pool->obj_size;
+        pool->free_list = *obj;
+        pool->used[index / 32] |= 1U << (index % 32);
+        pool->free_count--;
+        pool->minimum_free_count = MIN(pool->minimum_free_count, pool->free_count);
+    }
+    MULTI_HEAP_UNLOCK(&pool->lock);
+    return obj;
+}
+
+HEAP_IRAM_ATTR void heap_caps_pool_free(heap_caps_pool_handle_t pool, void *ptr)
+{
+    assert(pool != NULL);
+    if (ptr == NULL) {
+        return;
+    }
+    // Checked even if assertions are disabled, as the bitmap can't be updated for an invalid index
+    int index = object_index(pool, ptr);
+    if (index < 0) {
+        esp_system_abort(DRAM_STR("heap_caps_pool_free() target pointer is not an object of the pool"));
+    }
+
+    MULTI_HEAP_LOCK(&pool->lock);
+    if (!object_is_used(pool, index)) {
+        esp_system_abort(DRAM_STR("heap_caps_pool_free() target object is already free"));
+    }
+    pool->used[index / 32] &= ~(1U << (index % 32));
+    *(void **)ptr = pool->free_list;
+    pool->free_list = ptr;
+    pool->free_count++;
+    MULTI_HEAP_UNLOCK(&pool->lock);
+}
+
+static void pool_get_info(heap_caps_pool_handle_t pool, heap_caps_pool_info_t *info)
+{
+    MULTI_HEAP_LOCK(&pool->lock);
+    info->start = pool->start;
+    info->obj_size = pool->obj_size;
+    info->total_count = pool->count;
+    info->free_count = pool->free_count;
+    info->minimum_free_count = pool->minimum_free_count;
+    info->caps = pool->caps;
+    MULTI_HEAP_UNLOCK(&pool->lock);
+}
+
+void heap_caps_pool_get_info(heap_caps_pool_handle_t pool, heap_caps_pool_info_t *info)
+{
+    assert(pool != NULL && info != NULL);
+    pool_get_info(pool, info);
+}
+
+static bool pool_check(heap_caps_pool_handle_t pool, bool print_errors)
+{
+    bool valid = true;
+    MULTI_HEAP_LOCK(&pool->lock);
+
+    size_t used_count = 0;
+    for (size_t i = 0; i < pool->count; i++) {
+        used_count += object_is_used(pool, i);
+    }
+    if (used_count + pool->free_count != pool->count) {
+        if (print_errors) {
+            MULTI_HEAP_STDERR_PRINTF("CORRUPT POOL: pool %p has %d objects, %d allocated and %d free\n",
+                                     pool->start, pool->count, used_count, pool->free_count);
+        }
+        valid = false;
+    }
+
+    // Follow at most free_count links: a loop or a link overwritten after the object was freed ends the walk early
+    void *obj = pool->free_list;
+    for (size_t n = 0; valid && n < pool->free_count; n++) {
+        int index = object_index(pool, obj);
+        if (index < 0 || object_is_used(pool, index)) {
+            if (print_errors) {
+                MULTI_HEAP_STDERR_PRINTF("CORRUPT POOL: pool %p free list has invalid object %p\n", pool->start, obj);
+            }
+            valid = false;
+            break;
+        }
+        obj = *(void **)obj;
+    }
+    if (valid && obj != NULL) {
+        if (print_errors) {
+            MULTI_HEAP_STDERR_PRINTF("CORRUPT POOL: pool %p free list is longer than %d objects\n", pool->start, pool->free_count);
+        }
+        valid = false;
+    }
+
+    MULTI_HEAP_UNLOCK(&pool->lock);
+    return valid;
+}
+
+bool heap_caps_pool_check_integrity(heap_caps_pool_handle_t pool, bool print_errors)
+{
+    assert(pool != NULL);
+    return pool_check(pool, print_errors);
+}
+
+FORCE_INLINE_ATTR bool pool_in_heap(heap_caps_pool_handle_t pool, const heap_t *heap)
+{
+    return (intptr_t)pool->start >= heap->start && (intptr_t)pool->start < heap->end;
+}
+
+bool heap_caps_pool_check_heap(const heap_t *heap, bool print_errors)
+{
+    bool valid = true;
+    heap_caps_pool_handle_t pool;
+    MULTI_HEAP_LOCK(&s_pools_lock);
+    SLIST_FOREACH(pool, &s_pools, next) {
+        if (pool_in_heap(pool, heap)) {
+            valid = pool_check(pool, print_errors) && valid;
+        }
+    }
+    MULTI_HEAP_UNLOCK(&s_pools_lock);
+    return valid;
+}
+
+bool heap_caps_pool_get_nth_info(const heap_t *heap, size_t n, heap_caps_pool_info_t *info)
+{
+    bool found = false;
+    heap_caps_pool_handle_t pool;
+    MULTI_HEAP_LOCK(&s_pools_lock);
+    SLIST_FOREACH(pool, &s_pools, next) {
+        if (pool_in_heap(pool, heap) && n-- == 0) {
+            pool_get_info(pool, info);
+            found = true;
+            break;
+        }
+    }
+    MULTI_HEAP_UNLOCK(&s_pools_lock);
+    return found;
+}
+
+bool heap_caps_pool_walk_block(void *block_ptr, size_t block_size, walker_heap_into_t heap_info,
+                               heap_caps_walker_cb_t walker_func, void *user_data, bool *proceed)
+{
+    bool found = false;
+    heap_caps_pool_handle_t pool;
+    MULTI_HEAP_LOCK(&s_pools_lock);
+    SLIST_FOREACH(pool, &s_pools, next) {
+        if ((intptr_t)pool->start >= (intptr_t)block_ptr && (intptr_t)pool->start < (intptr_t)block_ptr + block_size) {
+            found = true;
+            break;
+        }
+    }
+    if (found) {
+        MULTI_HEAP_LOCK(&pool->lock);
+        *proceed = true;
+        for (size_t i = 0; i < pool->count && *proceed; i++) {
+            walker_block_info_t block_info = {
+                pool->start + i * pool->obj_size,
+                pool->obj_size,
+                object_is_used(pool, i)
+            };
+            *proceed = walker_func(heap_info, block_info, user_data);
+        }
+        MULTI_HEAP_UNLOCK(&pool->lock);
+    }
+    MULTI_HEAP_UNLOCK(&s_pools_lock);
+    return found;
+}
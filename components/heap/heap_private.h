@@ -12,6 +12,7 @@
 #include "multi_heap_platform.h"
 #include "sys/queue.h"
 #include "esp_attr.h"
+#include "esp_heap_caps.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -82,6 +83,20 @@ FORCE_INLINE_ATTR heap_t *find_containing_heap(void *ptr )
     return NULL;
 }
 
+/* Object pools (heap_caps_pool.c) whose objects are in the given heap, for the heap_caps_* functions
+   that report on or check the heaps.
+*/
+bool heap_caps_pool_check_heap(const heap_t *heap, bool print_errors);
+
+/* Get the information of the n-th pool in the heap. Returns false if there are n pools or less. */
+bool heap_caps_pool_get_nth_info(const heap_t *heap, size_t n, heap_caps_pool_info_t *info);
+
+/* If the allocated block at block_ptr holds the objects of a pool, call walker_func for each object
+   instead of the whole block, and return true. *proceed is set to the value returned by the last call.
+*/
+bool heap_caps_pool_walk_block(void *block_ptr, size_t block_size, walker_heap_into_t heap_info,
+                               heap_caps_walker_cb_t walker_func, void *user_data, bool *proceed);
+
 /*
  Because we don't want to add _another_ known allocation method to the stack of functions to trace wrt memory tracing,
  these are declared private. The newlib malloc()/realloc() implementation also calls these, so they are declared
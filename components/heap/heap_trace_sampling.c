@@ -0,0 +1,540 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <sys/param.h>
+#include "sdkconfig.h"
+#include <inttypes.h>
+
+#include "esp_heap_trace.h"
+#include "esp_heap_caps.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_memory_utils.h"
+
+/*
+Sampling heap profiler.
+
+Each CPU core counts down the bytes allocated on it, and the allocation which reaches zero is sampled:
+its call stack is captured and it is recorded until it is freed. The countdown is then restarted from a
+random value between 1 and twice the sample period, so that periodic allocation patterns are not always
+sampled at the same point. An allocation of 'size' bytes is thus sampled with a probability of about
+size / period, and each live sample of a call stack stands for 'period' bytes in the callsite table, or
+for its own size if it is larger.
+
+The allocations and frees which are not sampled don't capture their call stack and don't take the lock:
+an allocation only updates the countdown of its core, a free only looks at the hash bucket of its
+pointer, which is empty unless a sample shares it.
+*/
+
+#define STACK_DEPTH CONFIG_HEAP_TRACING_STACK_DEPTH
+
+#define NO_CALLSITE UINT16_MAX
+
+typedef enum {
+    TRACING_STARTED, // start recording allocs and free
+    TRACING_STOPPED, // stop recording allocs and free
+    TRACING_ALLOC_PAUSED, // stop recording allocs but keep recording free
+    TRACING_UNKNOWN // default value
+} tracing_state_t;
+
+typedef struct sample_t {
+    struct sample_t *next;  // next sample in the same hash bucket, or in the list of unused samples
+    void *address;          // NULL if the sample is unused
+    size_t size;
+    uint32_t ccount;
+    uint16_t callsite;      // index in callsites.table
+} sample_t;
+
+/* Countdown of a CPU core */
+typedef struct {
+    size_t bytes_until_sample;
+    uint32_t rand;          // state of the xorshift generator
+} sampler_t;
+
+static portMUX_TYPE trace_mux = portMUX_INITIALIZER_UNLOCKED;
+static tracing_state_t tracing = TRACING_UNKNOWN;
+static heap_trace_mode_t mode;
+
+/* Live sampled allocations */
+static struct {
+    size_t period;
+    sample_t *buffer;
+    sample_t **buckets;     // hash map of the samples in use, 'capacity' buckets
+    sample_t *unused;
+    size_t capacity;
+    size_t count;
+    size_t high_water_mark;
+    bool has_overflowed;
+} samples;
+
+/* Open addressing hash table of call stacks, entries are never removed until the next start */
+static struct {
+    heap_trace_callsite_t *table;
+    size_t capacity;
+    size_t count;
+} callsites;
+
+static sampler_t samplers[portNUM_PROCESSORS];
+
+/* Number of sampled allocations, and number of frees of sampled allocations */
+static size_t total_allocations;
+static size_t total_frees;
+
+static HEAP_IRAM_ATTR size_t next_sample_interval(sampler_t *sampler)
+{
+    uint32_t x = sampler->rand;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    sampler->rand = x;
+    return 1 + x % (2 * samples.period);
+}
+
+/* Called for each allocation, returns true if the allocation is sampled */
+static HEAP_IRAM_ATTR bool sample_alloc(size_t size)
+{
+    if (tracing != TRACING_STARTED) {
+        return false;
+    }
+
+    bool sampled = false;
+    // masking the interrupts keeps the task on its core, and protects the countdown from ISRs
+    UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    sampler_t *sampler = &samplers[xPortGetCoreID()];
+    if (size < sampler->bytes_until_sample) {
+        sampler->bytes_until_sample -= size;
+    } else {
+        sampler->bytes_until_sample = next_sample_interval(sampler);
+        sampled = true;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+    return sampled;
+}
+
+static HEAP_IRAM_ATTR size_t sample_idx(const void *p)
+{
+    static const uint32_t fnv_prime = 16777619UL;
+    return (((uint32_t)p >> 3) * fnv_prime) % samples.capacity;
+}
+
+/* Called for each free, returns false if p can't be a sampled allocation */
+static HEAP_IRAM_ATTR bool sample_free(void *p)
+{
+    // The bucket is read without the lock: if p was sampled, its sample was added
+    // before the allocation returned, so before p can be freed. The tables are only
+    // replaced or freed while the tracing is neither started nor paused.
+    return (tracing == TRACING_STARTED || tracing == TRACING_ALLOC_PAUSED) && p != NULL
+           && samples.buckets != NULL && samples.buckets[sample_idx(p)] != NULL;
+}
+
+FORCE_INLINE_ATTR size_t sample_weight(const sample_t *sample)
+{
+    return MAX(sample->size, samples.period);
+}
+
+static HEAP_IRAM_ATTR uint32_t callsite_hash(void *const *callers)
+{
+    uint32_t hash = 2166136261UL;
+    for (int i = 0; i < STACK_DEPTH; i++) {
+        hash = (hash ^ (uint32_t)callers[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+/* Return the index of the entry of a call stack, added if it isn't in the table yet,
+   or NO_CALLSITE if the table is full */
+static HEAP_IRAM_ATTR size_t callsite_find_or_add(void *const *callers)
+{
+    size_t idx = callsite_hash(callers) % callsites.capacity;
+    for (size_t n = 0; n < callsites.capacity; n++) {
+        heap_trace_callsite_t *callsite = &callsites.table[idx];
+        if (callsite->total_count == 0) {
+            memcpy(callsite->callers, callers, sizeof(void *) * STACK_DEPTH);
+            callsites.count++;
+            return idx;
+        }
+        if (memcmp(callsite->callers, callers, sizeof(void *) * STACK_DEPTH) == 0) {
+            return idx;
+        }
+        if (++idx == callsites.capacity) {
+            idx = 0;
+        }
+    }
+    return NO_CALLSITE;
+}
+
+esp_err_t heap_trace_init_sampling(size_t sample_period, size_t num_callsites, size_t num_samples)
+{
+    if ((tracing == TRACING_STARTED) || (tracing == TRACING_ALLOC_PAUSED)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    sample_t *buffer = NULL;
+    sample_t **buckets = NULL;
+    heap_trace_callsite_t *table = NULL;
+
+    if (sample_period != 0 || num_callsites != 0 || num_samples != 0) {
+        if (sample_period == 0 || sample_period > SIZE_MAX / 2
+                || num_callsites == 0 || num_callsites >= NO_CALLSITE || num_samples == 0) {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        const uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+        buffer = heap_caps_calloc(num_samples, sizeof(sample_t), caps);
+        buckets = heap_caps_calloc(num_samples, sizeof(sample_t *), caps);
+        table = heap_caps_calloc(num_callsites, sizeof(heap_trace_callsite_t), caps);
+        if (buffer == NULL || buckets == NULL || table == NULL) {
+            heap_caps_free(buffer);
+            heap_caps_free(buckets);
+            heap_caps_free(table);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    portENTER_CRITICAL(&trace_mux);
+    sample_t *old_buffer = samples.buffer;
+    sample_t **old_buckets = samples.buckets;
+    heap_trace_callsite_t *old_table = callsites.table;
+    samples.period = sample_period;
+    samples.buffer = buffer;
+    samples.buckets = buckets;
+    samples.unused = NULL;
+    samples.capacity = num_samples;
+    samples.count = 0;
+    callsites.table = table;
+    callsites.capacity = num_callsites;
+    callsites.count = 0;
+    portEXIT_CRITICAL(&trace_mux);
+
+    heap_caps_free(old_buffer);
+    heap_caps_free(old_buckets);
+    heap_caps_free(old_table);
+    return ESP_OK;
+}
+
+static esp_err_t set_tracing(tracing_state_t state)
+{
+    if (tracing == state) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    tracing = state;
+    return ESP_OK;
+}
+
+esp_err_t heap_trace_start(heap_trace_mode_t mode_param)
+{
+    if (samples.buffer == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    portENTER_CRITICAL(&trace_mux);
+
+    set_tracing(TRACING_STOPPED);
+    mode = mode_param;
+
+    // clear tables
+    memset(samples.buffer, 0, sizeof(sample_t) * samples.capacity);
+    memset(samples.buckets, 0, sizeof(sample_t *) * samples.capacity);
+    memset(callsites.table, 0, sizeof(heap_trace_callsite_t) * callsites.capacity);
+    samples.unused = NULL;
+    for (size_t i = 0; i < samples.capacity; i++) {
+        samples.buffer[i].next = samples.unused;
+        samples.unused = &samples.buffer[i];
+    }
+    samples.count = 0;
+    samples.high_water_mark = 0;
+    samples.has_overflowed = false;
+    callsites.count = 0;
+
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        samplers[i].rand = (esp_cpu_get_cycle_count() + i) | 1;
+        samplers[i].bytes_until_sample = next_sample_interval(&samplers[i]);
+    }
+
+    total_allocations = 0;
+    total_frees = 0;
+
+    const esp_err_t ret_val = set_tracing(TRACING_STARTED);
+
+    portEXIT_CRITICAL(&trace_mux);
+    return ret_val;
+}
+
+esp_err_t heap_trace_stop(void)
+{
+    portENTER_CRITICAL(&trace_mux);
+    const esp_err_t ret_val = set_tracing(TRACING_STOPPED);
+    portEXIT_CRITICAL(&trace_mux);
+    return ret_val;
+}
+
+esp_err_t heap_trace_alloc_pause(void)
+{
+    portENTER_CRITICAL(&trace_mux);
+    const esp_err_t ret_val = set_tracing(TRACING_ALLOC_PAUSED);
+    portEXIT_CRITICAL(&trace_mux);
+    return ret_val;
+}
+
+esp_err_t heap_trace_resume(void)
+{
+    portENTER_CRITICAL(&trace_mux);
+    // without tables there is no sample period to draw the sampling intervals from
+    const esp_err_t ret_val = (samples.buffer == NULL) ? ESP_ERR_INVALID_STATE : set_tracing(TRACING_STARTED);
+    portEXIT_CRITICAL(&trace_mux);
+    return ret_val;
+}
+
+size_t heap_trace_get_count(void)
+{
+    return samples.count;
+}
+
+esp_err_t heap_trace_get(size_t index, heap_trace_record_t *r_out)
+{
+    if (r_out == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t result = ESP_ERR_INVALID_ARG; /* out of range for 'count' */
+
+    portENTER_CRITICAL(&trace_mux);
+
+    // samples in use are returned in buffer order
+    for (size_t i = 0; i < samples.capacity; i++) {
+        const sample_t *sample = &samples.buffer[i];
+        if (sample->address != NULL && index-- == 0) {
+            memset(r_out, 0, sizeof(heap_trace_record_t));
+            r_out->ccount = sample->ccount;
+            r_out->address = sample->address;
+            r_out->size = sample->size;
+            memcpy(r_out->alloced_by, callsites.table[sample->callsite].callers, sizeof(void *) * STACK_DEPTH);
+            result = ESP_OK;
+            break;
+        }
+    }
+
+    portEXIT_CRITICAL(&trace_mux);
+    return result;
+}
+
+esp_err_t heap_trace_get_callsite(size_t index, heap_trace_callsite_t *callsite)
+{
+    if (callsite == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (callsites.table == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t result = ESP_ERR_INVALID_ARG;
+
+    portENTER_CRITICAL(&trace_mux);
+
+    for (size_t i = 0; i < callsites.capacity; i++) {
+        const heap_trace_callsite_t *c = &callsites.table[i];
+        if (c->total_count != 0 && index-- == 0) {
+            memcpy(callsite, c, sizeof(heap_trace_callsite_t));
+            result = ESP_OK;
+            break;
+        }
+    }
+
+    portEXIT_CRITICAL(&trace_mux);
+    return result;
+}
+
+esp_err_t heap_trace_summary(heap_trace_summary_t *summary)
+{
+    if (summary == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    portENTER_CRITICAL(&trace_mux);
+    summary->mode = mode;
+    summary->total_allocations = total_allocations;
+    summary->total_frees = total_frees;
+    summary->count = samples.count;
+    summary->capacity = samples.capacity;
+    summary->high_water_mark = samples.high_water_mark;
+    summary->has_overflowed = samples.has_overflowed;
+    summary->sample_period = samples.period;
+    summary->callsite_count = callsites.count;
+    summary->callsite_capacity = callsites.capacity;
+    portEXIT_CRITICAL(&trace_mux);
+
+    return ESP_OK;
+}
+
+static void print_callers(void *const *callers)
+{
+    if (STACK_DEPTH != 0 && callers[0] != NULL) {
+        esp_rom_printf(" caller ");
+        for (int j = 0; j < STACK_DEPTH && callers[j] != 0; j++) {
+            esp_rom_printf("%p%s", callers[j], (j < STACK_DEPTH - 1) ? ":" : "");
+        }
+    }
+    esp_rom_printf("\n");
+}
+
+static void heap_trace_dump_base(bool internal_ram, bool psram)
+{
+    portENTER_CRITICAL(&trace_mux);
+
+    size_t live_bytes = 0;
+
+    esp_rom_printf("====== Heap Trace: %"PRIu32" call stacks (%"PRIu32" capacity), 1 sample per %"PRIu32" bytes ======\n",
+        callsites.count, callsites.capacity, samples.period);
+
+    for (size_t i = 0; i < callsites.capacity; i++) {
+        const heap_trace_callsite_t *c = &callsites.table[i];
+        if (c->live_count != 0) {
+            esp_rom_printf("%6"PRIu32" bytes in %"PRIu32" live samples (%"PRIu32" sampled)",
+                c->live_bytes, c->live_count, c->total_count);
+            print_callers(c->callers);
+            live_bytes += c->live_bytes;
+        }
+    }
+
+    esp_rom_printf("====== Live Samples ======\n");
+
+    for (size_t i = 0; i < samples.capacity; i++) {
+        const sample_t *sample = &samples.buffer[i];
+
+        bool should_print = sample->address != NULL &&
+            ((psram && internal_ram) ||
+             (internal_ram && esp_ptr_internal(sample->address)) ||
+             (psram && esp_ptr_external_ram(sample->address)));
+
+        if (should_print) {
+            const char* label = "";
+            if (esp_ptr_internal(sample->address)) {
+                label = ", Internal";
+            }
+            if (esp_ptr_external_ram(sample->address)) {
+                label = ",    PSRAM";
+            }
+
+            esp_rom_printf("%6d bytes (@ %p%s) allocated CPU %d ccount 0x%08x",
+                   sample->size, sample->address, label, sample->ccount & 1, sample->ccount & ~3);
+            print_callers(callsites.table[sample->callsite].callers);
+        }
+    }
+
+    esp_rom_printf("====== Heap Trace Summary ======\n");
+    esp_rom_printf("Mode: Heap Trace Sampling\n");
+    esp_rom_printf("%"PRIu32" bytes estimated alive (%"PRIu32" samples)\n", live_bytes, samples.count);
+    esp_rom_printf("samples: %"PRIu32" (%"PRIu32" capacity, %"PRIu32" high water mark)\n",
+        samples.count, samples.capacity, samples.high_water_mark);
+    esp_rom_printf("sampled allocations: %"PRIu32"\n", total_allocations);
+    esp_rom_printf("sampled frees: %"PRIu32"\n", total_frees);
+
+    if (samples.has_overflowed) {
+        esp_rom_printf("(NB: Sample or call stack table has overflowed, so trace data is incomplete.)\n");
+    }
+    esp_rom_printf("================================\n");
+
+    portEXIT_CRITICAL(&trace_mux);
+}
+
+void heap_trace_dump(void)
+{
+    heap_trace_dump_caps(MALLOC_CAP_INTERNAL | MALLOC_CAP_SPIRAM);
+}
+
+void heap_trace_dump_caps(const uint32_t caps)
+{
+    if (samples.buffer == NULL) {
+        return;
+    }
+    heap_trace_dump_base(caps & MALLOC_CAP_INTERNAL, caps & MALLOC_CAP_SPIRAM);
+}
+
+/* Add a sampled allocation */
+static HEAP_IRAM_ATTR void record_allocation(const heap_trace_record_t *r_allocation)
+{
+    if ((tracing != TRACING_STARTED) || (r_allocation->address == NULL)) {
+        return;
+    }
+    portENTER_CRITICAL(&trace_mux);
+
+    if (tracing == TRACING_STARTED) {
+        sample_t *sample = samples.unused;
+        size_t idx = (sample != NULL) ? callsite_find_or_add(r_allocation->alloced_by) : NO_CALLSITE;
+
+        if (idx == NO_CALLSITE) {
+            samples.has_overflowed = true;
+        } else {
+            samples.unused = sample->next;
+            sample->address = r_allocation->address;
+            sample->size = r_allocation->size;
+            sample->ccount = r_allocation->ccount;
+            sample->callsite = idx;
+
+            sample_t **bucket = &samples.buckets[sample_idx(sample->address)];
+            sample->next = *bucket;
+            *bucket = sample;
+
+            heap_trace_callsite_t *callsite = &callsites.table[idx];
+            callsite->live_bytes += sample_weight(sample);
+            callsite->live_count++;
+            callsite->total_count++;
+
+            samples.count++;
+            if (samples.count > samples.high_water_mark) {
+                samples.high_water_mark = samples.count;
+            }
+            total_allocations++;
+        }
+    }
+
+    portEXIT_CRITICAL(&trace_mux);
+}
+
+/* Remove the sample of a freed allocation, if it was sampled */
+static HEAP_IRAM_ATTR void record_free(void *p, void **callers)
+{
+    (void)callers;
+
+    if (((tracing != TRACING_STARTED) && (tracing != TRACING_ALLOC_PAUSED)) || (p == NULL)) {
+        return;
+    }
+
+    portENTER_CRITICAL(&trace_mux);
+
+    if (((tracing == TRACING_STARTED) || (tracing == TRACING_ALLOC_PAUSED)) && samples.buckets != NULL) {
+        sample_t **link = &samples.buckets[sample_idx(p)];
+        while (*link != NULL && (*link)->address != p) {
+            link = &(*link)->next;
+        }
+
+        sample_t *sample = *link;
+        if (sample != NULL) {
+            *link = sample->next;
+
+            heap_trace_callsite_t *callsite = &callsites.table[sample->callsite];
+            callsite->live_bytes -= sample_weight(sample);
+            callsite->live_count--;
+
+            sample->address = NULL;
+            sample->next = samples.unused;
+            samples.unused = sample;
+
+            samples.count--;
+            total_frees++;
+        }
+    }
+
+    portEXIT_CRITICAL(&trace_mux);
+}
+
+#define HEAP_TRACE_SAMPLE_ALLOC(size) sample_alloc(size)
+#define HEAP_TRACE_SAMPLE_FREE(p) sample_free(p)
+
+#include "heap_trace.inc"
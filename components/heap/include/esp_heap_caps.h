@@ -110,6 +110,18 @@ void *heap_caps_malloc(size_t size, uint32_t caps);
  */
 void heap_caps_free( void *ptr);
 
+/**
+ * @brief Give the free blocks held in the small block caches back to the heaps
+ *
+ * When CONFIG_HEAP_SMALL_BLOCK_CACHE is enabled, each CPU core keeps some of the small blocks it
+ * frees for reuse, and these blocks are counted as allocated by the heap information functions.
+ * The caches are already emptied when an allocation fails; this function can be called before
+ * measuring free memory or when the application knows it will not allocate small blocks for a while.
+ *
+ * Does nothing if CONFIG_HEAP_SMALL_BLOCK_CACHE is disabled.
+ */
+void heap_caps_cache_flush(void);
+
 /**
  * @brief Reallocate memory previously allocated via heap_caps_malloc() or heap_caps_realloc().
  *
@@ -282,6 +294,31 @@ esp_err_t heap_caps_monitor_local_minimum_free_size_stop(void);
  */
 void heap_caps_get_info( multi_heap_info_t *info, uint32_t caps );
 
+/**
+ * @brief Get the distribution of the free memory of all regions with the given capabilities.
+ *
+ * Counts the free blocks of all heaps which share the given capabilities in power of two size classes:
+ * hist[0] counts the blocks smaller than 32 bytes, hist[i] the blocks of at least 2^(i+4) and less than
+ * 2^(i+5) bytes, and hist[hist_len - 1] also counts all the blocks larger than that. For example, with a
+ * hist_len of 12 the last entry counts the free blocks of 32 KB and more.
+ *
+ * The free lists of each heap are traversed once with its lock held, the allocated blocks are not visited.
+ *
+ * The returned fragmentation index is ``100 * (1 - largest free block / total free size)``. It is 0 when
+ * all the free memory is a single block, and tends to 100 as the free memory is split into smaller blocks.
+ * When several heaps have the given capabilities, the index is never 0 as the free memory of two heaps can't
+ * be allocated as a single block.
+ *
+ * @param caps        Bitwise OR of MALLOC_CAP_* flags indicating the type
+ *                    of memory
+ * @param hist        Array of hist_len counters, cleared and filled by this function. Can be NULL if
+ *                    hist_len is 0.
+ * @param hist_len    Number of entries in hist
+ *
+ * @return Fragmentation index in percent, 0 if there is no free memory with the given capabilities
+ */
+uint32_t heap_caps_get_fragmentation_info(uint32_t caps, size_t *hist, size_t hist_len);
+
 
 /**
  * @brief Print a summary of all memory with the given capabilities.
@@ -511,6 +548,94 @@ void heap_caps_walk(uint32_t caps, heap_caps_walker_cb_t walker_func, void *user
  */
 void heap_caps_walk_all(heap_caps_walker_cb_t walker_func, void *user_data);
 
+/**
+ * @brief Handle of an object pool created with heap_caps_pool_create()
+ */
+typedef struct heap_caps_pool *heap_caps_pool_handle_t;
+
+/**
+ * @brief Information about an object pool, see heap_caps_pool_get_info()
+ */
+typedef struct {
+    void *start;                ///< Address of the first object of the pool
+    size_t obj_size;            ///< Size of each object, in bytes, rounded up to a multiple of 4
+    size_t total_count;         ///< Number of objects in the pool
+    size_t free_count;          ///< Number of objects which can be allocated
+    size_t minimum_free_count;  ///< Lowest number of free objects since the pool was created
+    uint32_t caps;              ///< Capabilities the pool was created with
+} heap_caps_pool_info_t;
+
+/**
+ * @brief Create a pool of objects of the same size which have the given capabilities
+ *
+ * The memory for all the objects is allocated at once, with heap_caps_malloc(). Objects are then
+ * allocated and freed in constant time, and using the pool does not fragment the heaps.
+ *
+ * The objects of a pool are checked by heap_caps_check_integrity(), reported by heap_caps_walk()
+ * as blocks of obj_size bytes, and listed by heap_caps_print_heap_info().
+ *
+ * @param obj_size Size of each object, in bytes. Objects are aligned to 4 bytes.
+ * @param count    Number of objects in the pool
+ * @param caps     Bitwise OR of MALLOC_CAP_* flags indicating the type of memory for the objects
+ *
+ * @return Handle of the pool, or NULL if the arguments are invalid or there is not enough memory
+ */
+heap_caps_pool_handle_t heap_caps_pool_create(size_t obj_size, size_t count, uint32_t caps);
+
+/**
+ * @brief Delete a pool and free its memory
+ *
+ * Objects which have not been freed become invalid.
+ *
+ * @param pool Pool to delete. Can be NULL.
+ */
+void heap_caps_pool_delete(heap_caps_pool_handle_t pool);
+
+/**
+ * @brief Allocate an object from a pool
+ *
+ * Can be called from an ISR, in the same conditions as heap_caps_malloc().
+ *
+ * @param pool Pool
+ *
+ * @return Pointer to the object, or NULL if all the objects of the pool are allocated.
+ *         The content of the object is undefined.
+ */
+void *heap_caps_pool_alloc(heap_caps_pool_handle_t pool);
+
+/**
+ * @brief Return an object to its pool
+ *
+ * Aborts if ptr is not an object of the pool, or if the object is already free.
+ *
+ * @param pool Pool the object was allocated from
+ * @param ptr  Object returned by heap_caps_pool_alloc(). Can be NULL.
+ */
+void heap_caps_pool_free(heap_caps_pool_handle_t pool, void *ptr);
+
+/**
+ * @brief Get information about a pool
+ *
+ * @param pool Pool
+ * @param info Filled with the information about the pool
+ */
+void heap_caps_pool_get_info(heap_caps_pool_handle_t pool, heap_caps_pool_info_t *info);
+
+/**
+ * @brief Check the integrity of a pool
+ *
+ * Checks that the list of free objects is consistent with the objects which are allocated. A
+ * free object whose first word was overwritten, for example by a use after free, is detected.
+ *
+ * heap_caps_check_integrity() checks all the pools whose objects are in the heaps it checks.
+ *
+ * @param pool         Pool
+ * @param print_errors Print specific errors if the pool is corrupt
+ *
+ * @return True if the pool is valid, False if it is corrupt
+ */
+bool heap_caps_pool_check_integrity(heap_caps_pool_handle_t pool, bool print_errors);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -57,8 +57,23 @@ typedef struct {
     size_t total_hashmap_hits;       ///< If hashmap is used, the total number of hits
     size_t total_hashmap_miss;       ///< If hashmap is used, the total number of misses (possibly due to overflow)
 #endif
+#if CONFIG_HEAP_TRACING_SAMPLING
+    size_t sample_period;            ///< Average number of allocated bytes between two sampled allocations
+    size_t callsite_count;           ///< The number of call stacks in the callsite table
+    size_t callsite_capacity;        ///< The capacity of the callsite table
+#endif
 } heap_trace_summary_t;
 
+/**
+ * @brief Allocations sampled from one call stack by the sampling profiler.
+ */
+typedef struct {
+    void *callers[CONFIG_HEAP_TRACING_STACK_DEPTH]; ///< Call stack of the allocations
+    size_t live_bytes;               ///< Estimated number of bytes allocated from this call stack and not freed
+    size_t live_count;               ///< Number of sampled allocations from this call stack which are not freed
+    size_t total_count;              ///< Number of allocations sampled from this call stack since tracing started
+} heap_trace_callsite_t;
+
 /**
  * @brief Initialise heap tracing in standalone mode.
  *
@@ -87,6 +102,44 @@ esp_err_t heap_trace_init_standalone(heap_trace_record_t *record_buffer, size_t
  */
 esp_err_t heap_trace_init_tohost(void);
 
+/**
+ * @brief Initialise heap tracing in sampling mode.
+ *
+ * This function must be called before any other heap tracing functions.
+ *
+ * In sampling mode, about one allocation per sample_period allocated bytes is recorded with its call stack.
+ * Sampled allocations are kept until they are freed, and aggregated by call stack into a table of estimated
+ * live bytes: heap_trace_dump() prints it, heap_trace_get_callsite() returns its entries.
+ *
+ * The tables are allocated from internal memory. Calling this function again replaces them. To disable
+ * heap tracing and free the tables, stop tracing and then call heap_trace_init_sampling(0, 0, 0);
+ *
+ * @param sample_period Average number of allocated bytes between two sampled allocations. The interval
+ * between two samples is randomized around this value.
+ * @param num_callsites Capacity of the table of call stacks.
+ * @param num_samples Maximum number of sampled allocations which are not freed.
+ * @return
+ *  - ESP_ERR_INVALID_STATE Heap tracing is currently in progress.
+ *  - ESP_ERR_INVALID_ARG One of the arguments is 0 but not all of them, or num_callsites is larger than 65534.
+ *  - ESP_ERR_NO_MEM Not enough memory for the tables.
+ *  - ESP_OK Heap tracing initialised successfully.
+ */
+esp_err_t heap_trace_init_sampling(size_t sample_period, size_t num_callsites, size_t num_samples);
+
+/**
+ * @brief Return an entry of the callsite table of the sampling profiler
+ *
+ * @note It is safe to call this function while heap tracing is running.
+ *
+ * @param index Index (zero-based) of the entry, less than the callsite_count returned by heap_trace_summary().
+ * @param[out] callsite Where the entry is copied.
+ * @return
+ * - ESP_ERR_INVALID_STATE Heap tracing was not initialised with heap_trace_init_sampling().
+ * - ESP_ERR_INVALID_ARG Index is out of bounds, or callsite is NULL.
+ * - ESP_OK Entry returned successfully.
+ */
+esp_err_t heap_trace_get_callsite(size_t index, heap_trace_callsite_t *callsite);
+
 /**
  * @brief Start heap tracing. All heap allocations & frees will be traced, until heap_trace_stop() is called.
  *
@@ -140,7 +193,7 @@ esp_err_t heap_trace_alloc_pause(void);
  *
  * @return
  * - ESP_ERR_NOT_SUPPORTED Project was compiled without heap tracing enabled in menuconfig.
- * - ESP_ERR_INVALID_STATE Heap tracing was already started.
+ * - ESP_ERR_INVALID_STATE Heap tracing was already started, or in sampling mode, the tables were not set via heap_trace_init_sampling().
  * - ESP_OK Heap tracing resumed.
  */
 esp_err_t heap_trace_resume(void);
@@ -181,6 +234,9 @@ void heap_trace_dump(void);
 /**
  * @brief Dump heap trace from the memory of the capabilities passed as parameter.
  *
+ * @note In sampling mode, the callsite table is dumped and caps only selects the
+ * sampled allocations which are listed after it.
+ *
  * @param caps Capability(ies) of the memory from which to dump the trace.
  * Set MALLOC_CAP_INTERNAL to dump heap trace data from internal memory.
  * Set MALLOC_CAP_SPIRAM to dump heap trace data from PSRAM.
@@ -207,6 +207,28 @@ size_t multi_heap_reset_minimum_free_bytes(multi_heap_handle_t heap);
  */
 void multi_heap_restore_minimum_free_bytes(multi_heap_handle_t heap, const size_t new_minimum_free_bytes_value);
 
+/**
+ * @brief Count the free blocks of a heap by size
+ *
+ * Free blocks are counted in power of two size classes: hist[0] counts the blocks smaller than 32 bytes,
+ * hist[i] the blocks of at least 2^(i+4) and less than 2^(i+5) bytes, and the last entry also counts all
+ * the blocks larger than that. Sizes are the sizes of the free blocks in the heap, they do not account
+ * for the overhead of an allocation.
+ *
+ * The counters and totals are added to the values passed in, so that the results of several heaps can be
+ * accumulated.
+ *
+ * Only the free lists of the heap are visited while its lock is held, the allocated blocks are not (all the
+ * blocks are visited when the TLSF implementation in ROM is used).
+ *
+ * @param heap Handle to a registered heap.
+ * @param hist Array of hist_len counters, can be NULL if hist_len is 0.
+ * @param hist_len Number of entries in hist.
+ * @param total_free If not NULL, the sum of the sizes of the free blocks is added to the value it points to.
+ * @param largest_free If not NULL, set to the size of the largest free block if larger than the value it points to.
+ */
+void multi_heap_get_free_histogram(multi_heap_handle_t heap, size_t *hist, size_t hist_len, size_t *total_free, size_t *largest_free);
+
 /**
  * @brief Callback called when walking the given heap blocks of memory
  *
@@ -25,6 +25,11 @@
 /* Defines compile-time configuration macros */
 #include "multi_heap_config.h"
 
+#if !CONFIG_HEAP_TLSF_USE_ROM_IMPL
+/* Gives access to the free lists of the heaps */
+#include "tlsf_control_functions.h"
+#endif
+
 #if (!defined MULTI_HEAP_POISONING)
 
 void *multi_heap_aligned_alloc_offs(multi_heap_handle_t heap, size_t size, size_t alignment, size_t offset)
@@ -482,3 +487,72 @@ void multi_heap_restore_minimum_free_bytes(multi_heap_handle_t heap, const size_
     heap->minimum_free_bytes = MIN(heap->minimum_free_bytes, new_minimum_free_bytes_value);
     multi_heap_internal_unlock(heap);
 }
+
+typedef struct free_histogram_data {
+    size_t *hist;
+    size_t hist_len;
+    size_t total_free;
+    size_t largest_free;
+} free_histogram_data_t;
+
+static void free_histogram_add(free_histogram_data_t *data, size_t size)
+{
+    data->total_free += size;
+    data->largest_free = MAX(data->largest_free, size);
+    if (data->hist_len > 0) {
+        /* hist[i] counts the blocks of [2^(i+4), 2^(i+5)) bytes */
+        int bucket = (int)(31 - __builtin_clz(size | 1)) - 4;
+        bucket = MAX(bucket, 0);
+        data->hist[MIN((size_t)bucket, data->hist_len - 1)]++;
+    }
+}
+
+#if CONFIG_HEAP_TLSF_USE_ROM_IMPL
+/* The control structure of the TLSF implementation in ROM is not known here, all the blocks are walked */
+__attribute__((noinline)) static bool multi_heap_get_free_histogram_tlsf(void* ptr, size_t size, int used, void* user)
+{
+    if (!used) {
+        free_histogram_add(user, size);
+    }
+    return true;
+}
+#endif
+
+void multi_heap_get_free_histogram(multi_heap_handle_t heap, size_t *hist, size_t hist_len, size_t *total_free, size_t *largest_free)
+{
+    free_histogram_data_t data = {
+        .hist = hist,
+        .hist_len = hist_len,
+    };
+
+    if (heap == NULL) {
+        return;
+    }
+
+    multi_heap_internal_lock(heap);
+#if CONFIG_HEAP_TLSF_USE_ROM_IMPL
+    tlsf_walk_pool(tlsf_get_pool(heap->heap_data), multi_heap_get_free_histogram_tlsf, &data);
+#else
+    /* Only the free lists of the non-empty size classes are visited, so that the time the lock is held
+       doesn't depend on the number of allocated blocks */
+    control_t *control = (control_t *)heap->heap_data;
+    for (unsigned int fl_map = control->fl_bitmap; fl_map != 0; fl_map &= fl_map - 1) {
+        const int fl = __builtin_ctz(fl_map);
+        for (unsigned int sl_map = control->sl_bitmap[fl]; sl_map != 0; sl_map &= sl_map - 1) {
+            const int sl = __builtin_ctz(sl_map);
+            for (block_header_t *block = control->blocks[fl * control->sl_index_count + sl];
+                 block != &control->block_null; block = block->next_free) {
+                free_histogram_add(&data, block_size(block));
+            }
+        }
+    }
+#endif
+    multi_heap_internal_unlock(heap);
+
+    if (total_free != NULL) {
+        *total_free += data.total_free;
+    }
+    if (largest_free != NULL) {
+        *largest_free = MAX(*largest_free, data.largest_free);
+    }
+}
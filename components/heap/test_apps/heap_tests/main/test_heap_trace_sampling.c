@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+/*
+ Tests for the sampling heap profiler
+
+ Only compiled in if CONFIG_HEAP_TRACING_SAMPLING is set
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sdkconfig.h"
+#include "unity.h"
+#include "esp_heap_caps.h"
+
+#ifdef CONFIG_HEAP_TRACING_SAMPLING
+
+#include "esp_heap_trace.h"
+
+#define SAMPLE_PERIOD   256
+#define NUM_LEAKS       400
+#define LEAK_SIZE       64
+
+static void *leaks[NUM_LEAKS];
+
+static __attribute__((noinline)) void *leaking_function(void)
+{
+    return heap_caps_malloc(LEAK_SIZE, MALLOC_CAP_INTERNAL);
+}
+
+/* Return the index of the callsite with the most live bytes */
+static size_t largest_callsite(heap_trace_callsite_t *largest)
+{
+    heap_trace_callsite_t callsite;
+    size_t largest_idx = SIZE_MAX;
+    memset(largest, 0, sizeof(heap_trace_callsite_t));
+    for (size_t i = 0; heap_trace_get_callsite(i, &callsite) == ESP_OK; i++) {
+        if (callsite.live_bytes > largest->live_bytes) {
+            *largest = callsite;
+            largest_idx = i;
+        }
+    }
+    return largest_idx;
+}
+
+TEST_CASE("sampling heap trace estimates the live bytes of a call stack", "[heap-trace-sampling]")
+{
+    printf("Sampling test\n"); // Print something before trace starts, or stdout allocations are sampled
+    fflush(stdout);
+
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_init_sampling(SAMPLE_PERIOD, 64, 512));
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_start(HEAP_TRACE_LEAKS));
+
+    for (int i = 0; i < NUM_LEAKS; i++) {
+        leaks[i] = leaking_function();
+        TEST_ASSERT_NOT_NULL(leaks[i]);
+        void *tmp = heap_caps_malloc(2 * LEAK_SIZE, MALLOC_CAP_INTERNAL);
+        TEST_ASSERT_NOT_NULL(tmp);
+        heap_caps_free(tmp);
+    }
+
+    heap_trace_summary_t summary;
+    heap_trace_summary(&summary);
+    TEST_ASSERT_EQUAL(SAMPLE_PERIOD, summary.sample_period);
+    TEST_ASSERT_FALSE(summary.has_overflowed);
+    TEST_ASSERT_GREATER_THAN(0, summary.total_allocations);
+    TEST_ASSERT_GREATER_THAN(0, summary.total_frees);
+    TEST_ASSERT_EQUAL(summary.total_allocations - summary.total_frees, summary.count);
+    TEST_ASSERT_EQUAL(summary.count, heap_trace_get_count());
+
+    // the leaking call stack has the most live bytes, with an estimation close to the actual leak
+    heap_trace_callsite_t leak;
+    size_t leak_idx = largest_callsite(&leak);
+    printf("estimated %d bytes in %d samples, leaked %d bytes\n", leak.live_bytes, leak.live_count, NUM_LEAKS * LEAK_SIZE);
+    TEST_ASSERT_NOT_EQUAL(SIZE_MAX, leak_idx);
+    TEST_ASSERT_GREATER_THAN(NUM_LEAKS * LEAK_SIZE / 2, leak.live_bytes);
+    TEST_ASSERT_LESS_THAN(NUM_LEAKS * LEAK_SIZE * 2, leak.live_bytes);
+    TEST_ASSERT_EQUAL(leak.live_count * SAMPLE_PERIOD, leak.live_bytes);
+
+    heap_trace_record_t record;
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_get(0, &record));
+    TEST_ASSERT_NOT_NULL(record.address);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_trace_get(summary.count, &record));
+
+    heap_trace_dump();
+
+    for (int i = 0; i < NUM_LEAKS; i++) {
+        heap_caps_free(leaks[i]);
+    }
+
+    heap_trace_callsite_t freed;
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_get_callsite(leak_idx, &freed));
+    TEST_ASSERT_EQUAL_MEMORY(leak.callers, freed.callers, sizeof(leak.callers));
+    TEST_ASSERT_EQUAL(0, freed.live_count);
+    TEST_ASSERT_EQUAL(0, freed.live_bytes);
+    TEST_ASSERT_EQUAL(leak.total_count, freed.total_count);
+
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_init_sampling(0, 0, 0));
+}
+
+TEST_CASE("sampling heap trace records every allocation larger than the period", "[heap-trace-sampling]")
+{
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_init_sampling(SAMPLE_PERIOD, 16, 16));
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_start(HEAP_TRACE_LEAKS));
+
+    void *p = heap_caps_malloc(2 * SAMPLE_PERIOD, MALLOC_CAP_INTERNAL);
+    TEST_ASSERT_NOT_NULL(p);
+    heap_trace_alloc_pause();
+
+    heap_trace_record_t record = {};
+    for (size_t i = 0; heap_trace_get(i, &record) == ESP_OK && record.address != p; i++) {
+    }
+    TEST_ASSERT_EQUAL_PTR(p, record.address);
+    TEST_ASSERT_EQUAL(2 * SAMPLE_PERIOD, record.size);
+
+    // frees are still recorded while allocations are paused
+    size_t count = heap_trace_get_count();
+    heap_caps_free(p);
+    TEST_ASSERT_EQUAL(count - 1, heap_trace_get_count());
+
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_init_sampling(0, 0, 0));
+}
+
+TEST_CASE("sampling heap trace checks its state and arguments", "[heap-trace-sampling]")
+{
+    heap_trace_callsite_t callsite;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, heap_trace_start(HEAP_TRACE_LEAKS));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, heap_trace_resume());
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, heap_trace_get_callsite(0, &callsite));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_trace_init_sampling(0, 16, 16));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_trace_init_sampling(SAMPLE_PERIOD, 0, 16));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_trace_init_sampling(SAMPLE_PERIOD, 16, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_trace_init_sampling(SAMPLE_PERIOD, UINT16_MAX, 16));
+
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_init_sampling(SAMPLE_PERIOD, 16, 16));
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_start(HEAP_TRACE_LEAKS));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, heap_trace_init_sampling(SAMPLE_PERIOD, 16, 16));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, heap_trace_get_callsite(0, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_stop());
+    TEST_ASSERT_EQUAL(ESP_OK, heap_trace_init_sampling(0, 0, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, heap_trace_resume());
+}
+
+#endif // CONFIG_HEAP_TRACING_SAMPLING
@@ -290,3 +290,61 @@ TEST_CASE("test allocation and free function hooks", "[heap]")
     TEST_ASSERT_TRUE(test_success);
 }
 #endif
+
+#if CONFIG_HEAP_SMALL_BLOCK_CACHE
+TEST_CASE("small block cache reuses freed blocks", "[heap][heap_cache]")
+{
+    heap_caps_cache_flush();
+    void *p = heap_caps_malloc(20, MALLOC_CAP_DEFAULT);
+    TEST_ASSERT_NOT_NULL(p);
+    // rounded up to the 24-byte class
+    TEST_ASSERT_EQUAL(24, heap_caps_get_allocated_size(p));
+
+    size_t free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    heap_caps_free(p);
+    // kept in the cache, not given back to the heap
+    TEST_ASSERT_EQUAL(free_size, heap_caps_get_free_size(MALLOC_CAP_8BIT));
+
+    void *q = heap_caps_malloc(17, MALLOC_CAP_DEFAULT);
+    TEST_ASSERT_EQUAL_PTR(p, q);
+    heap_caps_free(q);
+
+    heap_caps_cache_flush();
+    TEST_ASSERT_GREATER_THAN(free_size, heap_caps_get_free_size(MALLOC_CAP_8BIT));
+}
+
+TEST_CASE("small block cache is flushed when an allocation fails", "[heap][heap_cache]")
+{
+    // fill the cache of the largest class
+    void *blocks[CONFIG_HEAP_SMALL_BLOCK_CACHE_DEPTH];
+    for (int i = 0; i < CONFIG_HEAP_SMALL_BLOCK_CACHE_DEPTH; i++) {
+        blocks[i] = heap_caps_malloc(128, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    for (int i = 0; i < CONFIG_HEAP_SMALL_BLOCK_CACHE_DEPTH; i++) {
+        heap_caps_free(blocks[i]);
+    }
+
+    // exhaust internal memory with blocks of a smaller class, each block points to the previous one
+    void **last = NULL;
+    const size_t sizes[] = { 1024, 64 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        void **block;
+        while ((block = heap_caps_malloc(sizes[i], MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)) != NULL) {
+            *block = last;
+            last = block;
+        }
+    }
+
+    // the failed allocation emptied the cache, so that its blocks could be used
+    size_t free_size = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    heap_caps_cache_flush();
+    TEST_ASSERT_EQUAL(free_size, heap_caps_get_free_size(MALLOC_CAP_8BIT));
+
+    while (last != NULL) {
+        void **prev = *last;
+        heap_caps_free(last);
+        last = prev;
+    }
+}
+#endif // CONFIG_HEAP_SMALL_BLOCK_CACHE
@@ -9,6 +9,7 @@
 
 #include <esp_types.h>
 #include <stdio.h>
+#include <inttypes.h>
 #include "unity.h"
 #include "esp_attr.h"
 #include "esp_heap_caps.h"
@@ -227,6 +228,50 @@ TEST_CASE("heap caps minimum free bytes fault cases", "[heap]")
     TEST_ASSERT_NOT_EQUAL(ret_val, ESP_OK);
 }
 
+TEST_CASE("heap caps fragmentation info counts the free blocks by size", "[heap]")
+{
+    const int NUM_BLOCKS = 40;
+    const size_t block_size = 200; // larger than the blocks kept by the small block cache
+    const uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    size_t hist[12];
+    size_t before[12];
+    void *blocks[NUM_BLOCKS];
+
+    heap_caps_get_fragmentation_info(caps, before, 12);
+    for (int i = 0; i < NUM_BLOCKS; i++) {
+        blocks[i] = heap_caps_malloc(block_size, caps);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    uint32_t index_allocated = heap_caps_get_fragmentation_info(caps, NULL, 0);
+
+    // every other block freed, none of them can merge with its neighbours
+    for (int i = 0; i < NUM_BLOCKS; i += 2) {
+        heap_caps_free(blocks[i]);
+    }
+    uint32_t index_holes = heap_caps_get_fragmentation_info(caps, hist, 12);
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, caps);
+
+    // the histogram counts every free block once
+    size_t total = 0;
+    for (int i = 0; i < 12; i++) {
+        total += hist[i];
+    }
+    TEST_ASSERT_EQUAL(info.free_blocks, total);
+    // 200 bytes blocks are counted in hist[3], [128, 256)
+    TEST_ASSERT(hist[3] >= before[3] + NUM_BLOCKS / 2 - 2);
+
+    printf("fragmentation index %"PRIu32" -> %"PRIu32"\n", index_allocated, index_holes);
+    TEST_ASSERT(index_holes >= index_allocated);
+    TEST_ASSERT(index_holes <= 100);
+
+    for (int i = 1; i < NUM_BLOCKS; i += 2) {
+        heap_caps_free(blocks[i]);
+    }
+    heap_caps_get_fragmentation_info(caps, hist, 12);
+    TEST_ASSERT_INT32_WITHIN(2, before[3], hist[3]);
+}
+
 /* Small function runs from IRAM to check that malloc/free/realloc
    all work OK when cache is disabled...
 */
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <string.h>
+#include "unity.h"
+#include "esp_heap_caps.h"
+
+#define OBJ_SIZE    62
+#define OBJ_COUNT   40
+
+TEST_CASE("pool objects are allocated until the pool is empty", "[heap][pool]")
+{
+    heap_caps_pool_handle_t pool = heap_caps_pool_create(OBJ_SIZE, OBJ_COUNT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(pool);
+
+    heap_caps_pool_info_t info;
+    heap_caps_pool_get_info(pool, &info);
+    TEST_ASSERT_EQUAL(64, info.obj_size);
+    TEST_ASSERT_EQUAL(OBJ_COUNT, info.total_count);
+    TEST_ASSERT_EQUAL(OBJ_COUNT, info.free_count);
+    TEST_ASSERT_TRUE(heap_caps_get_allocated_size(info.start) >= OBJ_COUNT * info.obj_size);
+
+    void *objs[OBJ_COUNT];
+    for (int i = 0; i < OBJ_COUNT; i++) {
+        objs[i] = heap_caps_pool_alloc(pool);
+        TEST_ASSERT_NOT_NULL(objs[i]);
+        TEST_ASSERT_EQUAL(0, (intptr_t)objs[i] % 4);
+        memset(objs[i], i, OBJ_SIZE);
+    }
+    TEST_ASSERT_NULL(heap_caps_pool_alloc(pool));
+    for (int i = 0; i < OBJ_COUNT; i++) {
+        TEST_ASSERT_EACH_EQUAL_UINT8(i, objs[i], OBJ_SIZE);
+    }
+    TEST_ASSERT_TRUE(heap_caps_pool_check_integrity(pool, true));
+
+    heap_caps_pool_free(pool, objs[7]);
+    heap_caps_pool_free(pool, NULL);
+    TEST_ASSERT_EQUAL_PTR(objs[7], heap_caps_pool_alloc(pool));
+
+    for (int i = 0; i < OBJ_COUNT; i++) {
+        heap_caps_pool_free(pool, objs[i]);
+    }
+    heap_caps_pool_get_info(pool, &info);
+    TEST_ASSERT_EQUAL(OBJ_COUNT, info.free_count);
+    TEST_ASSERT_EQUAL(0, info.minimum_free_count);
+    TEST_ASSERT_TRUE(heap_caps_check_integrity_all(true));
+
+    heap_caps_pool_delete(pool);
+}
+
+TEST_CASE("pool integrity check detects a corrupted free object", "[heap][pool]")
+{
+    heap_caps_pool_handle_t pool = heap_caps_pool_create(OBJ_SIZE, OBJ_COUNT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(pool);
+    uint32_t *obj = heap_caps_pool_alloc(pool);
+    heap_caps_pool_free(pool, obj);
+
+    // use after free
+    uint32_t link = obj[0];
+    obj[0] = 0xDEADBEEF;
+    TEST_ASSERT_FALSE(heap_caps_pool_check_integrity(pool, true));
+    TEST_ASSERT_FALSE(heap_caps_check_integrity(MALLOC_CAP_INTERNAL, true));
+    TEST_ASSERT_FALSE(heap_caps_check_integrity_addr((intptr_t)obj, true));
+
+    obj[0] = link;
+    TEST_ASSERT_TRUE(heap_caps_pool_check_integrity(pool, true));
+    TEST_ASSERT_TRUE(heap_caps_check_integrity_all(true));
+
+    heap_caps_pool_delete(pool);
+}
+
+typedef struct {
+    heap_caps_pool_info_t info;
+    size_t used;
+    size_t free;
+} pool_walk_data_t;
+
+static bool pool_walker(walker_heap_into_t heap_info, walker_block_info_t block_info, void *user_data)
+{
+    pool_walk_data_t *data = (pool_walk_data_t *)user_data;
+    uint8_t *start = data->info.start;
+    uint8_t *ptr = block_info.ptr;
+    if (ptr >= start && ptr < start + data->info.total_count * data->info.obj_size) {
+        TEST_ASSERT_EQUAL(data->info.obj_size, block_info.size);
+        TEST_ASSERT_EQUAL(0, (ptr - start) % data->info.obj_size);
+        if (block_info.used) {
+            data->used++;
+        } else {
+            data->free++;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("heap walker reports the objects of a pool", "[heap][pool]")
+{
+    heap_caps_pool_handle_t pool = heap_caps_pool_create(OBJ_SIZE, OBJ_COUNT, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL(pool);
+    void *objs[3];
+    for (int i = 0; i < 3; i++) {
+        objs[i] = heap_caps_pool_alloc(pool);
+    }
+
+    pool_walk_data_t data = {};
+    heap_caps_pool_get_info(pool, &data.info);
+    heap_caps_walk_all(pool_walker, &data);
+    TEST_ASSERT_EQUAL(3, data.used);
+    TEST_ASSERT_EQUAL(OBJ_COUNT - 3, data.free);
+
+    heap_caps_print_heap_info(MALLOC_CAP_INTERNAL);
+
+    for (int i = 0; i < 3; i++) {
+        heap_caps_pool_free(pool, objs[i]);
+    }
+    heap_caps_pool_delete(pool);
+}
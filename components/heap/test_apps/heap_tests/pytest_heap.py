@@ -34,6 +34,13 @@ def test_heap_poisoning_qemu(dut: Dut) -> None:
             dut._run_normal_case(case)
 
 
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['small_block_cache'])
+@idf_parametrize('target', ['supported_targets'], indirect=['target'])
+def test_heap_small_block_cache(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='heap_cache')
+
+
 @pytest.mark.generic
 @pytest.mark.parametrize('config', ['in_flash'])
 @idf_parametrize('target', ['supported_targets'], indirect=['target'])
@@ -85,6 +92,19 @@ def test_heap_trace_dump(dut: Dut) -> None:
     dut.run_all_single_board_cases(group='heap-trace')
 
 
+@pytest.mark.generic
+@idf_parametrize(
+    'config,target',
+    [
+        ('heap_trace_sampling_esp32', 'esp32'),
+        ('heap_trace_sampling_esp32c3', 'esp32c3'),
+    ],
+    indirect=['config', 'target'],
+)
+def test_heap_trace_sampling(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='heap-trace-sampling')
+
+
 @pytest.mark.generic
 @pytest.mark.temp_skip_ci(targets=['esp32c61'], reason='support TBD')  # TODO [ESP32C61] IDF-9858 IDF-10989
 @pytest.mark.parametrize('config', ['mem_prot'])
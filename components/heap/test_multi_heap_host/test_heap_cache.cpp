@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "catch.hpp"
+#include "multi_heap.h"
+#include "../heap_cache.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#define CAPS_INTERNAL   (1 << 0)
+#define CAPS_DMA        (1 << 1)
+
+/* Allocation and free through a cache, as done by heap_caps_base.c when
+   CONFIG_HEAP_SMALL_BLOCK_CACHE is enabled */
+static void *cached_malloc(heap_cache_t *cache, multi_heap_handle_t heap, size_t size)
+{
+    int cls = heap_cache_size_class(size);
+    if (cls >= 0) {
+        size = heap_cache_class_size(cls);
+        void *cached = heap_cache_get(cache, cls, CAPS_INTERNAL);
+        if (cached != NULL) {
+            return cached;
+        }
+    }
+    return multi_heap_malloc(heap, size);
+}
+
+static void cached_free(heap_cache_t *cache, multi_heap_handle_t heap, void *p)
+{
+    size_t size = multi_heap_get_allocated_size(heap, p);
+    int cls = heap_cache_size_class(size);
+    if (cls >= 0 && heap_cache_class_size(cls) == size
+            && heap_cache_put(cache, cls, p, heap, CAPS_INTERNAL)) {
+        return;
+    }
+    multi_heap_free(heap, p);
+}
+
+static void cache_flush(heap_cache_t *cache)
+{
+    heap_cache_block_t *block = heap_cache_take_all(cache);
+    while (block != NULL) {
+        heap_cache_block_t *next = block->next;
+        multi_heap_free((multi_heap_handle_t)block->heap, block);
+        block = next;
+    }
+}
+
+TEST_CASE("heap_cache size classes", "[heap_cache]")
+{
+    REQUIRE( heap_cache_size_class(0) == -1 );
+    REQUIRE( heap_cache_size_class(HEAP_CACHE_MAX_SIZE + 1) == -1 );
+    for (size_t size = 1; size <= HEAP_CACHE_MAX_SIZE; size++) {
+        int cls = heap_cache_size_class(size);
+        REQUIRE( cls >= 0 );
+        REQUIRE( cls < HEAP_CACHE_CLASSES );
+        // the smallest class which fits
+        REQUIRE( heap_cache_class_size(cls) >= size );
+        if (cls > 0) {
+            REQUIRE( heap_cache_class_size(cls - 1) < size );
+        }
+    }
+}
+
+TEST_CASE("heap_cache returns blocks of the same class and matching caps", "[heap_cache]")
+{
+    uint8_t blocks[4][32];
+    int dummy_heap;
+    heap_cache_t cache = {};
+    cache.depth = 3;
+
+    int cls = heap_cache_size_class(32);
+    REQUIRE( heap_cache_get(&cache, cls, CAPS_INTERNAL) == NULL );
+
+    REQUIRE( heap_cache_put(&cache, cls, blocks[0], &dummy_heap, CAPS_INTERNAL) );
+    REQUIRE( heap_cache_put(&cache, cls, blocks[1], &dummy_heap, CAPS_INTERNAL | CAPS_DMA) );
+    REQUIRE( heap_cache_put(&cache, cls, blocks[2], &dummy_heap, CAPS_INTERNAL) );
+    // class is full
+    REQUIRE_FALSE( heap_cache_put(&cache, cls, blocks[3], &dummy_heap, CAPS_INTERNAL) );
+
+    REQUIRE( heap_cache_get(&cache, heap_cache_size_class(16), CAPS_INTERNAL) == NULL );
+    REQUIRE( heap_cache_get(&cache, cls, CAPS_INTERNAL) == blocks[2] );
+    // most recent block doesn't have the caps
+    REQUIRE( heap_cache_get(&cache, cls, CAPS_INTERNAL | CAPS_DMA) == blocks[1] );
+    REQUIRE( heap_cache_get(&cache, cls, CAPS_INTERNAL | CAPS_DMA) == NULL );
+    REQUIRE( heap_cache_get(&cache, cls, CAPS_INTERNAL) == blocks[0] );
+    REQUIRE( heap_cache_get(&cache, cls, CAPS_INTERNAL) == NULL );
+}
+
+TEST_CASE("heap_cache flush gives all blocks back to the heap", "[heap_cache]")
+{
+    const size_t HEAP_SIZE = 8 * 1024;
+    std::vector<uint8_t> heap_data(HEAP_SIZE);
+    multi_heap_handle_t heap = multi_heap_register(heap_data.data(), HEAP_SIZE);
+    size_t initial_free = multi_heap_free_size(heap);
+    heap_cache_t cache = {};
+    cache.depth = 8;
+
+    std::vector<void *> ptrs;
+    for (size_t size = 1; size <= HEAP_CACHE_MAX_SIZE; size += 7) {
+        void *p = cached_malloc(&cache, heap, size);
+        REQUIRE( p != NULL );
+        memset(p, 0xAA, size);
+        ptrs.push_back(p);
+    }
+    for (void *p : ptrs) {
+        cached_free(&cache, heap, p);
+    }
+    REQUIRE( multi_heap_free_size(heap) < initial_free );
+    REQUIRE( multi_heap_check(heap, true) );
+
+    cache_flush(&cache);
+    REQUIRE( multi_heap_free_size(heap) == initial_free );
+    for (int cls = 0; cls < HEAP_CACHE_CLASSES; cls++) {
+        REQUIRE( cache.count[cls] == 0 );
+        REQUIRE( cache.blocks[cls] == NULL );
+    }
+}
+
+TEST_CASE("heap_cache benchmark: small allocations with and without a cache", "[heap_cache]")
+{
+    const size_t HEAP_SIZE = 64 * 1024;
+    const size_t LIVE = 64;
+    const int ROUNDS = 200000;
+    std::vector<uint8_t> heap_data(HEAP_SIZE);
+    multi_heap_handle_t heap = multi_heap_register(heap_data.data(), HEAP_SIZE);
+    heap_cache_t cache = {};
+    cache.depth = 8;
+
+    // a window of live blocks, one of which is replaced by a new allocation at each step
+    std::mt19937 rng(1);
+    std::vector<size_t> sizes(ROUNDS);
+    std::vector<size_t> slots(ROUNDS);
+    for (int i = 0; i < ROUNDS; i++) {
+        sizes[i] = 1 + rng() % HEAP_CACHE_MAX_SIZE;
+        slots[i] = rng() % LIVE;
+    }
+
+    printf("%-10s  %-16s\n", "Allocator", "malloc+free [ns]");
+    for (int use_cache = 0; use_cache < 2; use_cache++) {
+        std::vector<void *> live(LIVE);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ROUNDS; i++) {
+            void *&slot = live[slots[i]];
+            if (slot != NULL) {
+                if (use_cache) {
+                    cached_free(&cache, heap, slot);
+                } else {
+                    multi_heap_free(heap, slot);
+                }
+            }
+            slot = use_cache ? cached_malloc(&cache, heap, sizes[i]) : multi_heap_malloc(heap, sizes[i]);
+            REQUIRE( slot != NULL );
+        }
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count() / ROUNDS;
+        printf("%-10s  %-16.1f\n", use_cache ? "cache" : "multi_heap", ns);
+
+        for (void *p : live) {
+            if (p != NULL) {
+                multi_heap_free(heap, p);
+            }
+        }
+        cache_flush(&cache);
+    }
+    REQUIRE( multi_heap_check(heap, true) );
+}
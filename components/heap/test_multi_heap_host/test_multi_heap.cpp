@@ -383,6 +383,52 @@ TEST_CASE("multi_heap_get_info() function", "[multi_heap]")
     REQUIRE( after.minimum_free_bytes == freed.minimum_free_bytes );
 }
 
+TEST_CASE("multi_heap_get_free_histogram() function", "[multi_heap]")
+{
+    uint8_t heapdata[8 * 1024];
+    multi_heap_handle_t heap = multi_heap_register(heapdata, sizeof(heapdata));
+    void *blocks[16];
+    size_t hist[8] = { 0 };
+    size_t total_free = 0;
+    size_t largest_free = 0;
+
+    multi_heap_get_free_histogram(heap, hist, 8, &total_free, &largest_free);
+    REQUIRE( 1 == hist[7] );
+    REQUIRE( total_free == largest_free );
+    // free size also counts the headers of the free blocks
+    REQUIRE( total_free <= multi_heap_free_size(heap) );
+
+    for (int i = 0; i < 16; i++) {
+        blocks[i] = multi_heap_malloc(heap, 100);
+        REQUIRE( blocks[i] != NULL );
+    }
+    for (int i = 0; i < 16; i += 2) {
+        multi_heap_free(heap, blocks[i]);
+    }
+
+    multi_heap_info_t info;
+    multi_heap_get_info(heap, &info);
+    memset(hist, 0, sizeof(hist));
+    total_free = 0;
+    largest_free = 0;
+    multi_heap_get_free_histogram(heap, hist, 8, &total_free, &largest_free);
+    // the freed blocks are in [64, 128), the rest of the heap is a single block of more than 2 KB
+    REQUIRE( 8 == hist[2] );
+    REQUIRE( 1 == hist[7] );
+    REQUIRE( info.free_blocks == 9 );
+    REQUIRE( total_free <= multi_heap_free_size(heap) );
+    REQUIRE( largest_free >= info.largest_free_block );
+
+    // counters are accumulated
+    multi_heap_get_free_histogram(heap, hist, 1, NULL, NULL);
+    REQUIRE( 9 == hist[0] );
+
+    for (int i = 1; i < 16; i += 2) {
+        multi_heap_free(heap, blocks[i]);
+    }
+    REQUIRE( multi_heap_check(heap, true) );
+}
+
 TEST_CASE("multi_heap minimum-size allocations", "[multi_heap]")
 {
     uint8_t heapdata[4096];
@@ -20,6 +20,8 @@
 #include "esp_log_format.h"
 #include "esp_log_args.h"
 #include "esp_log_attr.h"
+#include "esp_log_async.h"
+#include "esp_log_rate_limit.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_LOG_ASYNC || __DOXYGEN__
+
+/**
+ * @brief Statistics of asynchronous logging
+ */
+typedef struct {
+    uint32_t queued;        /*!< Number of messages put in the buffers, to be printed by the log task */
+    uint32_t dropped;       /*!< Number of messages dropped because the buffer of the CPU core was full */
+    uint32_t truncated;     /*!< Number of messages whose string arguments or text were cut to CONFIG_LOG_ASYNC_MAX_LINE_LEN */
+    uint32_t sync;          /*!< Number of messages written immediately because their format string can not be deferred */
+    size_t max_used;        /*!< Largest number of bytes used in the buffer of a CPU core */
+} esp_log_async_stats_t;
+
+/**
+ * @brief Get the statistics of asynchronous logging
+ *
+ * Counters are summed over all CPU cores since startup.
+ *
+ * @note Only available if CONFIG_LOG_ASYNC is enabled.
+ *
+ * @param[out] stats Statistics
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ */
+esp_err_t esp_log_async_get_stats(esp_log_async_stats_t *stats);
+
+/**
+ * @brief Wait until the log task has printed all the messages logged so far
+ *
+ * Can be used before a reset or entering deep sleep so that no message is lost.
+ *
+ * @note Only available if CONFIG_LOG_ASYNC is enabled. Must not be called from the log task,
+ *       i.e. from a function set by esp_log_set_vprintf().
+ *
+ * @param timeout_ms Maximum time to wait, in milliseconds
+ *
+ * @return
+ *      - ESP_OK if all the messages were printed
+ *      - ESP_ERR_TIMEOUT if messages are still pending after timeout_ms
+ *      - ESP_ERR_INVALID_STATE if the log task is not running or if called from it
+ */
+esp_err_t esp_log_async_flush(uint32_t timeout_ms);
+
+#endif // CONFIG_LOG_ASYNC || __DOXYGEN__
+
+#ifdef __cplusplus
+}
+#endif
@@ -125,7 +125,8 @@ typedef struct {
             uint32_t dis_color: 1;                        /*!< Flag to disable color in log output. If set, log messages will not include color codes. */
             uint32_t dis_timestamp: 1;                    /*!< Flag to disable timestamps in log output. If set, log messages will not include timestamps. */
             uint32_t binary_mode : 1;                     /*!< Flag to indicate binary mode. */
-            uint32_t reserved: 24;                        /*!< Reserved for future use. Should be initialized to 0. */
+            uint32_t dis_rate_limit: 1;                   /*!< Flag to exempt the message from the rate limiting and the collapsing of repeated messages (CONFIG_LOG_RATE_LIMIT), e.g. for the lines of a buffer dump. */
+            uint32_t reserved: 23;                        /*!< Reserved for future use. Should be initialized to 0. */
         } opts;
         uint32_t data;                                    /*!< Raw data representing all options in a 32-bit word. */
     };
@@ -137,6 +138,7 @@ typedef struct {
 #define ESP_LOG_OFFSET_DIS_COLOR_OFFSET          (5) /*!< Offset for dis_color field from esp_log_config_t */
 #define ESP_LOG_OFFSET_DIS_TIMESTAMP             (6) /*!< Offset for dis_timestamp field from esp_log_config_t */
 #define ESP_LOG_OFFSET_BINARY_MODE               (7) /*!< Offset for binary_mode field from esp_log_config_t */
+#define ESP_LOG_OFFSET_DIS_RATE_LIMIT            (8) /*!< Offset for dis_rate_limit field from esp_log_config_t */
 
 ESP_STATIC_ASSERT(ESP_LOG_OFFSET_CONSTRAINED_ENV == ESP_LOG_LEVEL_LEN, "The log level should not overlap the following fields in esp_log_config_t");
 /** @endcond */
@@ -147,6 +149,7 @@ ESP_STATIC_ASSERT(ESP_LOG_OFFSET_CONSTRAINED_ENV == ESP_LOG_LEVEL_LEN, "The log
 #define ESP_LOG_CONFIG_DIS_COLOR                 (1 << ESP_LOG_OFFSET_DIS_COLOR_OFFSET)  /*!< Value for dis_color field in esp_log_config_t */
 #define ESP_LOG_CONFIG_DIS_TIMESTAMP             (1 << ESP_LOG_OFFSET_DIS_TIMESTAMP)  /*!< Value for dis_timestamp field in esp_log_config_t */
 #define ESP_LOG_CONFIG_BINARY_MODE               (1 << ESP_LOG_OFFSET_BINARY_MODE) /*!< Value for binary_mode field in esp_log_config_t */
+#define ESP_LOG_CONFIG_DIS_RATE_LIMIT            (1 << ESP_LOG_OFFSET_DIS_RATE_LIMIT) /*!< Value for dis_rate_limit field in esp_log_config_t */
 
 /**
  * @brief Macro for setting log configurations according to selected Kconfig options.
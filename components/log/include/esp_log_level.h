@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -179,6 +179,37 @@ void esp_log_level_set(const char* tag, esp_log_level_t level);
  */
 esp_log_level_t esp_log_level_get(const char* tag);
 
+/**
+ * @brief Define a log tag whose level is looked up in constant time
+ *
+ * Defines a `static const char *const` variable named `var` pointing to the string `tag_name`,
+ * which can be used as any other tag. With CONFIG_LOG_TAG_LEVEL_INTERNED, the string is placed
+ * in a table built by the linker together with a level slot in RAM, so that checking the level
+ * of this tag reads the slot instead of searching the tag in the cache and the linked list.
+ * Other tags keep using the method selected in CONFIG_LOG_TAG_LEVEL_IMPL.
+ *
+ * @code{c}
+ * ESP_LOG_TAG_DEFINE(TAG, "wifi");
+ * ...
+ * ESP_LOGI(TAG, "connected");
+ * esp_log_level_set("wifi", ESP_LOG_WARN); // also applies to TAG
+ * @endcode
+ *
+ * @param var       Name of the variable to define
+ * @param tag_name  Tag, must be a string literal
+ */
+#if (CONFIG_LOG_TAG_LEVEL_INTERNED && !NON_OS_BUILD) || __DOXYGEN__
+#define ESP_LOG_TAG_DEFINE(var, tag_name) \
+    static uint8_t _esp_log_tag_level_##var; \
+    static const struct { \
+        uint8_t *level; \
+        char str[sizeof("" tag_name)]; \
+    } _esp_log_tag_##var __attribute__((used, section(".esp_log_tag"), aligned(4))) = { &_esp_log_tag_level_##var, tag_name }; \
+    static const char *const var = _esp_log_tag_##var.str
+#else
+#define ESP_LOG_TAG_DEFINE(var, tag_name) static const char *const var = "" tag_name
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if CONFIG_LOG_RATE_LIMIT || __DOXYGEN__
+
+/**
+ * @brief Statistics of log rate limiting
+ */
+typedef struct {
+    uint32_t rate_limited;  /*!< Number of messages dropped because their call site exceeded its rate */
+    uint32_t repeated;      /*!< Number of messages dropped because they repeated the previous message */
+} esp_log_rate_limit_stats_t;
+
+/**
+ * @brief Set the rate limit of the call sites logging with a tag
+ *
+ * Each call site (ESP_LOGx statement) has a token bucket: it can write `burst` messages in a row,
+ * then `rate` messages per second. Messages over the limit are dropped, and the number of dropped
+ * messages is written before the next message of this call site.
+ *
+ * The limit of a tag applies to the call sites which log with this tag from now on.
+ *
+ * @note Only available if CONFIG_LOG_RATE_LIMIT is enabled.
+ *
+ * @param tag   Tag of the call sites to limit. Value "*" sets the limit of the tags without their own limit,
+ *              which is CONFIG_LOG_RATE_LIMIT_RATE and CONFIG_LOG_RATE_LIMIT_BURST by default.
+ * @param rate  Number of messages per second, 0 to not limit the messages of this tag
+ * @param burst Number of messages which can be written in a row, ignored if rate is 0
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if tag is NULL, or burst is 0 while rate is not
+ *      - ESP_ERR_NO_MEM if CONFIG_LOG_RATE_LIMIT_TAGS tags already have their own limit
+ */
+esp_err_t esp_log_rate_limit_set(const char *tag, uint16_t rate, uint16_t burst);
+
+/**
+ * @brief Get the statistics of log rate limiting
+ *
+ * @note Only available if CONFIG_LOG_RATE_LIMIT is enabled.
+ *
+ * @param[out] stats Statistics
+ *
+ * @return
+ *      - ESP_OK on success
+ *      - ESP_ERR_INVALID_ARG if stats is NULL
+ */
+esp_err_t esp_log_rate_limit_get_stats(esp_log_rate_limit_stats_t *stats);
+
+#endif // CONFIG_LOG_RATE_LIMIT || __DOXYGEN__
+
+#ifdef __cplusplus
+}
+#endif
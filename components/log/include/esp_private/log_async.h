@@ -0,0 +1,42 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_private/log_message.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Create the log task which prints the messages of asynchronous logging.
+ *
+ * Until it is called, all messages are written synchronously.
+ *
+ * @note Called once during system startup, after the scheduler is started.
+ *
+ * @return ESP_OK on success, ESP_ERR_NO_MEM if the task can not be created.
+ */
+esp_err_t esp_log_async_init(void);
+
+/**
+ * @brief Queue a log message for the log task.
+ *
+ * The message is either copied into the buffer of the current CPU core, or
+ * dropped if this buffer is full.
+ *
+ * @note Must not be called from a constrained environment.
+ *
+ * @param message Pointer to log message structure.
+ * @return false if the message has to be written synchronously by the caller, true otherwise.
+ */
+bool esp_log_async_write(esp_log_msg_t *message);
+
+#ifdef __cplusplus
+}
+#endif
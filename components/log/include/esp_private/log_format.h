@@ -5,6 +5,7 @@
  */
 
 #pragma once
+#include <stdint.h>
 #include "esp_log_config.h"
 #include "log_message.h"
 
@@ -26,6 +27,35 @@ void esp_log_format(esp_log_msg_t *message);
  * @param message Pointer to log message structure.
  */
 void esp_log_format_binary(esp_log_msg_t *message);
+
+#if CONFIG_LOG_ASYNC && !NON_OS_BUILD
+/**
+ * @brief Calculate the length of the binary package of a log message.
+ *
+ * @param message Pointer to log message structure.
+ * @return Length of the package in bytes.
+ */
+unsigned esp_log_format_binary_len(esp_log_msg_t *message);
+
+/**
+ * @brief Format log message in binary mode into a buffer instead of the console.
+ *
+ * The whole buffer is written: the bytes not used by the package are zeroed.
+ *
+ * @param message Pointer to log message structure.
+ * @param buffer  Buffer receiving the package.
+ * @param pkg_len Length of the package, as returned by esp_log_format_binary_len().
+ */
+void esp_log_format_binary_to_buffer(esp_log_msg_t *message, uint8_t *buffer, unsigned pkg_len);
+
+/**
+ * @brief Output binary packages previously formatted into a buffer.
+ *
+ * @param data Packages.
+ * @param len  Length of the packages in bytes.
+ */
+void esp_log_output_binary(const uint8_t *data, unsigned len);
+#endif // CONFIG_LOG_ASYNC && !NON_OS_BUILD
 #endif // ESP_LOG_MODE_BINARY_EN
 
 #ifdef __cplusplus
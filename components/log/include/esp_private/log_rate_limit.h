@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#include <stdbool.h>
+#include "esp_private/log_message.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Check the rate limit of the call site of a log message.
+ *
+ * Updates the token bucket of the call site, identified by the format string, and checks whether
+ * the message repeats the previous one. Writes the number of messages dropped before this one, if any.
+ *
+ * @note Must not be called from a constrained environment.
+ *
+ * @param message Pointer to log message structure.
+ * @return true if the message can be written, false if it has to be dropped.
+ */
+bool esp_log_rate_limit_check(esp_log_msg_t *message);
+
+#ifdef __cplusplus
+}
+#endif
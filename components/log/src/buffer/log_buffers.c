@@ -99,7 +99,8 @@ __attribute__((unused)) static void print_buffer(const char *tag, const void *bu
 
         print_line_func((uintptr_t)buffer, ptr_line, output_str, bytes_cur_line);
 
-        ESP_LOG_LEVEL(log_level, tag, "%s", output_str);
+        // the lines of a dump all come from this call site and can repeat, they are not rate limited
+        ESP_LOG_LEVEL(log_level | ESP_LOG_CONFIG_DIS_RATE_LIMIT, tag, "%s", output_str);
         buffer += bytes_cur_line;
         buff_len -= bytes_cur_line;
     } while (buff_len);
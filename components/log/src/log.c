@@ -18,6 +18,12 @@
 #include "esp_private/log_print.h"
 #include "esp_private/log_message.h"
 #include "esp_private/log_format.h"
+#if CONFIG_LOG_ASYNC && !NON_OS_BUILD
+#include "esp_private/log_async.h"
+#endif
+#if CONFIG_LOG_RATE_LIMIT && !NON_OS_BUILD
+#include "esp_private/log_rate_limit.h"
+#endif
 #include "esp_log_write.h"
 #include "esp_rom_sys.h"
 #include "sdkconfig.h"
@@ -67,6 +73,20 @@ void __attribute__((optimize("-O3"))) esp_log_va(esp_log_config_t config, const
         if (config.opts.binary_mode) {
             message.arg_types = va_arg(message.args, const char *);
         }
+#endif // ESP_LOG_MODE_BINARY_EN
+#if CONFIG_LOG_RATE_LIMIT && !NON_OS_BUILD
+        if (!config.opts.constrained_env && !esp_log_rate_limit_check(&message)) {
+            va_end(message.args);
+            return;
+        }
+#endif // CONFIG_LOG_RATE_LIMIT && !NON_OS_BUILD
+#if CONFIG_LOG_ASYNC && !NON_OS_BUILD
+        if (!config.opts.constrained_env && esp_log_async_write(&message)) {
+            va_end(message.args);
+            return;
+        }
+#endif // CONFIG_LOG_ASYNC && !NON_OS_BUILD
+#if ESP_LOG_MODE_BINARY_EN
         esp_log_format_binary(&message);
 #else
         esp_log_format(&message);
@@ -61,6 +61,8 @@ _Static_assert(sizeof(control_t) == 3, "control_t must be exactly 24 bits (3 byt
 
 typedef struct {
     uint8_t crc;
+    uint8_t *dst;           /**< Buffer receiving the package, or NULL to output it to the console. */
+    uint8_t *dst_end;
     bool buffer_hex_log;
     bool buffer_char_log;
     bool buffer_hexdump_log;
@@ -111,7 +113,11 @@ static unsigned output(const void *src, unsigned length, pkg_info_t *pkg_info)
     for (unsigned i = 0; i < length; i++) {
         uint8_t data = ((uint8_t *)src)[length - 1 - i];
         if (pkg_info->len_calculation_stage == false) {
-            esp_rom_output_tx_one_char(data);
+            if (pkg_info->dst == NULL) {
+                esp_rom_output_tx_one_char(data);
+            } else if (pkg_info->dst < pkg_info->dst_end) {
+                *pkg_info->dst++ = data;
+            }
             update_crc8(data, pkg_info);
         }
     }
@@ -243,6 +249,20 @@ static unsigned calc_pkg_len(esp_log_msg_t *message, pkg_info_t *pkg_info)
     return pkg_len;
 }
 
+static void init_pkg_info(esp_log_msg_t *message, pkg_info_t *pkg_info)
+{
+    *pkg_info = (pkg_info_t) {
+        .crc = 0,
+        .dst = NULL,
+        .dst_end = NULL,
+        .buffer_hex_log = message->format == __ESP_BUFFER_HEX_FORMAT__,
+        .buffer_char_log = message->format == __ESP_BUFFER_CHAR_FORMAT__,
+        .buffer_hexdump_log = message->format == __ESP_BUFFER_HEXDUMP_FORMAT__,
+        .buffer_len = 0,
+        .len_calculation_stage = false,
+    };
+}
+
 /*
 [0] - Type of message: 1 - bootloader, 2 - application, ...
 [1] - Control byte: log level, version.
@@ -256,41 +276,69 @@ Embedded string:
 [0, 1] bytes - (10 bits) negative length of the string = 1 - len(str). 0xFFFC = len is 5, 0xFDD6 = len is 555. Max is 1023.
 next bytes - string
 */
-void esp_log_format_binary(esp_log_msg_t *message)
+static void output_pkg(esp_log_msg_t *message, unsigned pkg_len, pkg_info_t *pkg_info)
 {
-    assert(message != NULL);
-
-    if (!message->config.opts.constrained_env) {
-        esp_log_impl_lock();
-    }
-
-    pkg_info_t pkg_info = {
-        .crc = 0,
-        .buffer_hex_log = message->format == __ESP_BUFFER_HEX_FORMAT__,
-        .buffer_char_log = message->format == __ESP_BUFFER_CHAR_FORMAT__,
-        .buffer_hexdump_log = message->format == __ESP_BUFFER_HEXDUMP_FORMAT__,
-        .buffer_len = 0,
-        .len_calculation_stage = false,
-    };
-
     // Output control byte
     control_t control = {
         .opts = {
-            .pkg_len = calc_pkg_len(message, &pkg_info),
+            .pkg_len = pkg_len,
             .log_level = message->config.opts.log_level,
             .time_64bits = (message->timestamp >> 32) != 0,
             .version = 0,
         },
         .app_identifier = APP_TYPE,
     };
-    output(&control, sizeof(control), &pkg_info);
-    output_pointer(message->format, &pkg_info);
-    output_pointer(message->tag, &pkg_info);
-    output(&message->timestamp, (control.opts.time_64bits) ? sizeof(uint64_t) : sizeof(uint32_t), &pkg_info);
-    output_arguments(message, message->args, &pkg_info);
-    output(&pkg_info.crc, sizeof(pkg_info.crc), &pkg_info);
+    output(&control, sizeof(control), pkg_info);
+    output_pointer(message->format, pkg_info);
+    output_pointer(message->tag, pkg_info);
+    output(&message->timestamp, (control.opts.time_64bits) ? sizeof(uint64_t) : sizeof(uint32_t), pkg_info);
+    output_arguments(message, message->args, pkg_info);
+    output(&pkg_info->crc, sizeof(pkg_info->crc), pkg_info);
+}
+
+void esp_log_format_binary(esp_log_msg_t *message)
+{
+    assert(message != NULL);
+
+    if (!message->config.opts.constrained_env) {
+        esp_log_impl_lock();
+    }
+
+    pkg_info_t pkg_info;
+    init_pkg_info(message, &pkg_info);
+    output_pkg(message, calc_pkg_len(message, &pkg_info), &pkg_info);
 
     if (!message->config.opts.constrained_env) {
         esp_log_impl_unlock();
     }
 }
+
+#if CONFIG_LOG_ASYNC && !NON_OS_BUILD
+unsigned esp_log_format_binary_len(esp_log_msg_t *message)
+{
+    pkg_info_t pkg_info;
+    init_pkg_info(message, &pkg_info);
+    return calc_pkg_len(message, &pkg_info);
+}
+
+void esp_log_format_binary_to_buffer(esp_log_msg_t *message, uint8_t *buffer, unsigned pkg_len)
+{
+    pkg_info_t pkg_info;
+    init_pkg_info(message, &pkg_info);
+    // strings may have been changed since pkg_len was calculated, never write more,
+    // and zero the buffer so that the bytes left by a shorter string are not sent uninitialized
+    memset(buffer, 0, pkg_len);
+    pkg_info.dst = buffer;
+    pkg_info.dst_end = buffer + pkg_len;
+    output_pkg(message, pkg_len, &pkg_info);
+}
+
+void esp_log_output_binary(const uint8_t *data, unsigned len)
+{
+    esp_log_impl_lock();
+    for (unsigned i = 0; i < len; i++) {
+        esp_rom_output_tx_one_char(data[i]);
+    }
+    esp_log_impl_unlock();
+}
+#endif // CONFIG_LOG_ASYNC && !NON_OS_BUILD
@@ -0,0 +1,41 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "log_interned_tag.h"
+
+#define ENTRY_ALIGN     (__alignof__(esp_log_tag_entry_t))
+
+/* Entries have different sizes, the next one starts after the string, at the next aligned address.
+   Skips any padding the linker may have added between entries, as the level pointer is never NULL. */
+static const esp_log_tag_entry_t *next_entry(const esp_log_tag_entry_t *entry)
+{
+    const uint8_t *next = _esp_log_tag_array_start;
+    if (entry != NULL) {
+        size_t size = offsetof(esp_log_tag_entry_t, str) + strlen(entry->str) + 1;
+        next = (const uint8_t *)entry + ((size + ENTRY_ALIGN - 1) & ~(ENTRY_ALIGN - 1));
+    }
+    while (next < _esp_log_tag_array_end && ((const esp_log_tag_entry_t *)next)->level == NULL) {
+        next += ENTRY_ALIGN;
+    }
+    return (next < _esp_log_tag_array_end) ? (const esp_log_tag_entry_t *)next : NULL;
+}
+
+void esp_log_interned_tag_set_level(const char *tag, esp_log_level_t level)
+{
+    for (const esp_log_tag_entry_t *entry = next_entry(NULL); entry != NULL; entry = next_entry(entry)) {
+        if (strcmp(entry->str, tag) == 0) {
+            *entry->level = level + 1;
+        }
+    }
+}
+
+void esp_log_interned_tag_clean(void)
+{
+    for (const esp_log_tag_entry_t *entry = next_entry(NULL); entry != NULL; entry = next_entry(entry)) {
+        *entry->level = 0;
+    }
+}
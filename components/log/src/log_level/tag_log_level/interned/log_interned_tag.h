@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_log_level.h"
+
+/**
+ * @brief Entry of the tag table built by the linker from ESP_LOG_TAG_DEFINE.
+ *
+ * Same layout as the structure defined by the macro. The entries are aligned to 4 bytes.
+ */
+typedef struct {
+    uint8_t *level;     /*!< Level slot of the tag: 0 if not set, otherwise the level + 1 */
+    char str[];         /*!< Tag string, the tag pointer used in ESP_LOGx points here */
+} esp_log_tag_entry_t;
+
+extern const uint8_t _esp_log_tag_array_start[];
+extern const uint8_t _esp_log_tag_array_end[];
+
+/**
+ * @brief Get the log level of a tag defined with ESP_LOG_TAG_DEFINE.
+ *
+ * Only compares the tag pointer with the bounds of the tag table, so it does not need the log lock.
+ *
+ * @param tag The log tag for which to retrieve the log level.
+ * @param level Pointer to a variable where the retrieved log level will be
+ * stored. It is not modified if the level of the tag was not set.
+ * @return true  if the tag is in the tag table,
+ *         false otherwise, the level has to be looked up by name.
+ */
+static inline bool esp_log_interned_tag_get_level(const char *tag, esp_log_level_t *level)
+{
+    if ((const uint8_t *)tag < _esp_log_tag_array_start || (const uint8_t *)tag >= _esp_log_tag_array_end) {
+        return false;
+    }
+    const esp_log_tag_entry_t *entry = (const esp_log_tag_entry_t *)((uintptr_t)tag - offsetof(esp_log_tag_entry_t, str));
+    uint8_t slot = *entry->level;
+    if (slot != 0) {
+        *level = (esp_log_level_t)(slot - 1);
+    }
+    return true;
+}
+
+/**
+ * @brief Set the log level of all the tags of the tag table with the given name.
+ *
+ * @param tag The log tag for which to set the log level.
+ * @param level The log level to be set for the specified log tag.
+ */
+void esp_log_interned_tag_set_level(const char *tag, esp_log_level_t level);
+
+/**
+ * @brief Clears the level of all the tags of the tag table, they use the default level again.
+ */
+void esp_log_interned_tag_clean(void);
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -18,6 +18,10 @@
 #include "linked_list/log_linked_list.h"
 #endif
 
+#if CONFIG_LOG_TAG_LEVEL_INTERNED
+#include "interned/log_interned_tag.h"
+#endif
+
 #if CONFIG_LOG_TAG_LEVEL_CACHE_ARRAY || CONFIG_LOG_TAG_LEVEL_CACHE_BINARY_MIN_HEAP
 #define CACHE_ENABLED 1
 #include "cache/log_cache.h"
@@ -43,8 +47,14 @@ static inline void log_level_set(const char *tag, esp_log_level_t level)
         esp_log_linked_list_clean();
 #if CACHE_ENABLED
         esp_log_cache_clean();
+#endif
+#if CONFIG_LOG_TAG_LEVEL_INTERNED
+        esp_log_interned_tag_clean();
 #endif
     } else {
+#if CONFIG_LOG_TAG_LEVEL_INTERNED
+        esp_log_interned_tag_set_level(tag, level);
+#endif
         __attribute__((unused)) bool success = esp_log_linked_list_set_level(tag, level);
 #if CACHE_ENABLED
         if (success) {
@@ -61,6 +71,11 @@ static esp_log_level_t log_level_get(const char *tag, bool timeout)
     if (tag == NULL) {
         return level_for_tag;
     }
+#if CONFIG_LOG_TAG_LEVEL_INTERNED
+    if (esp_log_interned_tag_get_level(tag, &level_for_tag)) {
+        return level_for_tag;
+    }
+#endif
     if (timeout) {
         if (esp_log_impl_lock_timeout() == false) {
             return ESP_LOG_NONE;
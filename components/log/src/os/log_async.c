@@ -0,0 +1,564 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_log_async.h"
+#include "esp_private/log_async.h"
+#include "esp_private/log_format.h"
+#include "esp_private/log_message.h"
+#include "sdkconfig.h"
+
+/*
+Asynchronous logging
+
+Each CPU core has a ring buffer of variable-size records. A record holds what esp_log_va() got: the log config,
+tag and format pointers, the timestamp, and the values of the arguments (see copy_args()). A task reserves a
+record in the buffer of the core it runs on with the interrupts of this core masked, so that neither another task
+nor an ISR of the same core can interleave; no lock is shared between the cores. The record is filled with the
+interrupts enabled, then marked as committed.
+
+The log task takes the committed records at the tail of the buffers, in the order they were reserved in across
+all the cores, formats them and outputs them through esp_log_format().
+
+In binary log mode, the record holds the package built by the binary log formatter instead of the argument values,
+and the log task outputs the packages as they are. The caller then only encodes the message into RAM, the host
+decodes the packages with the ELF file as for synchronous binary logging.
+*/
+
+#define BUFFER_SIZE         (CONFIG_LOG_ASYNC_BUFFER_SIZE & ~(RECORD_ALIGN - 1))
+#define RECORD_ALIGN        (__alignof__(record_t))
+#define MAX_RECORD_SIZE     (BUFFER_SIZE / 2)   // Larger messages are written synchronously
+#if !ESP_LOG_MODE_BINARY_EN
+#define MAX_ARGS_LEN        (CONFIG_LOG_ASYNC_MAX_LINE_LEN)
+#define MAX_SPEC_LEN        (16)    // Longest conversion specification which can be deferred, such as "%-08.3llx"
+#endif
+
+typedef enum {
+    RECORD_RESERVED = 0,    // Being written by the task which logs
+    RECORD_COMMITTED,       // Ready to be printed
+    RECORD_PADDING,         // Unused space up to the end of the buffer
+} record_state_t;
+
+typedef struct {
+    uint16_t len;           // Length of the record including this header, multiple of RECORD_ALIGN
+    uint8_t state;          // record_state_t
+    uint8_t truncated;      // Some arguments were truncated to fit in the record
+    uint32_t seq;           // Order of the message among the messages of all the cores
+    esp_log_config_t config;
+    const char *tag;
+    const char *format;
+    uint16_t args_len;
+    uint64_t timestamp;
+    uint8_t args[];         // Values of the arguments, or binary package
+} record_t;
+
+typedef struct {
+    uint8_t buffer[BUFFER_SIZE] __attribute__((aligned(8)));
+    size_t head;            // Offset of the next record, only written by the core owning the buffer
+    size_t tail;            // Offset of the oldest record, only written by the log task
+    size_t used;            // Bytes between tail and head, updated atomically by both
+    uint32_t queued;
+    uint32_t dropped;
+    size_t max_used;
+} log_ring_t;
+
+#if !ESP_LOG_MODE_BINARY_EN
+typedef enum {
+    ARG_END,                // End of the format string
+    ARG_PERCENT,            // "%%"
+    ARG_INT32,
+    ARG_INT64,
+    ARG_DOUBLE,
+    ARG_POINTER,
+    ARG_STRING,
+    ARG_UNSUPPORTED,        // The message can not be deferred
+} arg_type_t;
+
+typedef struct {
+    const char *start;      // '%' of the conversion specification, or end of the format string
+    const char *end;        // Character after the conversion specification
+    arg_type_t type;
+} conversion_t;
+#endif // !ESP_LOG_MODE_BINARY_EN
+
+static const char *TAG = "log";
+
+static log_ring_t s_rings[portNUM_PROCESSORS];
+static TaskHandle_t s_log_task;
+static uint32_t s_seq;
+static bool s_wakeup_pending;
+static uint32_t s_sync;
+static uint32_t s_truncated;
+
+#if !ESP_LOG_MODE_BINARY_EN
+/* Find the next conversion specification of a format string, from the subset printf supports
+   which can be stored as a 32 or 64-bit value, a double or a string. */
+static void next_conversion(const char *format, conversion_t *conv)
+{
+    const char *p = strchr(format, '%');
+    if (p == NULL) {
+        conv->start = conv->end = format + strlen(format);
+        conv->type = ARG_END;
+        return;
+    }
+    conv->start = p++;
+    conv->type = ARG_UNSUPPORTED;
+    if (*p == '%') {
+        conv->end = p + 1;
+        conv->type = ARG_PERCENT;
+        return;
+    }
+
+    p += strspn(p, "-+ #0");
+    p += strspn(p, "0123456789");
+    if (*p == '.') {
+        p++;
+        p += strspn(p, "0123456789");
+    }
+    size_t int_size = sizeof(int);
+    switch (*p) {
+    case 'h':
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        int_size = (p[1] == 'l') ? sizeof(long long) : sizeof(long);
+        p += (p[1] == 'l') ? 2 : 1;
+        break;
+    case 'j':
+        int_size = sizeof(intmax_t);
+        p++;
+        break;
+    case 'z':
+        int_size = sizeof(size_t);
+        p++;
+        break;
+    case 't':
+        int_size = sizeof(ptrdiff_t);
+        p++;
+        break;
+    case 'L':
+        int_size = 0; // long double
+        p++;
+        break;
+    }
+    conv->end = (*p != '\0') ? p + 1 : p;
+    if (conv->end - conv->start >= MAX_SPEC_LEN) {
+        return;
+    }
+
+    switch (*p) {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': case 'c':
+        if (int_size == sizeof(uint32_t)) {
+            conv->type = ARG_INT32;
+        } else if (int_size == sizeof(uint64_t)) {
+            conv->type = ARG_INT64;
+        }
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        if (int_size != 0) {
+            conv->type = ARG_DOUBLE;
+        }
+        break;
+    case 'p':
+        conv->type = ARG_POINTER;
+        break;
+    case 's':
+        if (p[-1] != 'l') {
+            conv->type = ARG_STRING;
+        }
+        break;
+    default: // '*' width or precision, "%n", wide characters
+        break;
+    }
+}
+
+/* Copy the values of the arguments of a format string to dst, at most capacity bytes.
+   If dst is NULL, only calculate their size.
+   Returns the number of bytes, or -1 if an argument can not be deferred. */
+static int copy_args(const char *format, va_list args, uint8_t *dst, size_t capacity, bool *truncated)
+{
+    size_t pos = 0;
+    conversion_t conv;
+    for (next_conversion(format, &conv); conv.type != ARG_END; next_conversion(conv.end, &conv)) {
+        union {
+            uint32_t int32;
+            uint64_t int64;
+            double dbl;
+            uintptr_t ptr;
+        } val;
+        size_t len = 0;
+        const char *str = NULL;
+        switch (conv.type) {
+        case ARG_PERCENT:
+            continue;
+        case ARG_INT32:
+            val.int32 = va_arg(args, uint32_t);
+            len = sizeof(val.int32);
+            break;
+        case ARG_INT64:
+            val.int64 = va_arg(args, uint64_t);
+            len = sizeof(val.int64);
+            break;
+        case ARG_DOUBLE:
+            val.dbl = va_arg(args, double);
+            len = sizeof(val.dbl);
+            break;
+        case ARG_POINTER:
+            val.ptr = (uintptr_t)va_arg(args, void *);
+            len = sizeof(val.ptr);
+            break;
+        case ARG_STRING:
+            str = va_arg(args, const char *);
+            str = (str != NULL) ? str : "(null)";
+            len = (pos < capacity) ? strnlen(str, capacity - pos - 1) + 1 : 0;
+            break;
+        default:
+            return -1;
+        }
+        if (len == 0 || pos + len > capacity || (str != NULL && str[len - 1] != '\0')) {
+            *truncated = true;
+        }
+        if (len == 0 || pos + len > capacity) {
+            break;
+        }
+        if (dst != NULL) {
+            memcpy(dst + pos, (str != NULL) ? (const void *)str : (const void *)&val, len);
+            if (str != NULL) {
+                dst[pos + len - 1] = '\0';
+            }
+        }
+        pos += len;
+    }
+    return pos;
+}
+
+/* Format the message of a record into line. Returns false if it was truncated. */
+static bool format_record(const record_t *rec, char *line, size_t size)
+{
+    const uint8_t *args = rec->args;
+    const uint8_t *args_end = rec->args + rec->args_len;
+    const char *format = rec->format;
+    size_t pos = 0;
+    conversion_t conv;
+    line[0] = '\0';
+    while (pos < size - 1) {
+        next_conversion(format, &conv);
+        size_t literal = MIN((size_t)(conv.start - format), size - 1 - pos);
+        memcpy(line + pos, format, literal);
+        pos += literal;
+        line[pos] = '\0';
+        if (conv.type == ARG_END || pos == size - 1) {
+            break;
+        }
+
+        char spec[MAX_SPEC_LEN];
+        memcpy(spec, conv.start, conv.end - conv.start);
+        spec[conv.end - conv.start] = '\0';
+        union {
+            uint32_t int32;
+            uint64_t int64;
+            double dbl;
+            uintptr_t ptr;
+        } val;
+        size_t len;
+        switch (conv.type) {
+        case ARG_INT32:
+            len = sizeof(uint32_t);
+            break;
+        case ARG_POINTER:
+            len = sizeof(uintptr_t);
+            break;
+        case ARG_INT64:
+        case ARG_DOUBLE:
+            len = sizeof(uint64_t);
+            break;
+        case ARG_STRING:
+            len = strnlen((const char *)args, args_end - args) + 1;
+            break;
+        default:
+            len = 0;
+            break;
+        }
+        if (args + len > args_end) {
+            // truncated when the record was written
+            break;
+        }
+        memcpy(&val, args, MIN(len, sizeof(val)));
+
+        int n;
+        switch (conv.type) {
+        case ARG_PERCENT:
+            n = snprintf(line + pos, size - pos, "%%");
+            break;
+        case ARG_INT32:
+            n = snprintf(line + pos, size - pos, spec, val.int32);
+            break;
+        case ARG_INT64:
+            n = snprintf(line + pos, size - pos, spec, val.int64);
+            break;
+        case ARG_DOUBLE:
+            n = snprintf(line + pos, size - pos, spec, val.dbl);
+            break;
+        case ARG_POINTER:
+            n = snprintf(line + pos, size - pos, spec, (void *)val.ptr);
+            break;
+        case ARG_STRING:
+            n = snprintf(line + pos, size - pos, spec, (const char *)args);
+            break;
+        default:
+            n = 0;
+            break;
+        }
+        pos = MIN(pos + MAX(n, 0), size - 1);
+        args += len;
+        format = conv.end;
+    }
+    return pos < size - 1;
+}
+
+static void write_message(esp_log_msg_t *message, ...)
+{
+    va_start(message->args, message);
+    esp_log_format(message);
+    va_end(message->args);
+}
+
+#endif // !ESP_LOG_MODE_BINARY_EN
+
+static void output_record(const record_t *rec)
+{
+#if ESP_LOG_MODE_BINARY_EN
+    esp_log_output_binary(rec->args, rec->args_len);
+#else
+    static char s_line[CONFIG_LOG_ASYNC_MAX_LINE_LEN + 1];
+    if (!format_record(rec, s_line, sizeof(s_line)) || rec->truncated) {
+        s_truncated++;
+    }
+    esp_log_msg_t message = {
+        .config = rec->config,
+        .tag = rec->tag,
+        .format = "%s",
+        .timestamp = rec->timestamp,
+        .arg_types = NULL,
+    };
+    write_message(&message, s_line);
+#endif // !ESP_LOG_MODE_BINARY_EN
+}
+
+/* Reserve a record of size bytes in a ring. Must be called with the interrupts of the core owning the ring masked. */
+static record_t *ring_reserve(log_ring_t *ring, size_t size)
+{
+    size_t used = __atomic_load_n(&ring->used, __ATOMIC_ACQUIRE);
+    size_t contiguous = BUFFER_SIZE - ring->head;
+    size_t total = (size <= contiguous) ? size : contiguous + size;
+    if (used + total > BUFFER_SIZE) {
+        ring->dropped++;
+        return NULL;
+    }
+    if (size > contiguous) {
+        record_t *padding = (record_t *)&ring->buffer[ring->head];
+        padding->len = contiguous;
+        padding->state = RECORD_PADDING;
+        ring->head = 0;
+    }
+    record_t *rec = (record_t *)&ring->buffer[ring->head];
+    rec->len = size;
+    rec->state = RECORD_RESERVED;
+    rec->seq = __atomic_fetch_add(&s_seq, 1, __ATOMIC_RELAXED);
+    ring->head = (ring->head + size) % BUFFER_SIZE;
+    used = __atomic_add_fetch(&ring->used, total, __ATOMIC_RELEASE);
+    ring->queued++;
+    ring->max_used = MAX(ring->max_used, used);
+    return rec;
+}
+
+static void ring_release(log_ring_t *ring, const record_t *rec)
+{
+    size_t len = rec->len;
+    ring->tail = (ring->tail + len) % BUFFER_SIZE;
+    __atomic_sub_fetch(&ring->used, len, __ATOMIC_RELEASE);
+}
+
+/* Return the oldest record of a ring, which may still be written */
+static record_t *ring_peek(log_ring_t *ring)
+{
+    while (__atomic_load_n(&ring->used, __ATOMIC_ACQUIRE) > 0) {
+        record_t *rec = (record_t *)&ring->buffer[ring->tail];
+        if (__atomic_load_n(&rec->state, __ATOMIC_ACQUIRE) != RECORD_PADDING) {
+            return rec;
+        }
+        ring_release(ring, rec);
+    }
+    return NULL;
+}
+
+/* Return the record which was reserved first, among the oldest records of all rings, if it is committed.
+ * If it is still being written, return NULL: committing it wakes the log task up again. */
+static record_t *next_record(log_ring_t **ring_out)
+{
+    record_t *next = NULL;
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        record_t *rec = ring_peek(&s_rings[i]);
+        if (rec != NULL && (next == NULL || (int32_t)(rec->seq - next->seq) < 0)) {
+            next = rec;
+            *ring_out = &s_rings[i];
+        }
+    }
+    if (next != NULL && __atomic_load_n(&next->state, __ATOMIC_ACQUIRE) != RECORD_COMMITTED) {
+        return NULL;
+    }
+    return next;
+}
+
+static bool rings_empty(void)
+{
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        if (__atomic_load_n(&s_rings[i].used, __ATOMIC_ACQUIRE) > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t total_dropped(void)
+{
+    uint32_t dropped = 0;
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        dropped += s_rings[i].dropped;
+    }
+    return dropped;
+}
+
+static void wake_log_task(void)
+{
+    if (!__atomic_exchange_n(&s_wakeup_pending, true, __ATOMIC_SEQ_CST)) {
+        xTaskNotifyGive(s_log_task);
+    }
+}
+
+static void log_task(void *arg)
+{
+    uint32_t reported_dropped = 0;
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        // cleared before taking the records, a record committed from now on wakes the task up again
+        __atomic_store_n(&s_wakeup_pending, false, __ATOMIC_SEQ_CST);
+
+        log_ring_t *ring;
+        record_t *rec;
+        while ((rec = next_record(&ring)) != NULL) {
+            output_record(rec);
+            ring_release(ring, rec);
+        }
+
+        uint32_t dropped = total_dropped();
+        if (dropped != reported_dropped) {
+            ESP_LOGW(TAG, "%"PRIu32" messages dropped, log buffer full", dropped - reported_dropped);
+            reported_dropped = dropped;
+        }
+    }
+}
+
+esp_err_t esp_log_async_init(void)
+{
+    TaskHandle_t task;
+    if (xTaskCreate(log_task, "log", CONFIG_LOG_ASYNC_TASK_STACK_SIZE, NULL, CONFIG_LOG_ASYNC_TASK_PRIORITY, &task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    __atomic_store_n(&s_log_task, task, __ATOMIC_RELEASE);
+    return ESP_OK;
+}
+
+bool esp_log_async_write(esp_log_msg_t *message)
+{
+    TaskHandle_t log_task = __atomic_load_n(&s_log_task, __ATOMIC_ACQUIRE);
+    if (log_task == NULL || xTaskGetCurrentTaskHandle() == log_task) {
+        return false;
+    }
+
+    bool truncated = false;
+#if ESP_LOG_MODE_BINARY_EN
+    int args_len = esp_log_format_binary_len(message);
+#else
+    va_list args;
+    va_copy(args, message->args);
+    int args_len = copy_args(message->format, args, NULL, MAX_ARGS_LEN, &truncated);
+    va_end(args);
+#endif
+    size_t size = (sizeof(record_t) + args_len + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+    if (args_len < 0 || size > MAX_RECORD_SIZE) {
+        __atomic_fetch_add(&s_sync, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    UBaseType_t intr_state = portSET_INTERRUPT_MASK_FROM_ISR();
+    record_t *rec = ring_reserve(&s_rings[xPortGetCoreID()], size);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(intr_state);
+    if (rec == NULL) {
+        return true;
+    }
+
+    rec->config = message->config;
+    rec->tag = message->tag;
+    rec->format = message->format;
+    rec->timestamp = message->timestamp;
+    rec->args_len = args_len;
+#if ESP_LOG_MODE_BINARY_EN
+    esp_log_format_binary_to_buffer(message, rec->args, args_len);
+#else
+    // the strings may have changed since their size was calculated, do not copy more than reserved
+    memset(rec->args, 0, args_len);
+    copy_args(message->format, message->args, rec->args, args_len, &truncated);
+#endif
+    rec->truncated = truncated;
+    __atomic_store_n(&rec->state, RECORD_COMMITTED, __ATOMIC_RELEASE);
+
+    wake_log_task();
+    return true;
+}
+
+esp_err_t esp_log_async_get_stats(esp_log_async_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(stats, 0, sizeof(esp_log_async_stats_t));
+    for (int i = 0; i < portNUM_PROCESSORS; i++) {
+        stats->queued += s_rings[i].queued;
+        stats->dropped += s_rings[i].dropped;
+        stats->max_used = MAX(stats->max_used, s_rings[i].max_used);
+    }
+    stats->truncated = s_truncated;
+    stats->sync = __atomic_load_n(&s_sync, __ATOMIC_RELAXED);
+    return ESP_OK;
+}
+
+esp_err_t esp_log_async_flush(uint32_t timeout_ms)
+{
+    TaskHandle_t log_task = __atomic_load_n(&s_log_task, __ATOMIC_ACQUIRE);
+    if (log_task == NULL || xTaskGetCurrentTaskHandle() == log_task) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    TickType_t start = xTaskGetTickCount();
+    while (!rings_empty()) {
+        if (xTaskGetTickCount() - start >= pdMS_TO_TICKS(timeout_ms)) {
+            return ESP_ERR_TIMEOUT;
+        }
+        wake_log_task();
+        vTaskDelay(1);
+    }
+    return ESP_OK;
+}
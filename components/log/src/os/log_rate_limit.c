@@ -0,0 +1,290 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_log_rate_limit.h"
+#include "esp_private/log_rate_limit.h"
+#include "esp_private/log_message.h"
+#include "sdkconfig.h"
+
+/*
+Log rate limiting
+
+A call site is identified by the pointer to its format string. The sites seen recently are kept in a small hash
+table, each with a token bucket counting thousandths of a message: it is refilled with `rate` messages per second,
+up to `burst` messages, and writing a message takes one. The limits of a site are looked up by tag when the site
+enters the table or when the limits have been changed since, so that checking a message does not compare strings.
+
+With CONFIG_LOG_RATE_LIMIT_REPEAT, a message is also dropped if it comes from the same call site, with the same
+tag and text, as the previous message written. Only the messages which follow a message of the same call site are
+formatted to compare their text, so the first repetition is written. The number of dropped repetitions is written
+before the next different message.
+
+Messages with the dis_rate_limit option, such as the lines of buffer dumps, are always written. They are not compared
+as repetitions, but they still end a series of repeated messages.
+
+The notes about dropped messages are logged at the level of the message they are about, through esp_log_va()
+which calls esp_log_rate_limit_check() again: s_writing_note lets them through without changing the state.
+*/
+
+#define TOKEN               (1000)  // A message, in thousandths of a message
+#define SITE_PROBES         (4)     // Number of slots where a call site can be in the table
+#define REPEAT_TEXT_LEN     (128)   // Number of characters of a message compared to detect repetitions
+
+typedef struct {
+    const char *format;     // Call site, NULL if the slot is free
+    const char *tag;
+    uint32_t refill_ms;     // Time of the last refill of the bucket
+    uint32_t tokens;
+    uint32_t suppressed;    // Messages dropped since the last one written
+    uint32_t limits_gen;    // Value of s_limits_gen when rate and burst were looked up
+    uint16_t rate;
+    uint16_t burst;
+} site_t;
+
+typedef struct {
+    char *tag;              // NULL if the entry is free
+    uint16_t rate;
+    uint16_t burst;
+} tag_limit_t;
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static site_t s_sites[CONFIG_LOG_RATE_LIMIT_SITES];
+static tag_limit_t s_tag_limits[CONFIG_LOG_RATE_LIMIT_TAGS];
+static uint16_t s_default_rate = CONFIG_LOG_RATE_LIMIT_RATE;
+static uint16_t s_default_burst = CONFIG_LOG_RATE_LIMIT_BURST;
+static uint32_t s_limits_gen = 1;
+static uint32_t s_rate_limited;
+static uint32_t s_repeated;
+static __thread bool s_writing_note;
+
+#if CONFIG_LOG_RATE_LIMIT_REPEAT
+static struct {
+    const char *format;
+    const char *tag;
+    esp_log_level_t level;
+    uint32_t hash;          // Hash of the text, 0 if not computed
+    uint32_t count;         // Repetitions dropped
+} s_last;
+
+/* FNV-1a hash of the beginning of the text of the message, never 0 */
+static uint32_t message_hash(esp_log_msg_t *message)
+{
+    char text[REPEAT_TEXT_LEN];
+    va_list args;
+    va_copy(args, message->args);
+    int len = vsnprintf(text, sizeof(text), message->format, args);
+    va_end(args);
+    uint32_t hash = 2166136261u ^ (uint32_t)len;
+    for (int i = 0; i < len && i < (int)sizeof(text) - 1; i++) {
+        hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+    }
+    return (hash != 0) ? hash : 1;
+}
+#endif // CONFIG_LOG_RATE_LIMIT_REPEAT
+
+static void get_limits(const char *tag, uint16_t *rate, uint16_t *burst)
+{
+    *rate = s_default_rate;
+    *burst = s_default_burst;
+    if (tag == NULL) {
+        return;
+    }
+    for (int i = 0; i < CONFIG_LOG_RATE_LIMIT_TAGS; i++) {
+        if (s_tag_limits[i].tag != NULL && strcmp(s_tag_limits[i].tag, tag) == 0) {
+            *rate = s_tag_limits[i].rate;
+            *burst = s_tag_limits[i].burst;
+            return;
+        }
+    }
+}
+
+/* Find the slot of a call site, or take the least recently refilled of its slots */
+static site_t *get_site(const char *format, const char *tag, uint32_t now)
+{
+    size_t index = (((uintptr_t)format >> 2) * 2654435761u) % CONFIG_LOG_RATE_LIMIT_SITES;
+    site_t *oldest = NULL;
+    for (int i = 0; i < SITE_PROBES; i++) {
+        site_t *site = &s_sites[(index + i) % CONFIG_LOG_RATE_LIMIT_SITES];
+        if (site->format == format && site->tag == tag) {
+            return site;
+        }
+        if (site->format == NULL) {
+            oldest = site;
+            break;
+        }
+        if (oldest == NULL || (int32_t)(site->refill_ms - oldest->refill_ms) < 0) {
+            oldest = site;
+        }
+    }
+    *oldest = (site_t) {
+        .format = format,
+        .tag = tag,
+        .refill_ms = now,
+    };
+    return oldest;
+}
+
+/* Take a token from the bucket of a call site, returns false if it is empty */
+static bool take_token(site_t *site, uint32_t now)
+{
+    if (site->limits_gen != s_limits_gen) {
+        get_limits(site->tag, &site->rate, &site->burst);
+        if (site->limits_gen == 0) {
+            site->tokens = site->burst * TOKEN;
+        }
+        site->limits_gen = s_limits_gen;
+    }
+    if (site->rate == 0) {
+        return true;
+    }
+    uint32_t elapsed_ms = now - site->refill_ms;
+    site->refill_ms = now;
+    uint32_t max_tokens = site->burst * TOKEN;
+    if (elapsed_ms >= max_tokens / site->rate) {
+        site->tokens = max_tokens;
+    } else {
+        site->tokens = MIN(site->tokens + elapsed_ms * site->rate, max_tokens);
+    }
+    if (site->tokens < TOKEN) {
+        return false;
+    }
+    site->tokens -= TOKEN;
+    return true;
+}
+
+bool esp_log_rate_limit_check(esp_log_msg_t *message)
+{
+    if (s_writing_note) {
+        return true;
+    }
+    uint32_t now = esp_log_timestamp();
+    const char *format = message->format;
+    const char *tag = message->tag;
+    const bool exempt = message->config.opts.dis_rate_limit;
+    bool write = true;
+    uint32_t suppressed = 0;
+#if CONFIG_LOG_RATE_LIMIT_REPEAT
+    const char *repeated_tag = NULL;
+    esp_log_level_t repeated_level = ESP_LOG_NONE;
+    uint32_t repeated = 0;
+    // s_last is read without the lock, the hash is only compared with the lock taken
+    uint32_t hash = (!exempt && format == s_last.format && tag == s_last.tag) ? message_hash(message) : 0;
+#endif
+
+    portENTER_CRITICAL(&s_lock);
+#if CONFIG_LOG_RATE_LIMIT_REPEAT
+    if (hash != 0 && format == s_last.format && tag == s_last.tag && hash == s_last.hash) {
+        s_last.count++;
+        s_repeated++;
+        portEXIT_CRITICAL(&s_lock);
+        return false;
+    }
+#endif
+    site_t *site = exempt ? NULL : get_site(format, tag, now);
+    if (site == NULL || take_token(site, now)) {
+        if (site != NULL) {
+            suppressed = site->suppressed;
+            site->suppressed = 0;
+        }
+#if CONFIG_LOG_RATE_LIMIT_REPEAT
+        repeated_tag = s_last.tag;
+        repeated_level = s_last.level;
+        repeated = s_last.count;
+        s_last.format = format;
+        s_last.tag = tag;
+        s_last.level = message->config.opts.log_level;
+        s_last.hash = hash;
+        s_last.count = 0;
+#endif
+    } else {
+        site->suppressed++;
+        s_rate_limited++;
+        write = false;
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    s_writing_note = true;
+#if CONFIG_LOG_RATE_LIMIT_REPEAT
+    if (repeated != 0) {
+        ESP_LOG_LEVEL(repeated_level, repeated_tag, "last message repeated %" PRIu32 " times", repeated);
+    }
+#endif
+    if (suppressed != 0) {
+        ESP_LOG_LEVEL(message->config.opts.log_level, tag, "%" PRIu32 " messages suppressed", suppressed);
+    }
+    s_writing_note = false;
+    return write;
+}
+
+esp_err_t esp_log_rate_limit_set(const char *tag, uint16_t rate, uint16_t burst)
+{
+    if (tag == NULL || (rate != 0 && burst == 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    bool wildcard = strcmp(tag, "*") == 0;
+    char *tag_copy = NULL;
+    if (!wildcard) {
+        tag_copy = strdup(tag);
+        if (tag_copy == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    esp_err_t err = ESP_OK;
+    portENTER_CRITICAL(&s_lock);
+    if (wildcard) {
+        s_default_rate = rate;
+        s_default_burst = burst;
+    } else {
+        tag_limit_t *entry = NULL;
+        for (int i = 0; i < CONFIG_LOG_RATE_LIMIT_TAGS; i++) {
+            if (s_tag_limits[i].tag != NULL && strcmp(s_tag_limits[i].tag, tag) == 0) {
+                entry = &s_tag_limits[i];
+                break;
+            }
+            if (s_tag_limits[i].tag == NULL && entry == NULL) {
+                entry = &s_tag_limits[i];
+            }
+        }
+        if (entry == NULL) {
+            err = ESP_ERR_NO_MEM;
+        } else {
+            if (entry->tag == NULL) {
+                entry->tag = tag_copy;
+                tag_copy = NULL;
+            }
+            entry->rate = rate;
+            entry->burst = burst;
+        }
+    }
+    // 0 is the value of the sites which have never been refreshed
+    s_limits_gen = (s_limits_gen + 1 != 0) ? s_limits_gen + 1 : 1;
+    portEXIT_CRITICAL(&s_lock);
+    free(tag_copy);
+    return err;
+}
+
+esp_err_t esp_log_rate_limit_get_stats(esp_log_rate_limit_stats_t *stats)
+{
+    if (stats == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    portENTER_CRITICAL(&s_lock);
+    stats->rate_limited = s_rate_limited;
+    stats->repeated = s_repeated;
+    portEXIT_CRITICAL(&s_lock);
+    return ESP_OK;
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include <sys/param.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+#if CONFIG_LOG_ASYNC
+
+static const char *TAG = "log_async";
+
+static char s_output[512];
+static size_t s_output_len;
+static TaskHandle_t s_output_task;
+static SemaphoreHandle_t s_output_block;
+
+static void reset_output(void)
+{
+    s_output_len = 0;
+    s_output[0] = '\0';
+}
+
+static int print_to_buffer(const char *format, va_list args)
+{
+    if (s_output_block != NULL) {
+        xSemaphoreTake(s_output_block, portMAX_DELAY);
+        xSemaphoreGive(s_output_block);
+    }
+    if (s_output_len > sizeof(s_output) - 128) {
+        // keep the latest messages
+        reset_output();
+    }
+    s_output_task = xTaskGetCurrentTaskHandle();
+    int ret = vsnprintf(&s_output[s_output_len], sizeof(s_output) - s_output_len, format, args);
+    s_output_len = MIN(s_output_len + ret, sizeof(s_output) - 1);
+    return ret;
+}
+
+TEST_CASE("async log messages are printed in order by the log task", "[log-async]")
+{
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_output();
+
+    char text[16];
+    strcpy(text, "first");
+    ESP_LOGI(TAG, "message %d %s %.1f", 1, text, 1.5);
+    strcpy(text, "second");
+    ESP_LOGI(TAG, "message %" PRIu64 " %s %c", (uint64_t)2, text, '!');
+    memset(text, 0, sizeof(text));
+
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_async_flush(1000));
+    esp_log_set_vprintf(old_vprintf);
+
+    char *first = strstr(s_output, "log_async: message 1 first 1.5");
+    char *second = strstr(s_output, "log_async: message 2 second !");
+    TEST_ASSERT_NOT_NULL(first);
+    TEST_ASSERT_NOT_NULL(second);
+    TEST_ASSERT_TRUE(first < second);
+    TEST_ASSERT_NOT_EQUAL(xTaskGetCurrentTaskHandle(), s_output_task);
+}
+
+TEST_CASE("async log writes messages which can not be deferred immediately", "[log-async]")
+{
+    esp_log_async_stats_t before, after;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_async_flush(1000));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_async_get_stats(&before));
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_output();
+
+    ESP_LOGI(TAG, "width %*d", 4, 2);
+    TEST_ASSERT_NOT_NULL(strstr(s_output, "log_async: width    2"));
+    TEST_ASSERT_EQUAL(xTaskGetCurrentTaskHandle(), s_output_task);
+
+    esp_log_set_vprintf(old_vprintf);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_async_get_stats(&after));
+    TEST_ASSERT_EQUAL(before.sync + 1, after.sync);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_log_async_get_stats(NULL));
+}
+
+TEST_CASE("async log drops messages when the buffer is full", "[log-async]")
+{
+    const int count = CONFIG_LOG_ASYNC_BUFFER_SIZE / 32;
+    esp_log_async_stats_t before, after;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_async_flush(1000));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_async_get_stats(&before));
+
+    // the log task blocks in the output function until the semaphore is given,
+    // holding the stdout lock: nothing may be printed by this task until then
+    s_output_block = xSemaphoreCreateBinary();
+    TEST_ASSERT_NOT_NULL(s_output_block);
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_output();
+    ESP_LOGI(TAG, "blocking the log task");
+    vTaskDelay(pdMS_TO_TICKS(10));
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < count; i++) {
+        ESP_LOGI(TAG, "message %d", i);
+    }
+    int64_t us_per_log = (esp_timer_get_time() - start) / count;
+    esp_err_t flush_err = esp_log_async_flush(10);
+    esp_log_async_get_stats(&after);
+
+    xSemaphoreGive(s_output_block);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_async_flush(1000));
+    vTaskDelay(pdMS_TO_TICKS(10));
+    esp_log_set_vprintf(old_vprintf);
+    vSemaphoreDelete(s_output_block);
+    s_output_block = NULL;
+
+    printf("%d messages logged in %" PRIi64 " us each\n", count, us_per_log);
+    TEST_ASSERT_LESS_THAN(50, us_per_log);
+    TEST_ASSERT_EQUAL(ESP_ERR_TIMEOUT, flush_err);
+    TEST_ASSERT_GREATER_THAN(before.dropped, after.dropped);
+    TEST_ASSERT_EQUAL(count + 1, (after.queued - before.queued) + (after.dropped - before.dropped));
+    TEST_ASSERT_GREATER_THAN(CONFIG_LOG_ASYNC_BUFFER_SIZE / 2, after.max_used);
+    TEST_ASSERT_NOT_NULL(strstr(s_output, "messages dropped"));
+}
+
+#endif // CONFIG_LOG_ASYNC
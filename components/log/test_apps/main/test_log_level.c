@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2024-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -23,6 +23,8 @@
 
 static const char * TAG1 = "ESP_LOG";
 static const char * TAG2 = "ESP_EARLY_LOG";
+ESP_LOG_TAG_DEFINE(TAG3, "ESP_LOG_TAG");
+ESP_LOG_TAG_DEFINE(TAG4, "ESP_LOG_TAG");
 
 #define BUFFER_SIZE (256)
 static unsigned s_counter = 0;
@@ -152,3 +154,34 @@ TEST_CASE("LOG_LOCAL_LEVEL can be re-defined", "[log]")
     esp_rom_install_uart_printf();
     esp_log_level_set("*", ESP_LOG_INFO);
 }
+
+TEST_CASE("level of tags defined with ESP_LOG_TAG_DEFINE can be set by name", "[log]")
+{
+#if CONFIG_LOG_MASTER_LEVEL
+    // ignore the master log feature in this test
+    esp_log_set_level_master(ESP_LOG_VERBOSE);
+#endif
+    char tag[] = "ESP_LOG_TAG"; // same name, different pointer
+    TEST_ASSERT_EQUAL(ESP_LOG_INFO, esp_log_level_get(TAG3));
+
+    esp_log_level_set(tag, ESP_LOG_DEBUG);
+    TEST_ASSERT_EQUAL(ESP_LOG_DEBUG, esp_log_level_get(TAG3));
+    TEST_ASSERT_EQUAL(ESP_LOG_DEBUG, esp_log_level_get(TAG4));
+    TEST_ASSERT_EQUAL(ESP_LOG_DEBUG, esp_log_level_get(tag));
+
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_buffer();
+    ESP_LOGD(TAG3, "There is a debug log");
+    TEST_ASSERT_NOT_NULL(strstr(get_buffer(), "There is a debug log"));
+
+    esp_log_level_set(TAG4, ESP_LOG_NONE);
+    reset_buffer();
+    ESP_LOGE(TAG3, "There is an error log");
+    TEST_ASSERT_EQUAL(0, get_counter());
+    esp_log_set_vprintf(old_vprintf);
+
+    esp_log_level_set("*", ESP_LOG_WARN);
+    TEST_ASSERT_EQUAL(ESP_LOG_WARN, esp_log_level_get(TAG3));
+    esp_log_level_set("*", ESP_LOG_INFO);
+    TEST_ASSERT_EQUAL(ESP_LOG_INFO, esp_log_level_get(TAG4));
+}
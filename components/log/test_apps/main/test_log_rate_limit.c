@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/param.h>
+#include "unity.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#if CONFIG_LOG_RATE_LIMIT
+
+static const char *TAG = "rate_limit";
+
+static char s_output[1024];
+static size_t s_output_len;
+
+static void reset_output(void)
+{
+    s_output_len = 0;
+    s_output[0] = '\0';
+}
+
+static int print_to_buffer(const char *format, va_list args)
+{
+    int ret = vsnprintf(&s_output[s_output_len], sizeof(s_output) - s_output_len, format, args);
+    s_output_len = MIN(s_output_len + ret, sizeof(s_output) - 1);
+    return ret;
+}
+
+/* A single call site for all the messages */
+static void log_message(int i)
+{
+    ESP_LOGI(TAG, "message %d", i);
+}
+
+TEST_CASE("rate limit drops the messages of a call site over its burst", "[log-rate-limit]")
+{
+    esp_log_rate_limit_stats_t before, after;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_set(TAG, 1, 3));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_get_stats(&before));
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_output();
+
+    for (int i = 0; i < 10; i++) {
+        log_message(i);
+    }
+    vTaskDelay(pdMS_TO_TICKS(1100));
+    log_message(10);
+
+    esp_log_set_vprintf(old_vprintf);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_get_stats(&after));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_set(TAG, CONFIG_LOG_RATE_LIMIT_RATE, CONFIG_LOG_RATE_LIMIT_BURST));
+
+    TEST_ASSERT_NOT_NULL(strstr(s_output, "rate_limit: message 2"));
+    TEST_ASSERT_NULL(strstr(s_output, "rate_limit: message 3"));
+    char *suppressed = strstr(s_output, "rate_limit: 7 messages suppressed");
+    char *last = strstr(s_output, "rate_limit: message 10");
+    TEST_ASSERT_NOT_NULL(suppressed);
+    TEST_ASSERT_NOT_NULL(last);
+    TEST_ASSERT_TRUE(suppressed < last);
+    TEST_ASSERT_EQUAL(before.rate_limited + 7, after.rate_limited);
+}
+
+#if CONFIG_LOG_RATE_LIMIT_REPEAT
+static void log_same(void)
+{
+    ESP_LOGI(TAG, "same message");
+}
+
+TEST_CASE("rate limit collapses repeated messages", "[log-rate-limit]")
+{
+    esp_log_rate_limit_stats_t before, after;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_set(TAG, 0, 0));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_get_stats(&before));
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_output();
+
+    for (int i = 0; i < 5; i++) {
+        log_same();
+    }
+    log_message(1);
+    log_message(2);
+
+    esp_log_set_vprintf(old_vprintf);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_get_stats(&after));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_set(TAG, CONFIG_LOG_RATE_LIMIT_RATE, CONFIG_LOG_RATE_LIMIT_BURST));
+
+    // the first repetition is written, the next ones are counted
+    char *repeated = strstr(s_output, "rate_limit: last message repeated 3 times");
+    TEST_ASSERT_NOT_NULL(repeated);
+    TEST_ASSERT_TRUE(repeated < strstr(s_output, "rate_limit: message 1"));
+    TEST_ASSERT_NOT_NULL(strstr(s_output, "rate_limit: message 2"));
+    TEST_ASSERT_EQUAL(before.repeated + 3, after.repeated);
+}
+#endif // CONFIG_LOG_RATE_LIMIT_REPEAT
+
+TEST_CASE("rate limit lets all the lines of a buffer dump through", "[log-rate-limit]")
+{
+    static const uint8_t zeros[64];
+    esp_log_rate_limit_stats_t before, after;
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_set(TAG, 1, 3));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_get_stats(&before));
+    vprintf_like_t old_vprintf = esp_log_set_vprintf(print_to_buffer);
+    reset_output();
+
+    // 4 identical lines, more than the burst
+    ESP_LOG_BUFFER_HEX(TAG, zeros, sizeof(zeros));
+
+    esp_log_set_vprintf(old_vprintf);
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_get_stats(&after));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_log_rate_limit_set(TAG, CONFIG_LOG_RATE_LIMIT_RATE, CONFIG_LOG_RATE_LIMIT_BURST));
+
+    int lines = 0;
+    for (char *line = strstr(s_output, "rate_limit: 00 00"); line != NULL; line = strstr(line + 1, "rate_limit: 00 00")) {
+        lines++;
+    }
+    TEST_ASSERT_EQUAL(4, lines);
+    TEST_ASSERT_EQUAL(before.rate_limited, after.rate_limited);
+    TEST_ASSERT_EQUAL(before.repeated, after.repeated);
+}
+
+TEST_CASE("rate limit checks its arguments", "[log-rate-limit]")
+{
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_log_rate_limit_set(NULL, 1, 1));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_log_rate_limit_set(TAG, 1, 0));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, esp_log_rate_limit_get_stats(NULL));
+}
+
+#endif // CONFIG_LOG_RATE_LIMIT
@@ -6,6 +6,21 @@ from pytest_embedded_idf.utils import idf_parametrize
 
 
 @pytest.mark.generic
+@pytest.mark.parametrize('config', ['default'], indirect=True)
 @idf_parametrize('target', ['esp32'], indirect=['target'])
 def test_esp_log(dut: Dut) -> None:
     dut.run_all_single_board_cases()
+
+
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['async'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_esp_log_async(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='log-async')
+
+
+@pytest.mark.generic
+@pytest.mark.parametrize('config', ['rate_limit'], indirect=True)
+@idf_parametrize('target', ['esp32'], indirect=['target'])
+def test_esp_log_rate_limit(dut: Dut) -> None:
+    dut.run_all_single_board_cases(group='log-rate-limit')
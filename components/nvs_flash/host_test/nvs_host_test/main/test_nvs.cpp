@@ -17,6 +17,10 @@
 #include <string.h>
 #include <string>
 #include <random>
+#include <map>
+#include <chrono>
+#include <algorithm>
+#include <vector>
 #include "test_fixtures.hpp"
 #include "spi_flash_mmap.h"
 
@@ -3973,6 +3977,696 @@ TEST_CASE("nvs find key tests", "[nvs]")
     nvs_close(handle_2);
     TEST_ESP_OK(nvs_flash_deinit_partition(NVS_DEFAULT_PART_NAME));
 }
+
+TEST_CASE("storage item index finds the same items as the lookup of all pages", "[nvs]")
+{
+    const uint32_t sectors = 6;
+    PartitionEmulationFixture f(0, sectors);
+    nvs::Storage storage(f.part());
+    TEST_ESP_OK(storage.init(0, sectors));
+    TEST_ESP_OK(storage.setItemIndexEnabled(true));
+    CHECK(storage.isItemIndexEnabled());
+
+    std::mt19937 gen(42);
+    std::map<std::pair<uint8_t, std::string>, uint32_t> values;
+    uint8_t blob[nvs::Page::CHUNK_MAX_SIZE + 100];
+
+    // overwriting values provokes page reclaims which move the indexed items between pages
+    for (size_t i = 0; i < 3000; ++i) {
+        char key[nvs::Item::MAX_KEY_LENGTH + 1];
+        const uint8_t nsIndex = 1 + gen() % 2;
+        snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(gen() % 40));
+        const uint32_t value = gen();
+        TEST_ESP_OK(storage.writeItem(nsIndex, key, value));
+        values[std::make_pair(nsIndex, std::string(key))] = value;
+        if (i % 10 == 0) {
+            TEST_ESP_OK(storage.eraseItem(nsIndex, key));
+            values.erase(std::make_pair(nsIndex, std::string(key)));
+        }
+        if (i % 500 == 0) {
+            // multi-page blob, rewritten with the alternating version offset each time
+            std::fill_n(blob, sizeof(blob), static_cast<uint8_t>(i));
+            TEST_ESP_OK(storage.writeItem(3, nvs::ItemType::BLOB, "blob", blob, sizeof(blob)));
+        }
+    }
+    CHECK(storage.getItemIndexMemoryUsage() > 0);
+    nvs_stats_t stats = {};
+    TEST_ESP_OK(storage.fillStats(stats));
+    CHECK(stats.item_index_memory == storage.getItemIndexMemoryUsage());
+
+    // the same lookups give the same results with and without the index, also after reinitialization
+    for (int pass = 0; pass < 3; ++pass) {
+        if (pass == 1) {
+            TEST_ESP_OK(storage.init(0, sectors));
+            CHECK(storage.isItemIndexEnabled());
+        } else if (pass == 2) {
+            TEST_ESP_OK(storage.setItemIndexEnabled(false));
+            CHECK(storage.getItemIndexMemoryUsage() == 0);
+        }
+        for (uint8_t nsIndex = 1; nsIndex <= 2; ++nsIndex) {
+            for (unsigned k = 0; k < 40; ++k) {
+                char key[nvs::Item::MAX_KEY_LENGTH + 1];
+                snprintf(key, sizeof(key), "key%u", k);
+                auto it = values.find(std::make_pair(nsIndex, std::string(key)));
+                uint32_t value;
+                if (it == values.end()) {
+                    CHECK(storage.readItem(nsIndex, key, value) == ESP_ERR_NVS_NOT_FOUND);
+                } else {
+                    TEST_ESP_OK(storage.readItem(nsIndex, key, value));
+                    CHECK(value == it->second);
+                }
+            }
+        }
+        uint8_t readBlob[sizeof(blob)];
+        TEST_ESP_OK(storage.readItem(3, nvs::ItemType::BLOB, "blob", readBlob, sizeof(readBlob)));
+        CHECK(memcmp(readBlob, blob, sizeof(blob)) == 0);
+    }
+
+    TEST_ESP_OK(storage.setItemIndexEnabled(true));
+    TEST_ESP_OK(storage.eraseNamespace(1));
+    uint32_t value;
+    CHECK(storage.readItem(1, "key1", value) == ESP_ERR_NVS_NOT_FOUND);
+    TEST_ESP_OK(storage.readItem(3, nvs::ItemType::BLOB, "blob", blob, sizeof(blob)));
+}
+
+TEST_CASE("storage item index lookup benchmark", "[nvs]")
+{
+    const uint32_t sectors = 64;
+    const size_t keys = 3000;
+    PartitionEmulationFixture f(0, sectors);
+    nvs::Storage storage(f.part());
+    TEST_ESP_OK(storage.init(0, sectors));
+
+    for (size_t i = 0; i < keys; ++i) {
+        char key[nvs::Item::MAX_KEY_LENGTH + 1];
+        snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+        TEST_ESP_OK(storage.writeItem(1, key, static_cast<uint32_t>(i)));
+    }
+
+    for (int enabled = 0; enabled < 2; ++enabled) {
+        TEST_ESP_OK(storage.setItemIndexEnabled(enabled));
+        esp_partition_clear_stats();
+        auto start = std::chrono::steady_clock::now();
+        // half of the lookups are for existing keys, the other half for missing ones
+        for (size_t i = 0; i < keys * 2; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+            uint32_t value;
+            CHECK(storage.readItem(1, key, value) == ((i < keys) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND));
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        s_perf << "Lookup of " << keys * 2 << " keys in " << sectors << " pages " << (enabled ? "with" : "without")
+               << " item index: " << elapsed.count() / (keys * 2) << " ns per lookup (" << esp_partition_get_read_ops()
+               << "R), index RAM " << storage.getItemIndexMemoryUsage() << " bytes" << std::endl;
+    }
+}
+
+TEST_CASE("storage transaction writes the last staged value of every key", "[nvs][txn]")
+{
+    PartitionEmulationFixture f(0, 4);
+    nvs::Storage storage(f.part());
+    TEST_ESP_OK(storage.init(0, 4));
+    TEST_ESP_OK(storage.writeItem(1, "old", static_cast<uint32_t>(1)));
+    TEST_ESP_OK(storage.writeItem(1, "kept", static_cast<uint32_t>(2)));
+
+    nvs::Transaction txn;
+    uint32_t value = 10;
+    TEST_ESP_OK(txn.set(nvs::ItemType::U32, "old", &value, sizeof(value)));
+    value = 11;
+    TEST_ESP_OK(txn.set(nvs::ItemType::U32, "old", &value, sizeof(value)));
+    const char str[] = "staged string";
+    TEST_ESP_OK(txn.set(nvs::ItemType::SZ, "str", str, strlen(str) + 1));
+    uint8_t blob[3000];
+    memset(blob, 0xa5, sizeof(blob));
+    TEST_ESP_OK(txn.set(nvs::ItemType::BLOB, "blob", blob, sizeof(blob)));
+    TEST_ESP_ERR(txn.set(nvs::ItemType::U8, "this_key_is_too_long", &value, 1), ESP_ERR_NVS_KEY_TOO_LONG);
+    CHECK(txn.size() == 3);
+
+    TEST_ESP_OK(storage.commitTransaction(1, txn));
+    CHECK(txn.size() == 3);
+
+    TEST_ESP_OK(storage.readItem(1, "old", value));
+    CHECK(value == 11);
+    TEST_ESP_OK(storage.readItem(1, "kept", value));
+    CHECK(value == 2);
+    char read_str[sizeof(str)];
+    TEST_ESP_OK(storage.readItem(1, nvs::ItemType::SZ, "str", read_str, sizeof(read_str)));
+    CHECK(strcmp(read_str, str) == 0);
+    uint8_t read_blob[sizeof(blob)];
+    TEST_ESP_OK(storage.readItem(1, nvs::ItemType::BLOB, "blob", read_blob, sizeof(read_blob)));
+    CHECK(memcmp(read_blob, blob, sizeof(blob)) == 0);
+
+    // no transaction markers and no older versions of the keys are left after the commit
+    nvs::ItemType type;
+    TEST_ESP_ERR(storage.findKey(0, nvs::Page::TXN_BEGIN_KEY, &type), ESP_ERR_NVS_NOT_FOUND);
+    TEST_ESP_ERR(storage.findKey(0, nvs::Page::TXN_COMMIT_KEY, &type), ESP_ERR_NVS_NOT_FOUND);
+    TEST_ESP_OK(storage.eraseItem(1, nvs::ItemType::U32, "old"));
+    TEST_ESP_ERR(storage.readItem(1, "old", value), ESP_ERR_NVS_NOT_FOUND);
+    TEST_ESP_OK(storage.writeItem(1, "old", static_cast<uint32_t>(11)));
+
+    // the values survive re-init
+    nvs::Storage storage2(f.part());
+    TEST_ESP_OK(storage2.init(0, 4));
+    TEST_ESP_OK(storage2.readItem(1, "old", value));
+    CHECK(value == 11);
+    TEST_ESP_OK(storage2.readItem(1, nvs::ItemType::BLOB, "blob", read_blob, sizeof(read_blob)));
+    CHECK(memcmp(read_blob, blob, sizeof(blob)) == 0);
+}
+
+TEST_CASE("storage transaction is applied completely or not at all after power-off", "[nvs][txn]")
+{
+    const size_t keys = 40;
+    for (size_t fail_after = 1; ; ++fail_after) {
+        PartitionEmulationFixture f(0, 5);
+        {
+            nvs::Storage storage(f.part());
+            TEST_ESP_OK(storage.init(0, 5));
+            for (size_t i = 0; i < keys; ++i) {
+                char key[nvs::Item::MAX_KEY_LENGTH + 1];
+                snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+                TEST_ESP_OK(storage.writeItem(1, key, static_cast<uint32_t>(i)));
+            }
+
+            nvs::Transaction txn;
+            for (size_t i = 0; i < keys; ++i) {
+                char key[nvs::Item::MAX_KEY_LENGTH + 1];
+                snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+                uint32_t value = static_cast<uint32_t>(i + 1000);
+                TEST_ESP_OK(txn.set(nvs::ItemType::U32, key, &value, sizeof(value)));
+            }
+
+            esp_partition_clear_stats();
+            esp_partition_fail_after(fail_after, ESP_PARTITION_FAIL_AFTER_MODE_BOTH);
+            esp_err_t err = storage.commitTransaction(1, txn);
+            esp_partition_fail_after(SIZE_MAX, ESP_PARTITION_FAIL_AFTER_MODE_BOTH);
+            if (err == ESP_OK) {
+                break;
+            }
+            CHECK(err == ESP_ERR_FLASH_OP_FAIL);
+        }
+
+        nvs::Storage storage(f.part());
+        TEST_ESP_OK(storage.init(0, 5));
+        uint32_t first;
+        TEST_ESP_OK(storage.readItem(1, "key0", first));
+        const uint32_t offset = (first == 0) ? 0 : 1000;
+        CHECK(first == offset);
+        for (size_t i = 1; i < keys; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+            uint32_t value;
+            TEST_ESP_OK(storage.readItem(1, key, value));
+            CHECK(value == i + offset);
+        }
+    }
+}
+
+TEST_CASE("storage transaction flash operations benchmark", "[nvs][txn]")
+{
+    const uint32_t sectors = 8;
+    const size_t keys = 200;
+    // every key is written twice, the way an application saving its whole configuration would do
+    const size_t writes = keys * 2;
+
+    for (int batched = 0; batched < 2; ++batched) {
+        PartitionEmulationFixture f(0, sectors);
+        nvs::Storage storage(f.part());
+        TEST_ESP_OK(storage.init(0, sectors));
+        for (size_t i = 0; i < keys; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+            TEST_ESP_OK(storage.writeItem(1, key, static_cast<uint32_t>(i)));
+        }
+
+        esp_partition_clear_stats();
+        nvs::Transaction txn;
+        for (size_t i = 0; i < writes; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i % keys));
+            uint32_t value = static_cast<uint32_t>(i + 1000);
+            if (batched) {
+                TEST_ESP_OK(txn.set(nvs::ItemType::U32, key, &value, sizeof(value)));
+            } else {
+                TEST_ESP_OK(storage.writeItem(1, key, value));
+            }
+        }
+        if (batched) {
+            TEST_ESP_OK(storage.commitTransaction(1, txn));
+        }
+
+        for (size_t i = 0; i < keys; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+            uint32_t value;
+            TEST_ESP_OK(storage.readItem(1, key, value));
+            CHECK(value == i + keys + 1000);
+        }
+        s_perf << "Writing " << writes << " values of " << keys << " keys " << (batched ? "in one transaction" : "one by one")
+               << ": " << esp_partition_get_erase_ops() << "E " << esp_partition_get_write_ops() << "W "
+               << esp_partition_get_write_bytes() << "Wb" << std::endl;
+    }
+}
+
+TEST_CASE("nvs api transaction", "[nvs][txn]")
+{
+    PartitionEmulationFixture f(0, 4);
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), 0, 4));
+    nvs_handle_t handle;
+    TEST_ESP_OK(nvs_open("test", NVS_READWRITE, &handle));
+    TEST_ESP_OK(nvs_set_i32(handle, "foo", 1));
+
+    TEST_ESP_ERR(nvs_txn_commit(handle), ESP_ERR_INVALID_STATE);
+    TEST_ESP_OK(nvs_txn_begin(handle));
+    TEST_ESP_ERR(nvs_txn_begin(handle), ESP_ERR_INVALID_STATE);
+    TEST_ESP_OK(nvs_set_i32(handle, "foo", 2));
+    TEST_ESP_OK(nvs_set_i32(handle, "foo", 3));
+    TEST_ESP_OK(nvs_set_str(handle, "str", "value"));
+    TEST_ESP_ERR(nvs_erase_key(handle, "foo"), ESP_ERR_INVALID_STATE);
+    TEST_ESP_ERR(nvs_erase_all(handle), ESP_ERR_INVALID_STATE);
+
+    // reads through the same handle see the staged values
+    int32_t v;
+    TEST_ESP_OK(nvs_get_i32(handle, "foo", &v));
+    CHECK(v == 3);
+    TEST_ESP_ERR(nvs_get_u8(handle, "foo", reinterpret_cast<uint8_t*>(&v)), ESP_ERR_NVS_NOT_FOUND);
+    size_t len = 0;
+    TEST_ESP_OK(nvs_get_str(handle, "str", nullptr, &len));
+    CHECK(len == strlen("value") + 1);
+
+    // other handles don't see them until the commit
+    nvs_handle_t other;
+    TEST_ESP_OK(nvs_open("test", NVS_READONLY, &other));
+    TEST_ESP_OK(nvs_get_i32(other, "foo", &v));
+    CHECK(v == 1);
+    TEST_ESP_ERR(nvs_get_str(other, "str", nullptr, &len), ESP_ERR_NVS_NOT_FOUND);
+
+    TEST_ESP_OK(nvs_txn_commit(handle));
+    TEST_ESP_OK(nvs_get_i32(other, "foo", &v));
+    CHECK(v == 3);
+    TEST_ESP_OK(nvs_get_str(other, "str", nullptr, &len));
+
+    // aborted transaction leaves the storage untouched
+    TEST_ESP_ERR(nvs_txn_abort(handle), ESP_ERR_INVALID_STATE);
+    TEST_ESP_OK(nvs_txn_begin(handle));
+    TEST_ESP_OK(nvs_set_i32(handle, "foo", 4));
+    TEST_ESP_OK(nvs_txn_abort(handle));
+    TEST_ESP_OK(nvs_get_i32(handle, "foo", &v));
+    CHECK(v == 3);
+
+    nvs_close(other);
+    nvs_close(handle);
+    TEST_ESP_OK(nvs_flash_deinit_partition(f.part()->get_partition_name()));
+}
+
+TEST_CASE("storage read cache returns current values", "[nvs][cache]")
+{
+    PartitionEmulationFixture f(0, 4);
+    nvs::Storage storage(f.part());
+    storage.setReadCacheSize(2);
+    TEST_ESP_OK(storage.init(0, 4));
+
+    TEST_ESP_OK(storage.writeItem(1, "u32", static_cast<uint32_t>(1)));
+    TEST_ESP_OK(storage.writeItem(2, "u32", static_cast<uint32_t>(2)));
+    const char str[] = "short string";
+    TEST_ESP_OK(storage.writeItem(1, nvs::ItemType::SZ, "str", str, sizeof(str)));
+
+    uint32_t value;
+    TEST_ESP_OK(storage.readItem(1, "u32", value));
+    esp_partition_clear_stats();
+    TEST_ESP_OK(storage.readItem(1, "u32", value));
+    CHECK(value == 1);
+    CHECK(esp_partition_get_read_ops() == 0);
+
+    // the datatype and the namespace are a part of the key
+    uint8_t u8;
+    TEST_ESP_ERR(storage.readItem(1, "u32", u8), ESP_ERR_NVS_NOT_FOUND);
+    TEST_ESP_OK(storage.readItem(2, "u32", value));
+    CHECK(value == 2);
+
+    // strings are read with the same length checks as from flash
+    size_t size;
+    TEST_ESP_OK(storage.getItemDataSize(1, nvs::ItemType::SZ, "str", size));
+    char buf[sizeof(str)];
+    TEST_ESP_OK(storage.readItem(1, nvs::ItemType::SZ, "str", buf, sizeof(buf)));
+    TEST_ESP_OK(storage.getItemDataSize(1, nvs::ItemType::SZ, "str", size));
+    CHECK(size == sizeof(str));
+    TEST_ESP_ERR(storage.readItem(1, nvs::ItemType::SZ, "str", buf, sizeof(buf) - 1), ESP_ERR_NVS_INVALID_LENGTH);
+    TEST_ESP_OK(storage.readItem(1, nvs::ItemType::SZ, "str", buf, sizeof(buf)));
+    CHECK(strcmp(buf, str) == 0);
+
+    // writes and erases drop the cached values
+    TEST_ESP_OK(storage.readItem(1, "u32", value));
+    TEST_ESP_OK(storage.writeItem(1, "u32", static_cast<uint32_t>(3)));
+    TEST_ESP_OK(storage.readItem(1, "u32", value));
+    CHECK(value == 3);
+    TEST_ESP_OK(storage.eraseItem(1, "u32"));
+    TEST_ESP_ERR(storage.readItem(1, "u32", value), ESP_ERR_NVS_NOT_FOUND);
+    TEST_ESP_OK(storage.readItem(2, "u32", value));
+    TEST_ESP_OK(storage.eraseNamespace(2));
+    TEST_ESP_ERR(storage.readItem(2, "u32", value), ESP_ERR_NVS_NOT_FOUND);
+
+    nvs::Transaction txn;
+    TEST_ESP_OK(storage.readItem(1, nvs::ItemType::SZ, "str", buf, sizeof(buf)));
+    TEST_ESP_OK(txn.set(nvs::ItemType::SZ, "str", "new", 4));
+    TEST_ESP_OK(storage.commitTransaction(1, txn));
+    TEST_ESP_OK(storage.readItem(1, nvs::ItemType::SZ, "str", buf, sizeof(buf)));
+    CHECK(strcmp(buf, "new") == 0);
+
+    nvs_cache_stats_t stats;
+    storage.fillCacheStats(stats);
+    CHECK(stats.max_items == 2);
+    CHECK(stats.cached_items <= 2);
+    CHECK(stats.hits >= 5);
+    CHECK(stats.evictions > 0);
+}
+
+TEST_CASE("storage read cache benchmark", "[nvs][cache]")
+{
+    const uint32_t sectors = 8;
+    const size_t keys = 8;
+    const size_t reads = 1000;
+
+    for (int cached = 0; cached < 2; ++cached) {
+        PartitionEmulationFixture f(0, sectors);
+        nvs::Storage storage(f.part());
+        storage.setReadCacheSize(cached ? 16 : 0);
+        TEST_ESP_OK(storage.init(0, sectors));
+        // the hot keys are surrounded by other items, the way configuration values usually are
+        for (size_t i = 0; i < 200; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "cold%u", static_cast<unsigned>(i));
+            TEST_ESP_OK(storage.writeItem(1, key, static_cast<uint32_t>(i)));
+            if (i < keys) {
+                snprintf(key, sizeof(key), "hot%u", static_cast<unsigned>(i));
+                TEST_ESP_OK(storage.writeItem(1, key, static_cast<uint32_t>(i)));
+            }
+        }
+
+        esp_partition_clear_stats();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < reads; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "hot%u", static_cast<unsigned>(i % keys));
+            uint32_t value;
+            TEST_ESP_OK(storage.readItem(1, key, value));
+            CHECK(value == i % keys);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+        nvs_cache_stats_t stats;
+        storage.fillCacheStats(stats);
+        CHECK(stats.hits == (cached ? reads - keys : 0));
+        s_perf << "Reading " << keys << " keys " << reads << " times " << (cached ? "with" : "without") << " read cache: "
+               << elapsed.count() / reads << " ns per read (" << esp_partition_get_read_ops() << "R "
+               << esp_partition_get_read_bytes() << "Rb), " << stats.hits << " hits " << stats.misses << " misses" << std::endl;
+    }
+}
+
+TEST_CASE("storage reclaims pages in steps without losing items on power-off", "[nvs][reclaim]")
+{
+    const size_t keys = 30;
+    const size_t writes = 300;
+    bool finished = false;
+    for (size_t fail_after = 1; !finished; ++fail_after) {
+        PartitionEmulationFixture f(0, 4);
+        {
+            nvs::Storage storage(f.part());
+            TEST_ESP_OK(storage.init(0, 4));
+            TEST_ESP_OK(storage.setItemIndexEnabled(true));
+            for (size_t i = 0; i < writes; ++i) {
+                char key[nvs::Item::MAX_KEY_LENGTH + 1];
+                snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i % keys));
+                TEST_ESP_OK(storage.writeItem(1, key, static_cast<uint32_t>(i)));
+            }
+
+            esp_partition_clear_stats();
+            esp_partition_fail_after(fail_after, ESP_PARTITION_FAIL_AFTER_MODE_BOTH);
+            esp_err_t err;
+            do {
+                err = storage.reclaimStep(8);
+            } while (err == ESP_ERR_NOT_FINISHED);
+            esp_partition_fail_after(SIZE_MAX, ESP_PARTITION_FAIL_AFTER_MODE_BOTH);
+            if (err == ESP_OK) {
+                // the pages are reclaimed, the following writes don't need to erase a sector
+                nvs_stats_t stats;
+                TEST_ESP_OK(storage.fillStats(stats));
+                CHECK(stats.free_entries >= 2 * nvs::Page::ENTRY_COUNT);
+                CHECK(esp_partition_get_erase_ops() > 0);
+                finished = true;
+            } else {
+                CHECK(err == ESP_ERR_FLASH_OP_FAIL);
+            }
+        }
+
+        nvs::Storage storage(f.part());
+        TEST_ESP_OK(storage.init(0, 4));
+        for (size_t i = writes - keys; i < writes; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i % keys));
+            uint32_t value;
+            TEST_ESP_OK(storage.readItem(1, key, value));
+            CHECK(value == i);
+        }
+    }
+}
+
+TEST_CASE("nvs_flash_reclaim_step rejects steps of zero entries", "[nvs][reclaim]")
+{
+    PartitionEmulationFixture f(0, 4);
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), 0, 4));
+    nvs_handle_t handle;
+    TEST_ESP_OK(nvs_open("test", NVS_READWRITE, &handle));
+    for (uint32_t i = 0; i < 300; ++i) {
+        char key[nvs::Item::MAX_KEY_LENGTH + 1];
+        snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i % 30));
+        TEST_ESP_OK(nvs_set_u32(handle, key, i));
+    }
+
+    const char* part_name = f.part()->get_partition_name();
+    TEST_ESP_ERR(nvs_flash_reclaim_step(part_name, 0), ESP_ERR_INVALID_ARG);
+    esp_err_t err;
+    size_t steps = 0;
+    do {
+        err = nvs_flash_reclaim_step(part_name, 1);
+        ++steps;
+    } while (err == ESP_ERR_NOT_FINISHED && steps < 1000);
+    TEST_ESP_OK(err);
+
+    nvs_close(handle);
+    TEST_ESP_OK(nvs_flash_deinit_partition(part_name));
+}
+
+TEST_CASE("storage write latency with and without background reclaim", "[nvs][reclaim]")
+{
+    const uint32_t sectors = 8;
+    const size_t keys = 100;
+    const size_t writes = 5000;
+
+    for (int background = 0; background < 2; ++background) {
+        PartitionEmulationFixture f(0, sectors);
+        nvs::Storage storage(f.part());
+        TEST_ESP_OK(storage.init(0, sectors));
+
+        std::mt19937 gen(42);
+        std::vector<size_t> latencies;
+        size_t inline_erases = 0;
+        for (size_t i = 0; i < writes; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(gen() % keys));
+            esp_partition_clear_stats();
+            TEST_ESP_OK(storage.writeItem(1, key, static_cast<uint32_t>(i)));
+            latencies.push_back(esp_partition_get_total_time());
+            if (esp_partition_get_erase_ops() > 0) {
+                ++inline_erases;
+            }
+
+            if (background) {
+                // what a low priority task would do between the writes
+                esp_err_t err = storage.reclaimStep(16);
+                CHECK((err == ESP_OK || err == ESP_ERR_NOT_FINISHED));
+            }
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        if (background) {
+            CHECK(inline_erases == 0);
+        }
+        s_perf << "Write latency " << (background ? "with" : "without") << " background reclaim: p50 "
+               << latencies[writes / 2] << " us, p99 " << latencies[writes * 99 / 100] << " us, p99.9 "
+               << latencies[writes * 999 / 1000] << " us, max "
+               << latencies.back() << " us, " << inline_erases << " of " << writes << " writes erased a sector" << std::endl;
+    }
+}
+
+TEST_CASE("storage mount reads the items of a large partition a bounded number of times", "[nvs][mount]")
+{
+    const uint32_t sectors = 64;
+    const size_t blob_size = 300;
+    uint8_t blob[blob_size];
+    PartitionEmulationFixture f(0, sectors);
+    {
+        nvs::Storage storage(f.part());
+        TEST_ESP_OK(storage.init(0, sectors));
+        uint8_t ns1, ns2;
+        TEST_ESP_OK(storage.createOrOpenNamespace("ns1", true, ns1));
+        TEST_ESP_OK(storage.createOrOpenNamespace("ns2", true, ns2));
+        for (size_t i = 0; i < 4000; ++i) {
+            char key[nvs::Item::MAX_KEY_LENGTH + 1];
+            snprintf(key, sizeof(key), "key%u", static_cast<unsigned>(i));
+            if (i % 50 == 0) {
+                memset(blob, static_cast<int>(i), sizeof(blob));
+                TEST_ESP_OK(storage.writeItem(ns2, nvs::ItemType::BLOB, key, blob, sizeof(blob)));
+            } else {
+                TEST_ESP_OK(storage.writeItem(ns1, key, static_cast<uint32_t>(i)));
+            }
+        }
+    }
+
+    esp_partition_clear_stats();
+    nvs::Storage storage(f.part());
+    TEST_ESP_OK(storage.init(0, sectors));
+    const size_t reads = esp_partition_get_read_ops();
+    const size_t time = esp_partition_get_total_time();
+
+    nvs_stats_t stats;
+    TEST_ESP_OK(storage.fillStats(stats));
+    CHECK(stats.namespace_count == 2);
+    // the pages are loaded in one pass, namespaces and blob indices are collected in another one,
+    // and the blob data are checked against the blob indices in the last one
+    CHECK(reads <= 3 * stats.used_entries + 2 * sectors);
+
+    uint8_t ns2;
+    TEST_ESP_OK(storage.createOrOpenNamespace("ns2", false, ns2));
+    uint8_t buf[blob_size];
+    TEST_ESP_OK(storage.readItem(ns2, nvs::ItemType::BLOB, "key3800", buf, sizeof(buf)));
+    CHECK(buf[0] == static_cast<uint8_t>(3800));
+
+    s_perf << "Mounting " << sectors << " pages with " << stats.used_entries << " used entries: "
+           << reads << " reads, " << time << " us" << std::endl;
+}
+
+TEST_CASE("storage blob reader returns the chunks of a multi-page blob", "[nvs][blob]")
+{
+    const size_t sectors = 8;
+    const size_t blob_size = nvs::Page::CHUNK_MAX_SIZE * 2 + 1000;
+    std::vector<uint8_t> blob(blob_size);
+    for (size_t i = 0; i < blob_size; ++i) {
+        blob[i] = static_cast<uint8_t>(i * 7);
+    }
+    PartitionEmulationFixture f(0, sectors);
+    nvs::Storage storage(f.part());
+    TEST_ESP_OK(storage.init(0, sectors));
+    TEST_ESP_OK(storage.writeItem(1, "pad", static_cast<uint32_t>(1)));
+
+    for (int version = 0; version < 2; ++version) {
+        TEST_ESP_OK(storage.writeItem(1, nvs::ItemType::BLOB, "cert", blob.data(), blob.size()));
+
+        nvs_opaque_blob_reader_t reader;
+        TEST_ESP_OK(storage.openBlobReader(&reader, 1, "cert"));
+        CHECK(reader.dataSize == blob_size);
+
+        esp_partition_clear_stats();
+        std::vector<uint8_t> data;
+        nvs_blob_chunk_t chunk;
+        size_t chunks = 0;
+        esp_err_t err;
+        while ((err = storage.nextBlobChunk(&reader, chunk)) == ESP_OK) {
+            CHECK(chunk.mapped);
+            CHECK(chunk.offset == data.size());
+            CHECK(chunk.chunk_index == chunks);
+            // the second version of the blob is written with the other version offset
+            CHECK(chunk.ver_offset == (version == 0 ? 0x00 : 0x80));
+            const uint8_t *p = static_cast<const uint8_t *>(chunk.data);
+            data.insert(data.end(), p, p + chunk.size);
+            ++chunks;
+        }
+        TEST_ESP_ERR(err, ESP_ERR_NVS_NOT_FOUND);
+        storage.closeBlobReader(&reader);
+        CHECK(chunks > 1);
+        CHECK(data == blob);
+        // only the item headers are read, the data come straight from the mapped flash
+        CHECK(esp_partition_get_read_bytes() < chunks * 2 * sizeof(nvs::Item));
+    }
+
+    // chunks which don't add up to the length recorded in the blob index are reported after the last one
+    {
+        nvs_opaque_blob_reader_t reader;
+        TEST_ESP_OK(storage.openBlobReader(&reader, 1, "cert"));
+        reader.dataSize += 1;
+        nvs_blob_chunk_t chunk;
+        esp_err_t err;
+        while ((err = storage.nextBlobChunk(&reader, chunk)) == ESP_OK) {
+        }
+        TEST_ESP_ERR(err, ESP_ERR_NVS_INVALID_LENGTH);
+        storage.closeBlobReader(&reader);
+    }
+
+    nvs_opaque_blob_reader_t reader;
+    TEST_ESP_ERR(storage.openBlobReader(&reader, 1, "missing"), ESP_ERR_NVS_NOT_FOUND);
+
+    // partitions which can't be mapped, like encrypted ones, return the chunks in a heap buffer
+    class UnmappedPartition : public nvs::NVSPartition
+    {
+    public:
+        UnmappedPartition(const esp_partition_t *partition) : NVSPartition(partition) { }
+
+        esp_err_t mmap(size_t, size_t, const void **, esp_partition_mmap_handle_t *) override
+        {
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+    };
+    UnmappedPartition unmapped(f.get_esp_partition());
+    nvs::Storage unmappedStorage(&unmapped);
+    TEST_ESP_OK(unmappedStorage.init(0, sectors));
+    TEST_ESP_OK(unmappedStorage.openBlobReader(&reader, 1, "cert"));
+    std::vector<uint8_t> data;
+    nvs_blob_chunk_t chunk;
+    while (unmappedStorage.nextBlobChunk(&reader, chunk) == ESP_OK) {
+        CHECK_FALSE(chunk.mapped);
+        const uint8_t *p = static_cast<const uint8_t *>(chunk.data);
+        data.insert(data.end(), p, p + chunk.size);
+    }
+    unmappedStorage.closeBlobReader(&reader);
+    CHECK(data == blob);
+}
+
+TEST_CASE("nvs api blob reader", "[nvs][blob]")
+{
+    PartitionEmulationFixture f(0, 5);
+    TEST_ESP_OK(nvs::NVSPartitionManager::get_instance()->init_custom(f.part(), 0, 5));
+    nvs_handle_t handle;
+    TEST_ESP_OK(nvs_open("test", NVS_READWRITE, &handle));
+
+    std::vector<uint8_t> blob(nvs::Page::CHUNK_MAX_SIZE + 500, 0x5a);
+    TEST_ESP_OK(nvs_set_blob(handle, "cert", blob.data(), blob.size()));
+
+    nvs_blob_reader_t reader;
+    size_t length = 0;
+    TEST_ESP_ERR(nvs_blob_reader_open(handle, "cert", nullptr, &length), ESP_ERR_INVALID_ARG);
+    TEST_ESP_ERR(nvs_blob_reader_open(handle, "none", &reader, &length), ESP_ERR_NVS_NOT_FOUND);
+    CHECK(reader == nullptr);
+    TEST_ESP_OK(nvs_blob_reader_open(handle, "cert", &reader, &length));
+    CHECK(length == blob.size());
+
+    nvs_blob_chunk_t chunk;
+    size_t total = 0;
+    while (nvs_blob_reader_next(reader, &chunk) == ESP_OK) {
+        CHECK(memcmp(chunk.data, blob.data() + chunk.offset, chunk.size) == 0);
+        total += chunk.size;
+    }
+    CHECK(total == blob.size());
+    nvs_blob_reader_close(reader);
+
+    // a blob staged by an open transaction can only be read with nvs_get_blob
+    TEST_ESP_OK(nvs_txn_begin(handle));
+    TEST_ESP_OK(nvs_set_blob(handle, "cert", blob.data(), 10));
+    TEST_ESP_ERR(nvs_blob_reader_open(handle, "cert", &reader, nullptr), ESP_ERR_INVALID_STATE);
+    TEST_ESP_OK(nvs_txn_abort(handle));
+
+    nvs_close(handle);
+    TEST_ESP_OK(nvs_flash_deinit_partition(NVS_DEFAULT_PART_NAME));
+}
+
 /* Add new tests above */
 /* This test has to be the final one */
 
@@ -843,7 +843,7 @@ void test_Page_calcEntries__uninit()
     NVSPageFixture fix;
     TEST_ASSERT_EQUAL(Page::PageState::UNINITIALIZED, fix.page.state());
 
-    nvs_stats_t nvsStats = {0, 0, 0, 0, 0};
+    nvs_stats_t nvsStats = {0, 0, 0, 0, 0, 0};
 
     TEST_ASSERT_EQUAL(ESP_OK, fix.page.calcEntries(nvsStats));
     TEST_ASSERT_EQUAL(0, nvsStats.used_entries);
@@ -868,7 +868,7 @@ void test_Page_calcEntries__corrupt()
 
     TEST_ASSERT_EQUAL(Page::PageState::CORRUPT, page.state());
 
-    nvs_stats_t nvsStats = {0, 0, 0, 0, 0};
+    nvs_stats_t nvsStats = {0, 0, 0, 0, 0, 0};
 
     TEST_ASSERT_EQUAL(ESP_OK, page.calcEntries(nvsStats));
     TEST_ASSERT_EQUAL(0, nvsStats.used_entries);
@@ -881,7 +881,7 @@ void test_Page_calcEntries__active_wo_blob()
 {
     NVSValidPageFixture fix;
 
-    nvs_stats_t nvsStats = {0, 0, 0, 0, 0};
+    nvs_stats_t nvsStats = {0, 0, 0, 0, 0, 0};
 
     TEST_ASSERT_EQUAL(ESP_OK, fix.page.calcEntries(nvsStats));
     TEST_ASSERT_EQUAL(2, nvsStats.used_entries);
@@ -894,7 +894,7 @@ void test_Page_calcEntries__active_with_blob()
 {
     NVSValidBlobPageFixture fix;
 
-    nvs_stats_t nvsStats = {0, 0, 0, 0, 0};
+    nvs_stats_t nvsStats = {0, 0, 0, 0, 0, 0};
 
     TEST_ASSERT_EQUAL(ESP_OK, fix.page.calcEntries(nvsStats));
     TEST_ASSERT_EQUAL(4, nvsStats.used_entries);
@@ -907,7 +907,7 @@ void test_Page_calcEntries__invalid()
 {
     Page page;
 
-    nvs_stats_t nvsStats = {0, 0, 0, 0, 0};
+    nvs_stats_t nvsStats = {0, 0, 0, 0, 0, 0};
 
     TEST_ASSERT_EQUAL(Page::PageState::INVALID, page.state());
 
@@ -127,6 +127,23 @@ typedef struct {
  */
 typedef struct nvs_opaque_iterator_t *nvs_iterator_t;
 
+/**
+ * Opaque pointer type representing a reader of the chunks of a blob
+ */
+typedef struct nvs_opaque_blob_reader_t *nvs_blob_reader_t;
+
+/**
+ * @brief View of one chunk of a blob obtained from nvs_blob_reader_next function
+ */
+typedef struct {
+    const void *data;       /*!< Data of the chunk. Valid until the next call to nvs_blob_reader_next or nvs_blob_reader_close */
+    size_t size;            /*!< Size of the chunk in bytes */
+    size_t offset;          /*!< Offset of the chunk within the blob */
+    uint8_t ver_offset;     /*!< Version offset of the chunks of the blob, 0x00 or 0x80 */
+    uint8_t chunk_index;    /*!< Index of the chunk within the blob, starting at 0 */
+    bool mapped;            /*!< True if data points to memory mapped flash, false if it points to a heap buffer */
+} nvs_blob_chunk_t;
+
 /**
  * @brief      Open non-volatile storage with a given namespace from the default NVS partition
  *
@@ -501,6 +518,74 @@ esp_err_t nvs_get_str (nvs_handle_t handle, const char* key, char* out_value, si
 esp_err_t nvs_get_blob(nvs_handle_t handle, const char* key, void* out_value, size_t* length);
 /**@}*/
 
+/**
+ * @brief      Open a reader returning the chunks of a blob one at a time
+ *
+ * Blobs are stored in chunks of up to about 4000 bytes, which may be spread over several pages.
+ * Instead of copying the whole blob into one buffer like nvs_get_blob, the reader returns a view
+ * of one chunk at a time. If the partition can be memory mapped, the view points directly into
+ * the mapped flash. On encrypted partitions and partitions on external flash chips, the chunk is
+ * read into a heap buffer of the size of the chunk.
+ *
+ * \code{c}
+ * // Example of streaming a blob to a parser:
+ * nvs_blob_reader_t reader;
+ * size_t length;
+ * esp_err_t err = nvs_blob_reader_open(my_handle, "cert", &reader, &length);
+ * if (err == ESP_OK) {
+ *     nvs_blob_chunk_t chunk;
+ *     while ((err = nvs_blob_reader_next(reader, &chunk)) == ESP_OK) {
+ *         parser_feed(chunk.data, chunk.size);
+ *     }
+ *     nvs_blob_reader_close(reader);
+ * }
+ * \endcode
+ *
+ * The views must not be used after the partition has been written to: writing other keys may
+ * erase the page holding the chunk. The reader has to be closed before the partition is deinitialized.
+ *
+ * @param[in]   handle      Handle obtained from nvs_open function.
+ * @param[in]   key         Key name. Maximum length is (NVS_KEY_NAME_MAX_SIZE-1) characters. Shouldn't be empty.
+ * @param[out]  out_reader  Pointer to the reader, which has to be released by nvs_blob_reader_close.
+ *                          Set to NULL in case of an error.
+ * @param[out]  out_length  Pointer to the variable receiving the length of the blob. May be NULL.
+ *
+ * @return
+ *             - ESP_OK if the reader has been created
+ *             - ESP_ERR_NVS_NOT_FOUND if the requested key doesn't exist
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_INVALID_STATE if the blob has been changed by the open transaction of the handle
+ *             - ESP_ERR_NO_MEM if the memory for the reader could not be allocated
+ *             - ESP_ERR_INVALID_ARG if key or out_reader is NULL
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_blob_reader_open(nvs_handle_t handle, const char* key, nvs_blob_reader_t* out_reader, size_t* out_length);
+
+/**
+ * @brief      Get the next chunk of the blob
+ *
+ * The view returned by the previous call is released.
+ *
+ * @param[in]   reader     Reader obtained from nvs_blob_reader_open function.
+ * @param[out]  out_chunk  Pointer to the structure receiving the view of the chunk.
+ *
+ * @return
+ *             - ESP_OK if the next chunk has been returned
+ *             - ESP_ERR_NVS_NOT_FOUND if all chunks have been returned, or if a chunk is missing
+ *             - ESP_ERR_NVS_INVALID_LENGTH if the chunks don't add up to the length of the blob
+ *             - ESP_ERR_NO_MEM if the buffer for the chunk could not be allocated
+ *             - ESP_ERR_INVALID_ARG if reader or out_chunk is NULL
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_blob_reader_next(nvs_blob_reader_t reader, nvs_blob_chunk_t* out_chunk);
+
+/**
+ * @brief      Release the reader and the view of the last chunk
+ *
+ * @param[in]  reader  Reader obtained from nvs_blob_reader_open function. If NULL, nothing is done.
+ */
+void nvs_blob_reader_close(nvs_blob_reader_t reader);
+
 /**
  * @brief      Lookup key-value pair with given key name.
  *
@@ -576,6 +661,63 @@ esp_err_t nvs_erase_all(nvs_handle_t handle);
  */
 esp_err_t nvs_commit(nvs_handle_t handle);
 
+/**
+ * @brief      Start a transaction on the handle
+ *
+ * Until the transaction is ended by nvs_txn_commit() or nvs_txn_abort(), the values set through
+ * this handle by the nvs_set_* functions are kept in RAM only. Setting the same key several times keeps
+ * only the last value. The nvs_get_* and nvs_find_key functions called with this handle return the staged
+ * values. nvs_erase_key() and nvs_erase_all() return ESP_ERR_INVALID_STATE while a transaction is open.
+ *
+ * Closing the handle discards an open transaction.
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *                     Handles that were opened read only cannot be used.
+ *
+ * @return
+ *             - ESP_OK if the transaction has been started
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_NVS_READ_ONLY if handle was opened as read only
+ *             - ESP_ERR_INVALID_STATE if a transaction is already open on the handle
+ *             - ESP_ERR_NO_MEM if memory could not be allocated for the transaction
+ */
+esp_err_t nvs_txn_begin(nvs_handle_t handle);
+
+/**
+ * @brief      Write all values staged by the transaction and end it
+ *
+ * The values are appended to the storage before any of the older values are erased. If power is lost during
+ * the commit, the next nvs_flash_init() either completes or reverts the transaction, so that either all
+ * values of the transaction are present or none of them.
+ *
+ * While the values are written, only the pages written before the transaction can be reclaimed. The
+ * transaction is ended even if the commit fails, none of its values are written in that case. If a flash
+ * operation fails in a way that the transaction can't be reverted right away, the storage returns
+ * ESP_ERR_NVS_NOT_INITIALIZED until it is deinitialized and initialized again.
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *
+ * @return
+ *             - ESP_OK if all values have been written
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_INVALID_STATE if there is no open transaction on the handle
+ *             - ESP_ERR_NVS_NOT_ENOUGH_SPACE if there is not enough space to write all values of the transaction
+ *             - other error codes from the underlying storage driver
+ */
+esp_err_t nvs_txn_commit(nvs_handle_t handle);
+
+/**
+ * @brief      Discard all values staged by the transaction and end it
+ *
+ * @param[in]  handle  Storage handle obtained with nvs_open.
+ *
+ * @return
+ *             - ESP_OK if the transaction has been discarded
+ *             - ESP_ERR_NVS_INVALID_HANDLE if handle has been closed or is NULL
+ *             - ESP_ERR_INVALID_STATE if there is no open transaction on the handle
+ */
+esp_err_t nvs_txn_abort(nvs_handle_t handle);
+
 /**
  * @brief      Close the storage handle and free any allocated resources
  *
@@ -598,13 +740,14 @@ typedef struct {
     size_t available_entries; /**< Number of entries available for data storage. */
     size_t total_entries;     /**< Number of all entries. */
     size_t namespace_count;   /**< Number of namespaces. */
+    size_t item_index_memory; /**< Bytes of RAM used by the item index, 0 if CONFIG_NVS_STORAGE_ITEM_INDEX is disabled. */
 } nvs_stats_t;
 
 /**
  * @brief      Fill structure nvs_stats_t. It provides info about memory used by NVS.
  *
  * This function calculates the number of used entries, free entries, available entries, total entries
- * and number of namespaces in partition.
+ * and number of namespaces in partition, and reports the RAM used by the item index of the partition.
  *
  * \code{c}
  * // Example of nvs_get_stats() to get overview of actual statistics of data entries :
@@ -635,6 +778,37 @@ typedef struct {
  */
 esp_err_t nvs_get_stats(const char *part_name, nvs_stats_t *nvs_stats);
 
+/**
+ * @note Statistics of the read cache of a NVS partition, see CONFIG_NVS_READ_CACHE_SIZE.
+ */
+typedef struct {
+    uint32_t hits;            /**< Number of lookups of small values answered from the cache. */
+    uint32_t misses;          /**< Number of lookups of small values which had to read the flash. */
+    uint32_t evictions;       /**< Number of cached values dropped to make room for other values. */
+    size_t cached_items;      /**< Number of values currently in the cache. */
+    size_t max_items;         /**< Maximum number of values in the cache, 0 if the cache is disabled. */
+} nvs_cache_stats_t;
+
+/**
+ * @brief      Fill structure nvs_cache_stats_t with the statistics of the read cache of a partition.
+ *
+ * Integer values and short strings which are read by nvs_get_* functions are kept in a least
+ * recently used cache, so that repeated reads of the same keys don't access the flash. The counters
+ * are cumulative since the partition was initialized.
+ *
+ * @param[in]   part_name    Partition name NVS in the partition table.
+ *                           If pass a NULL than will use NVS_DEFAULT_PART_NAME ("nvs").
+ *
+ * @param[out]  cache_stats  Returns filled structure nvs_cache_stats_t.
+ *
+ * @return
+ *             - ESP_OK if the statistics have been filled.
+ *             - ESP_ERR_NVS_NOT_INITIALIZED if the storage driver is not initialized.
+ *               Return param cache_stats will be filled 0.
+ *             - ESP_ERR_INVALID_ARG if cache_stats is equal to NULL.
+ */
+esp_err_t nvs_get_cache_stats(const char *part_name, nvs_cache_stats_t *cache_stats);
+
 /**
  * @brief      Calculate all entries in a namespace.
  *
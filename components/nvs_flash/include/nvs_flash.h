@@ -130,6 +130,35 @@ esp_err_t nvs_flash_deinit(void);
  */
 esp_err_t nvs_flash_deinit_partition(const char* partition_label);
 
+/**
+ * @brief Reclaim free space of the given NVS partition ahead of time
+ *
+ * If a page of the partition becomes full while there is only one free page left, the write which
+ * needs a new page first moves the live items of the page with the most erased entries and erases its
+ * flash sector, which takes tens of milliseconds. This function does the same work in small steps,
+ * so that it can be called periodically from a low priority task and the writes don't have to.
+ * A step either moves at most max_entries entries (but at least one item) or erases one sector.
+ * Nothing is done if the partition has enough free pages.
+ *
+ * \code{c}
+ * while (nvs_flash_reclaim_step(NULL, 16) == ESP_ERR_NOT_FINISHED) {
+ *     vTaskDelay(1);
+ * }
+ * \endcode
+ *
+ * @param[in]  partition_label   Label of the partition. If NULL, NVS_DEFAULT_PART_NAME ("nvs") is used.
+ * @param[in]  max_entries       Maximum number of 32-byte entries moved in this step, must not be 0.
+ *
+ * @return
+ *      - ESP_OK if there are enough free pages or no page can be reclaimed without a new one
+ *      - ESP_ERR_NOT_FINISHED if the function should be called again
+ *      - ESP_ERR_INVALID_ARG if max_entries is 0
+ *      - ESP_ERR_NVS_NOT_INITIALIZED if the storage for given partition was not
+ *        initialized prior to this call
+ *      - one of the error codes from the underlying flash storage driver
+ */
+esp_err_t nvs_flash_reclaim_step(const char* partition_label, size_t max_entries);
+
 /**
  * @brief Erase the default NVS partition
  *
@@ -213,6 +213,44 @@ public:
      */
     virtual esp_err_t commit() = 0;
 
+    /**
+     * @brief Starts a transaction on this handle.
+     *
+     * Until the transaction is ended by \ref txn_commit or \ref txn_abort, the values set through this handle are
+     * only kept in RAM, repeated writes of the same key keep only the last value. Reading through this handle
+     * returns the staged values. Erasing items isn't possible while a transaction is open.
+     *
+     * @return
+     *             - ESP_OK if the transaction has been started
+     *             - ESP_ERR_NVS_READ_ONLY if the handle was opened as read only
+     *             - ESP_ERR_INVALID_STATE if a transaction is already open on this handle
+     *             - ESP_ERR_NO_MEM if memory could not be allocated for the transaction
+     */
+    virtual esp_err_t txn_begin() = 0;
+
+    /**
+     * @brief Writes all values staged by the transaction and ends it.
+     *
+     * The values are written so that after a power loss either all of them or none of them are present.
+     * The transaction is ended even if writing fails, none of its values are kept in that case.
+     *
+     * @return
+     *             - ESP_OK if all values have been written
+     *             - ESP_ERR_INVALID_STATE if there is no open transaction on this handle
+     *             - ESP_ERR_NVS_NOT_ENOUGH_SPACE if the values don't fit into the storage
+     *             - other error codes from the underlying storage driver
+     */
+    virtual esp_err_t txn_commit() = 0;
+
+    /**
+     * @brief Discards all values staged by the transaction and ends it.
+     *
+     * @return
+     *             - ESP_OK if the transaction has been discarded
+     *             - ESP_ERR_INVALID_STATE if there is no open transaction on this handle
+     */
+    virtual esp_err_t txn_abort() = 0;
+
     /**
      * @brief      Calculate all entries in the scope of the handle.
      *
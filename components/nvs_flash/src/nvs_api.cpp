@@ -253,6 +253,22 @@ extern "C" esp_err_t nvs_flash_deinit(void)
     return nvs_flash_deinit_partition(NVS_DEFAULT_PART_NAME);
 }
 
+extern "C" esp_err_t nvs_flash_reclaim_step(const char* partition_label, size_t max_entries)
+{
+    if (max_entries == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Lock lock;
+
+    nvs::Storage* pStorage = lookup_storage_from_name((partition_label == nullptr) ? NVS_DEFAULT_PART_NAME : partition_label);
+    if (pStorage == nullptr) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    return pStorage->reclaimStep(max_entries);
+}
+
 static esp_err_t nvs_find_ns_handle(nvs_handle_t c_handle, NVSHandleSimple** handle)
 {
     auto it = find_if(begin(s_nvs_handles), end(s_nvs_handles), [=](NVSHandleEntry& e) -> bool {
@@ -420,6 +436,42 @@ extern "C" esp_err_t nvs_commit(nvs_handle_t c_handle)
     return handle->commit();
 }
 
+extern "C" esp_err_t nvs_txn_begin(nvs_handle_t c_handle)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s", __func__);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->txn_begin();
+}
+
+extern "C" esp_err_t nvs_txn_commit(nvs_handle_t c_handle)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s", __func__);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->txn_commit();
+}
+
+extern "C" esp_err_t nvs_txn_abort(nvs_handle_t c_handle)
+{
+    Lock lock;
+    ESP_LOGD(TAG, "%s", __func__);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return handle->txn_abort();
+}
+
 extern "C" esp_err_t nvs_set_str(nvs_handle_t c_handle, const char* key, const char* value)
 {
     Lock lock;
@@ -538,6 +590,60 @@ extern "C" esp_err_t nvs_get_blob(nvs_handle_t c_handle, const char* key, void*
     return nvs_get_str_or_blob(c_handle, nvs::ItemType::BLOB, key, out_value, length);
 }
 
+extern "C" esp_err_t nvs_blob_reader_open(nvs_handle_t c_handle, const char* key, nvs_blob_reader_t* out_reader, size_t* out_length)
+{
+    if (key == nullptr || out_reader == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_reader = nullptr;
+
+    Lock lock;
+    ESP_LOGD(TAG, "%s %s", __func__, key);
+    NVSHandleSimple *handle;
+    auto err = nvs_find_ns_handle(c_handle, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    nvs_blob_reader_t reader = (nvs_blob_reader_t)calloc(1, sizeof(nvs_opaque_blob_reader_t));
+    if (reader == nullptr) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    err = handle->openBlobReader(reader, key);
+    if (err != ESP_OK) {
+        free(reader);
+        return err;
+    }
+
+    if (out_length) {
+        *out_length = reader->dataSize;
+    }
+    *out_reader = reader;
+    return ESP_OK;
+}
+
+extern "C" esp_err_t nvs_blob_reader_next(nvs_blob_reader_t reader, nvs_blob_chunk_t* out_chunk)
+{
+    if (reader == nullptr || out_chunk == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Lock lock;
+    return reader->storage->nextBlobChunk(reader, *out_chunk);
+}
+
+extern "C" void nvs_blob_reader_close(nvs_blob_reader_t reader)
+{
+    if (reader == nullptr) {
+        return;
+    }
+
+    Lock lock;
+    reader->storage->closeBlobReader(reader);
+    free(reader);
+}
+
 extern "C" esp_err_t nvs_get_stats(const char* part_name, nvs_stats_t* nvs_stats)
 {
     Lock lock;
@@ -551,6 +657,7 @@ extern "C" esp_err_t nvs_get_stats(const char* part_name, nvs_stats_t* nvs_stats
     nvs_stats->total_entries     = 0;
     nvs_stats->available_entries = 0;
     nvs_stats->namespace_count   = 0;
+    nvs_stats->item_index_memory = 0;
 
     pStorage = lookup_storage_from_name((part_name == nullptr) ? NVS_DEFAULT_PART_NAME : part_name);
     if (pStorage == nullptr) {
@@ -564,6 +671,29 @@ extern "C" esp_err_t nvs_get_stats(const char* part_name, nvs_stats_t* nvs_stats
     return pStorage->fillStats(*nvs_stats);
 }
 
+extern "C" esp_err_t nvs_get_cache_stats(const char* part_name, nvs_cache_stats_t* cache_stats)
+{
+    Lock lock;
+    nvs::Storage* pStorage;
+
+    if (cache_stats == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    cache_stats->hits         = 0;
+    cache_stats->misses       = 0;
+    cache_stats->evictions    = 0;
+    cache_stats->cached_items = 0;
+    cache_stats->max_items    = 0;
+
+    pStorage = lookup_storage_from_name((part_name == nullptr) ? NVS_DEFAULT_PART_NAME : part_name);
+    if (pStorage == nullptr) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    pStorage->fillCacheStats(*cache_stats);
+    return ESP_OK;
+}
+
 extern "C" esp_err_t nvs_get_used_entry_count(nvs_handle_t c_handle, size_t* used_entries)
 {
     Lock lock;
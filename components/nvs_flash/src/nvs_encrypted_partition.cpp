@@ -110,4 +110,9 @@ esp_err_t NVSEncryptedPartition::write(size_t addr, const void* src, size_t size
     return result;
 }
 
+esp_err_t NVSEncryptedPartition::mmap(size_t src_offset, size_t size, const void** out_ptr, esp_partition_mmap_handle_t* out_handle)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
 } // nvs
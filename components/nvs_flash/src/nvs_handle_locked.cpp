@@ -60,6 +60,21 @@ esp_err_t NVSHandleLocked::commit() {
     return handle->commit();
 }
 
+esp_err_t NVSHandleLocked::txn_begin() {
+    Lock lock;
+    return handle->txn_begin();
+}
+
+esp_err_t NVSHandleLocked::txn_commit() {
+    Lock lock;
+    return handle->txn_commit();
+}
+
+esp_err_t NVSHandleLocked::txn_abort() {
+    Lock lock;
+    return handle->txn_abort();
+}
+
 esp_err_t NVSHandleLocked::get_used_entry_count(size_t& usedEntries) {
     Lock lock;
     return handle->get_used_entry_count(usedEntries);
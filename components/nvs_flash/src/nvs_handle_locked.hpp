@@ -49,6 +49,12 @@ public:
 
     esp_err_t commit() override;
 
+    esp_err_t txn_begin() override;
+
+    esp_err_t txn_commit() override;
+
+    esp_err_t txn_abort() override;
+
     esp_err_t get_used_entry_count(size_t& usedEntries) override;
 
 protected:
@@ -4,12 +4,14 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <cstdlib>
+#include <cstring>
 #include "nvs_handle.hpp"
 #include "nvs_partition_manager.hpp"
 
 namespace nvs {
 
 NVSHandleSimple::~NVSHandleSimple() {
+    delete mTransaction;
     NVSPartitionManager::get_instance()->close_handle(this);
 }
 
@@ -18,6 +20,10 @@ esp_err_t NVSHandleSimple::set_typed_item(ItemType datatype, const char *key, co
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
 
+    if (mTransaction) {
+        return mTransaction->set(datatype, key, data, dataSize);
+    }
+
     return mStoragePtr->writeItem(mNsIndex, datatype, key, data, dataSize);
 }
 
@@ -25,6 +31,13 @@ esp_err_t NVSHandleSimple::get_typed_item(ItemType datatype, const char *key, vo
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
 
+    if (mTransaction) {
+        Transaction::TransactionItem *staged = mTransaction->find(key);
+        if (staged) {
+            return get_staged_item(staged, datatype, data, dataSize);
+        }
+    }
+
     return mStoragePtr->readItem(mNsIndex, datatype, key, data, dataSize);
 }
 
@@ -33,6 +46,10 @@ esp_err_t NVSHandleSimple::set_string(const char *key, const char* str)
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
 
+    if (mTransaction) {
+        return mTransaction->set(nvs::ItemType::SZ, key, str, strlen(str) + 1);
+    }
+
     return mStoragePtr->writeItem(mNsIndex, nvs::ItemType::SZ, key, str, strlen(str) + 1);
 }
 
@@ -41,6 +58,10 @@ esp_err_t NVSHandleSimple::set_blob(const char *key, const void* blob, size_t le
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
 
+    if (mTransaction) {
+        return mTransaction->set(nvs::ItemType::BLOB, key, blob, len);
+    }
+
     return mStoragePtr->writeItem(mNsIndex, nvs::ItemType::BLOB, key, blob, len);
 }
 
@@ -48,6 +69,13 @@ esp_err_t NVSHandleSimple::get_string(const char *key, char* out_str, size_t len
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
 
+    if (mTransaction) {
+        Transaction::TransactionItem *staged = mTransaction->find(key);
+        if (staged) {
+            return get_staged_item(staged, nvs::ItemType::SZ, out_str, len);
+        }
+    }
+
     return mStoragePtr->readItem(mNsIndex, nvs::ItemType::SZ, key, out_str, len);
 }
 
@@ -55,6 +83,13 @@ esp_err_t NVSHandleSimple::get_blob(const char *key, void* out_blob, size_t len)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
 
+    if (mTransaction) {
+        Transaction::TransactionItem *staged = mTransaction->find(key);
+        if (staged) {
+            return get_staged_item(staged, nvs::ItemType::BLOB, out_blob, len);
+        }
+    }
+
     return mStoragePtr->readItem(mNsIndex, nvs::ItemType::BLOB, key, out_blob, len);
 }
 
@@ -62,6 +97,15 @@ esp_err_t NVSHandleSimple::get_item_size(ItemType datatype, const char *key, siz
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
 
+    if (mTransaction) {
+        Transaction::TransactionItem *staged = mTransaction->find(key);
+        if (staged) {
+            if (staged->mDatatype != datatype) return ESP_ERR_NVS_NOT_FOUND;
+            size = staged->mDataSize;
+            return ESP_OK;
+        }
+    }
+
     return mStoragePtr->getItemDataSize(mNsIndex, datatype, key, size);
 }
 
@@ -70,7 +114,13 @@ esp_err_t NVSHandleSimple::find_key(const char* key, nvs_type_t &nvstype)
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
 
     nvs::ItemType datatype;
-    esp_err_t err = mStoragePtr->findKey(mNsIndex, key, &datatype);
+    esp_err_t err = ESP_OK;
+    Transaction::TransactionItem *staged = mTransaction ? mTransaction->find(key) : nullptr;
+    if (staged) {
+        datatype = staged->mDatatype;
+    } else {
+        err = mStoragePtr->findKey(mNsIndex, key, &datatype);
+    }
     if(err != ESP_OK)
         return err;
 
@@ -86,6 +136,7 @@ esp_err_t NVSHandleSimple::erase_item(const char* key)
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransaction) return ESP_ERR_INVALID_STATE;
 
     return mStoragePtr->eraseItem(mNsIndex, key);
 }
@@ -94,6 +145,7 @@ esp_err_t NVSHandleSimple::erase_all()
 {
     if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
     if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransaction) return ESP_ERR_INVALID_STATE;
 
     return mStoragePtr->eraseNamespace(mNsIndex);
 }
@@ -105,6 +157,39 @@ esp_err_t NVSHandleSimple::commit()
     return ESP_OK;
 }
 
+esp_err_t NVSHandleSimple::txn_begin()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (mReadOnly) return ESP_ERR_NVS_READ_ONLY;
+    if (mTransaction) return ESP_ERR_INVALID_STATE;
+
+    mTransaction = new (std::nothrow) Transaction();
+    if (!mTransaction) return ESP_ERR_NO_MEM;
+
+    return ESP_OK;
+}
+
+esp_err_t NVSHandleSimple::txn_commit()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (!mTransaction) return ESP_ERR_INVALID_STATE;
+
+    esp_err_t err = mStoragePtr->commitTransaction(mNsIndex, *mTransaction);
+    delete mTransaction;
+    mTransaction = nullptr;
+    return err;
+}
+
+esp_err_t NVSHandleSimple::txn_abort()
+{
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+    if (!mTransaction) return ESP_ERR_INVALID_STATE;
+
+    delete mTransaction;
+    mTransaction = nullptr;
+    return ESP_OK;
+}
+
 esp_err_t NVSHandleSimple::get_used_entry_count(size_t& used_entries)
 {
     used_entries = 0;
@@ -119,6 +204,22 @@ esp_err_t NVSHandleSimple::get_used_entry_count(size_t& used_entries)
     return err;
 }
 
+esp_err_t NVSHandleSimple::get_staged_item(Transaction::TransactionItem *staged, ItemType datatype, void* data, size_t dataSize)
+{
+    if (staged->mDatatype != datatype) return ESP_ERR_NVS_NOT_FOUND;
+
+    if (isVariableLengthType(datatype)) {
+        if (dataSize < staged->mDataSize) return ESP_ERR_NVS_INVALID_LENGTH;
+    } else if (dataSize != staged->mDataSize) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    if (staged->mDataSize > 0) {
+        memcpy(data, staged->mData, staged->mDataSize);
+    }
+    return ESP_OK;
+}
+
 void NVSHandleSimple::debugDump() {
     return mStoragePtr->debugDump();
 }
@@ -143,6 +244,17 @@ bool NVSHandleSimple::nextEntry(nvs_opaque_iterator_t* it) {
     return mStoragePtr->nextEntry(it);
 }
 
+esp_err_t NVSHandleSimple::openBlobReader(nvs_opaque_blob_reader_t* reader, const char* key) {
+    if (!valid) return ESP_ERR_NVS_INVALID_HANDLE;
+
+    // the value staged by the transaction is only held in RAM
+    if (mTransaction && mTransaction->find(key)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return mStoragePtr->openBlobReader(reader, mNsIndex, key);
+}
+
 const char *NVSHandleSimple::get_partition_name() const {
     return mStoragePtr->getPartName();
 }
@@ -32,7 +32,8 @@ public:
         mStoragePtr(StoragePtr),
         mNsIndex(nsIndex),
         mReadOnly(readOnly),
-        valid(1)
+        valid(1),
+        mTransaction(nullptr)
     { }
 
     ~NVSHandleSimple();
@@ -59,6 +60,12 @@ public:
 
     esp_err_t commit() override;
 
+    esp_err_t txn_begin() override;
+
+    esp_err_t txn_commit() override;
+
+    esp_err_t txn_abort() override;
+
     esp_err_t get_used_entry_count(size_t &usedEntries) override;
 
     esp_err_t getItemDataSize(ItemType datatype, const char *key, size_t &dataSize);
@@ -75,11 +82,15 @@ public:
 
     bool nextEntry(nvs_opaque_iterator_t *it);
 
+    esp_err_t openBlobReader(nvs_opaque_blob_reader_t *reader, const char *key);
+
     const char *get_partition_name() const;
 
     Storage *get_storage() const;
 
 private:
+    esp_err_t get_staged_item(Transaction::TransactionItem *staged, ItemType datatype, void *data, size_t dataSize);
+
     /**
      * The underlying storage's object.
      */
@@ -101,6 +112,11 @@ private:
      * Upon opening, a handle is valid. It becomes invalid if the underlying storage is de-initialized.
      */
     uint8_t valid;
+
+    /**
+     * Values staged by the transaction started with txn_begin(), nullptr if no transaction is open.
+     */
+    Transaction *mTransaction;
 };
 
 } // nvs
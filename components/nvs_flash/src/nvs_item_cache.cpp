@@ -0,0 +1,109 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#if __has_include(<bsd/string.h>)
+// for strlcpy
+#include <bsd/string.h>
+#endif
+#include "nvs_item_cache.hpp"
+
+namespace nvs
+{
+
+ItemCache::ItemCache()
+{
+}
+
+ItemCache::~ItemCache()
+{
+    clear();
+}
+
+void ItemCache::clear()
+{
+    mEntries.clearAndFreeNodes();
+}
+
+void ItemCache::setCapacity(size_t capacity)
+{
+    mCapacity = capacity;
+    while (mEntries.size() > mCapacity) {
+        CacheEntry* entry = &mEntries.back();
+        mEntries.erase(entry);
+        delete entry;
+    }
+}
+
+const ItemCache::CacheEntry* ItemCache::find(uint8_t nsIndex, ItemType datatype, const char* key)
+{
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+        if (it->mNsIndex == nsIndex && it->mDatatype == datatype && strncmp(it->mKey, key, Item::MAX_KEY_LENGTH) == 0) {
+            CacheEntry* entry = it;
+            if (entry != &mEntries.front()) {
+                mEntries.erase(entry);
+                mEntries.push_front(entry);
+            }
+            ++mHits;
+            return entry;
+        }
+    }
+    ++mMisses;
+    return nullptr;
+}
+
+void ItemCache::insert(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize)
+{
+    if (mCapacity == 0 || dataSize > MAX_DATA_SIZE) {
+        return;
+    }
+
+    CacheEntry* entry;
+    if (mEntries.size() < mCapacity) {
+        entry = new (std::nothrow) CacheEntry;
+        if (!entry) {
+            return;
+        }
+    } else {
+        // reuse the least recently used entry
+        entry = &mEntries.back();
+        mEntries.erase(entry);
+        ++mEvictions;
+    }
+
+    strlcpy(entry->mKey, key, sizeof(entry->mKey));
+    entry->mNsIndex = nsIndex;
+    entry->mDatatype = datatype;
+    entry->mDataSize = static_cast<uint8_t>(dataSize);
+    memcpy(entry->mData, data, dataSize);
+    mEntries.push_front(entry);
+}
+
+void ItemCache::invalidate(uint8_t nsIndex, const char* key)
+{
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        CacheEntry* entry = it;
+        ++it;
+        if (entry->mNsIndex == nsIndex && strncmp(entry->mKey, key, Item::MAX_KEY_LENGTH) == 0) {
+            mEntries.erase(entry);
+            delete entry;
+        }
+    }
+}
+
+void ItemCache::invalidateNamespace(uint8_t nsIndex)
+{
+    for (auto it = mEntries.begin(); it != mEntries.end();) {
+        CacheEntry* entry = it;
+        ++it;
+        if (entry->mNsIndex == nsIndex) {
+            mEntries.erase(entry);
+            delete entry;
+        }
+    }
+}
+
+} // namespace nvs
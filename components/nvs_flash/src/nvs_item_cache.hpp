@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef nvs_item_cache_hpp
+#define nvs_item_cache_hpp
+
+#include "nvs.h"
+#include "nvs_types.hpp"
+#include "nvs_memory_management.hpp"
+#include "intrusive_list.h"
+
+namespace nvs
+{
+
+/**
+ * Least recently used cache of the values of small items read from a partition.
+ *
+ * Only integer items and strings which fit into MAX_DATA_SIZE bytes are cached. The entries are keyed by
+ * namespace index, datatype and key, so that a read with a different datatype doesn't return a cached value
+ * which the lookup in the pages wouldn't return either. Storage has to invalidate the entries of a key
+ * before the key is written or erased.
+ */
+class ItemCache
+{
+public:
+    static const size_t MAX_DATA_SIZE = 32;
+
+    struct CacheEntry : public intrusive_list_node<CacheEntry>, public ExceptionlessAllocatable {
+    public:
+        char mKey[Item::MAX_KEY_LENGTH + 1];
+        uint8_t mNsIndex;
+        ItemType mDatatype;
+        uint8_t mDataSize;
+        uint8_t mData[MAX_DATA_SIZE];
+    };
+
+    ItemCache();
+    ~ItemCache();
+
+    /**
+     * Find the entry and make it the most recently used one. Counts a hit or a miss.
+     */
+    const CacheEntry* find(uint8_t nsIndex, ItemType datatype, const char* key);
+
+    /**
+     * Add a value, replacing the least recently used entry if the cache is full. Values which are too big
+     * and values which can't be allocated are not cached.
+     */
+    void insert(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize);
+
+    void invalidate(uint8_t nsIndex, const char* key);
+
+    void invalidateNamespace(uint8_t nsIndex);
+
+    void clear();
+
+    void setCapacity(size_t capacity);
+
+    size_t capacity() const
+    {
+        return mCapacity;
+    }
+
+    size_t size() const
+    {
+        return mEntries.size();
+    }
+
+    uint32_t hits() const
+    {
+        return mHits;
+    }
+
+    uint32_t misses() const
+    {
+        return mMisses;
+    }
+
+    uint32_t evictions() const
+    {
+        return mEvictions;
+    }
+
+private:
+    ItemCache(const ItemCache& other);
+    const ItemCache& operator= (const ItemCache& rhs);
+
+protected:
+    // most recently used entry first
+    intrusive_list<CacheEntry> mEntries;
+    size_t mCapacity = 0;
+    uint32_t mHits = 0;
+    uint32_t mMisses = 0;
+    uint32_t mEvictions = 0;
+}; // class ItemCache
+
+} // namespace nvs
+
+#endif /* nvs_item_cache_hpp */
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "nvs_item_index.hpp"
+
+namespace nvs
+{
+
+ItemIndex::ItemIndex()
+{
+}
+
+ItemIndex::~ItemIndex()
+{
+    clear();
+}
+
+void ItemIndex::clear()
+{
+    delete [] mNodes;
+    mNodes = nullptr;
+    mCapacity = 0;
+    mCount = 0;
+    mDeletedCount = 0;
+}
+
+esp_err_t ItemIndex::resize(size_t capacity)
+{
+    ItemIndexNode* oldNodes = mNodes;
+    size_t oldCapacity = mCapacity;
+
+    ItemIndexNode* newNodes = new (std::nothrow) ItemIndexNode[capacity];
+    if (!newNodes) return ESP_ERR_NO_MEM;
+
+    mNodes = newNodes;
+    mCapacity = capacity;
+    mDeletedCount = 0;
+
+    for (size_t i = 0; i < oldCapacity; ++i) {
+        if (oldNodes[i].mPage != nullptr) {
+            place(oldNodes[i]);
+        }
+    }
+    delete [] oldNodes;
+    return ESP_OK;
+}
+
+void ItemIndex::place(const ItemIndexNode& node)
+{
+    // capacity is always a power of two and there is always at least one free slot
+    size_t slot = node.mHash & (mCapacity - 1);
+    while (mNodes[slot].mPage != nullptr) {
+        slot = (slot + 1) & (mCapacity - 1);
+    }
+    if (mNodes[slot].mIndex == DELETED) {
+        --mDeletedCount;
+    }
+    mNodes[slot] = node;
+}
+
+void ItemIndex::remove(size_t slot)
+{
+    mNodes[slot].mPage = nullptr;
+    mNodes[slot].mIndex = DELETED;
+    --mCount;
+    ++mDeletedCount;
+}
+
+esp_err_t ItemIndex::insert(const Item& item, Page* page, size_t index)
+{
+    // keep the load factor including deleted nodes below 3/4, so that the probe sequences stay short
+    if ((mCount + mDeletedCount + 1) * 4 > mCapacity * 3) {
+        size_t capacity = MIN_CAPACITY;
+        while ((mCount + 1) * 2 > capacity) {
+            capacity *= 2;
+        }
+        esp_err_t err = resize(capacity);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    ItemIndexNode node;
+    node.mPage = page;
+    node.mIndex = static_cast<uint32_t>(index);
+    node.mHash = hashOf(item);
+    place(node);
+    ++mCount;
+    return ESP_OK;
+}
+
+void ItemIndex::erase(const Item& item, const Page* page, size_t index)
+{
+    if (mCount == 0) {
+        return;
+    }
+    const uint32_t hash_24 = hashOf(item);
+    for (size_t slot = hash_24 & (mCapacity - 1); mNodes[slot].mIndex != EMPTY; slot = (slot + 1) & (mCapacity - 1)) {
+        ItemIndexNode& node = mNodes[slot];
+        if (node.mPage == page && node.mIndex == index && node.mHash == hash_24) {
+            remove(slot);
+            return;
+        }
+    }
+}
+
+void ItemIndex::erasePage(const Page* page)
+{
+    for (size_t slot = 0; slot < mCapacity; ++slot) {
+        if (mNodes[slot].mPage == page) {
+            remove(slot);
+        }
+    }
+}
+
+size_t ItemIndex::find(const Item& item, Candidate* candidates, size_t maxCount) const
+{
+    if (mCount == 0) {
+        return 0;
+    }
+    const uint32_t hash_24 = hashOf(item);
+    size_t count = 0;
+    for (size_t slot = hash_24 & (mCapacity - 1); mNodes[slot].mIndex != EMPTY; slot = (slot + 1) & (mCapacity - 1)) {
+        const ItemIndexNode& node = mNodes[slot];
+        if (node.mPage != nullptr && node.mHash == hash_24) {
+            if (count < maxCount) {
+                candidates[count].mPage = node.mPage;
+                candidates[count].mIndex = node.mIndex;
+            }
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace nvs
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef nvs_item_index_hpp
+#define nvs_item_index_hpp
+
+#include "nvs.h"
+#include "nvs_types.hpp"
+#include "nvs_memory_management.hpp"
+
+namespace nvs
+{
+
+class Page;
+
+/**
+ * Storage-wide index of the items written in all pages of a partition.
+ *
+ * The index is an open addressing hash table keyed by the same 24-bit hash of namespace index, key and chunk
+ * index which is used by the per-page HashList. Each node maps the hash to the page holding the item and to the
+ * index of the item's first entry within that page. Several nodes may share the same hash, e.g. two versions of
+ * the same blob index while a blob is being rewritten, or a hash collision of two different keys.
+ *
+ * The index is a superset of the items stored in the pages: a node which doesn't match an item anymore only
+ * causes an unnecessary page lookup, but an item which isn't present in the index would not be found. Callers
+ * therefore have to insert every written item and every item copied during page reclaim.
+ */
+class ItemIndex
+{
+public:
+    struct Candidate {
+        Page* mPage;
+        size_t mIndex;
+    };
+
+    ItemIndex();
+    ~ItemIndex();
+
+    esp_err_t insert(const Item& item, Page* page, size_t index);
+
+    void erase(const Item& item, const Page* page, size_t index);
+
+    void erasePage(const Page* page);
+
+    /**
+     * Collect all nodes matching the hash of the item.
+     *
+     * Returns the total number of matching nodes. If it is bigger than maxCount, only the first maxCount
+     * candidates are stored.
+     */
+    size_t find(const Item& item, Candidate* candidates, size_t maxCount) const;
+
+    void clear();
+
+    size_t size() const
+    {
+        return mCount;
+    }
+
+    size_t getMemoryUsage() const
+    {
+        return sizeof(*this) + mCapacity * sizeof(ItemIndexNode);
+    }
+
+private:
+    ItemIndex(const ItemIndex& other);
+    const ItemIndex& operator= (const ItemIndex& rhs);
+
+protected:
+
+    struct ItemIndexNode : public ExceptionlessAllocatable {
+        ItemIndexNode() :
+            mPage(nullptr), mIndex(EMPTY), mHash(0)
+        {
+        }
+
+        Page* mPage;
+        uint32_t mIndex : 8;
+        uint32_t mHash  : 24;
+    };
+
+    // Values of mIndex of the nodes not pointing to any page, entry indices are always below them
+    static const uint8_t EMPTY = 0xff;
+    static const uint8_t DELETED = 0xfe;
+
+    static const size_t MIN_CAPACITY = 64;
+
+    static uint32_t hashOf(const Item& item)
+    {
+        return item.calculateCrc32WithoutValue() & 0xffffff;
+    }
+
+    esp_err_t resize(size_t capacity);
+
+    void place(const ItemIndexNode& node);
+
+    void remove(size_t slot);
+
+    ItemIndexNode* mNodes = nullptr;
+    size_t mCapacity = 0;
+    size_t mCount = 0;
+    size_t mDeletedCount = 0;
+}; // class ItemIndex
+
+} // namespace nvs
+
+#endif /* nvs_item_index_hpp */
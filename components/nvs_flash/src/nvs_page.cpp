@@ -150,7 +150,7 @@ esp_err_t Page::writeEntryData(const uint8_t* data, size_t size)
     return ESP_OK;
 }
 
-esp_err_t Page::writeItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx)
+esp_err_t Page::writeItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx, size_t* itemIndex)
 {
     Item item;
     esp_err_t err;
@@ -209,6 +209,10 @@ esp_err_t Page::writeItem(uint8_t nsIndex, ItemType datatype, const char* key, c
         return err;
     }
 
+    if (itemIndex) {
+        *itemIndex = mNextFreeEntry;
+    }
+
     if (!isVariableLengthType(datatype)) {
         memcpy(item.data, data, dataSize);
         item.crc32 = item.calculateCrc32();
@@ -287,6 +291,33 @@ esp_err_t Page::readVariableLengthItemData(const Item& item, const size_t index,
     return ESP_OK;
 }
 
+esp_err_t Page::mmapVariableLengthItemData(const Item& item, const size_t index, const void** data, esp_partition_mmap_handle_t* handle)
+{
+    if (mState == PageState::INVALID) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+
+    // the data entries directly follow the item header within the same page
+    uint32_t phyAddr;
+    esp_err_t rc = getEntryAddress(index + 1, &phyAddr);
+    if (rc != ESP_OK) {
+        return rc;
+    }
+    rc = mPartition->mmap(phyAddr, item.varLength.dataSize, data, handle);
+    if (rc != ESP_OK) {
+        return rc;
+    }
+    if (Item::calculateCrc32(reinterpret_cast<const uint8_t * >(*data), item.varLength.dataSize) != item.varLength.dataCrc32) {
+        mPartition->munmap(*handle);
+        rc = eraseEntryAndSpan(index);
+        if (rc != ESP_OK) {
+            return rc;
+        }
+        return ESP_ERR_NVS_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
 esp_err_t Page::readItem(uint8_t nsIndex, ItemType datatype, const char* key, void* data, size_t dataSize, uint8_t chunkIdx, VerOffset chunkStart)
 {
     size_t index = 0;
@@ -563,6 +594,56 @@ esp_err_t Page::copyItems(Page &other)
     return ESP_OK;
 }
 
+esp_err_t Page::copyItem(size_t index, Page& other, size_t* otherIndex)
+{
+    Item entry;
+    esp_err_t err = readEntry(index, entry);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    const size_t end = index + entry.span;
+    NVS_ASSERT_OR_RETURN(entry.span > 0 && end <= ENTRY_COUNT, ESP_FAIL);
+
+    if (other.mState == PageState::UNINITIALIZED) {
+        err = other.initialize();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    if (other.mState != PageState::ACTIVE || other.getFreeEntryCount() < entry.span) {
+        return ESP_ERR_NVS_PAGE_FULL;
+    }
+
+    const size_t newIndex = other.mNextFreeEntry;
+    err = other.mHashList.insert(entry, newIndex);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    err = other.writeEntry(entry);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    for (size_t i = index + 1; i < end; ++i) {
+        err = readEntry(i, entry);
+        if (err != ESP_OK) {
+            return err;
+        }
+        err = other.writeEntry(entry);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    if (otherIndex) {
+        *otherIndex = newIndex;
+    }
+    return ESP_OK;
+}
+
 esp_err_t Page::mLoadEntryTable()
 {
     // for states where we actually care about data in the page, read entry state table
@@ -650,6 +731,8 @@ esp_err_t Page::mLoadEntryTable()
         // check that all variable-length items are written or erased fully
         Item item;
         size_t lastItemIndex = INVALID_ENTRY;
+        // items from this index on belong to a transaction, see PageManager::beginTransaction()
+        size_t transactionStart = ENTRY_COUNT;
         size_t end = mNextFreeEntry;
         if (end > ENTRY_COUNT) {
             end = ENTRY_COUNT;
@@ -693,6 +776,16 @@ esp_err_t Page::mLoadEntryTable()
                 continue;
             }
 
+            if (item.nsIndex == NS_INDEX && item.datatype == ItemType::U8) {
+                uint8_t movedEntries;
+                if (strncmp(item.key, TXN_BEGIN_KEY, Item::MAX_KEY_LENGTH) == 0) {
+                    transactionStart = i + 1;
+                } else if (i == 0 && strncmp(item.key, TXN_RECLAIM_KEY, Item::MAX_KEY_LENGTH) == 0
+                        && item.getValue(movedEntries) == ESP_OK) {
+                    transactionStart = 1 + movedEntries;
+                }
+            }
+
             err = mHashList.insert(item, i);
             if (err != ESP_OK) {
                 mState = PageState::INVALID;
@@ -726,7 +819,9 @@ esp_err_t Page::mLoadEntryTable()
              * when old-format blob is present along with new-format blob-index
              * for same key on active page. Since datatype is not used in hash calculation,
              * old-format blob will be removed.*/
-            if (duplicateIndex < i) {
+            /* The older version of an item written by an unfinished transaction is erased or kept by
+             * PageManager::load(), depending on whether the transaction was committed.*/
+            if (duplicateIndex < i && !(duplicateIndex < transactionStart && i >= transactionStart)) {
                 eraseEntryAndSpan(duplicateIndex);
             }
         }
@@ -736,7 +831,8 @@ esp_err_t Page::mLoadEntryTable()
             size_t findItemIndex = 0;
             Item dupItem;
             if (findItem(item.nsIndex, item.datatype, item.key, findItemIndex, dupItem) == ESP_OK) {
-                if (findItemIndex < lastItemIndex) {
+                if (findItemIndex < lastItemIndex
+                        && !(findItemIndex < transactionStart && lastItemIndex >= transactionStart)) {
                     auto err = eraseEntryAndSpan(findItemIndex);
                     if (err != ESP_OK) {
                         mState = PageState::INVALID;
@@ -1101,6 +1197,16 @@ size_t Page::getVarDataTailroom() const
     return ((mNextFreeEntry < (ENTRY_COUNT - 1)) ? ((ENTRY_COUNT - mNextFreeEntry - 1) * ENTRY_SIZE) : 0);
 }
 
+size_t Page::getFreeEntryCount() const
+{
+    if (mState == PageState::UNINITIALIZED) {
+        return ENTRY_COUNT;
+    } else if (mState != PageState::ACTIVE || mNextFreeEntry == INVALID_ENTRY) {
+        return 0;
+    }
+    return ENTRY_COUNT - mNextFreeEntry;
+}
+
 const char* Page::pageStateToName(PageState ps)
 {
     switch (ps) {
@@ -47,6 +47,12 @@ public:
 
     static const uint8_t CHUNK_ANY = Item::CHUNK_ANY;
 
+    // Keys of the U8 marker items in namespace NS_INDEX delimiting a transaction, see PageManager::beginTransaction().
+    // They start with a control character to stay apart from the namespace names stored in the same namespace.
+    static constexpr const char TXN_BEGIN_KEY[] = "\x1ftxn.begin";
+    static constexpr const char TXN_RECLAIM_KEY[] = "\x1ftxn.reclaim";
+    static constexpr const char TXN_COMMIT_KEY[] = "\x1ftxn.commit";
+
     static const uint8_t NVS_VERSION = NVS_CONST_NVS_VERSION; // Decrement to upgrade
 
     enum class PageState : uint32_t {
@@ -86,10 +92,19 @@ public:
 
     esp_err_t setVersion(uint8_t version);
 
-    esp_err_t writeItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY);
+    esp_err_t writeItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY, size_t* itemIndex = nullptr);
 
     esp_err_t readVariableLengthItemData(const Item& item, const size_t index, void* data);
 
+    /**
+     * Map the data of a variable length item into the address space instead of copying it like
+     * readVariableLengthItemData(). The data are checked against the CRC of the item before they are returned,
+     * the mapping has to be released by Partition::munmap().
+     *
+     * Returns ESP_ERR_NOT_SUPPORTED if the partition can't be mapped, the caller has to read the data then.
+     */
+    esp_err_t mmapVariableLengthItemData(const Item& item, const size_t index, const void** data, esp_partition_mmap_handle_t* handle);
+
     esp_err_t readItem(uint8_t nsIndex, ItemType datatype, const char* key, void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
 
     esp_err_t cmpItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, uint8_t chunkIdx = CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY);
@@ -137,12 +152,20 @@ public:
     }
     size_t getVarDataTailroom() const ;
 
+    size_t getFreeEntryCount() const;
+
     esp_err_t markFull();
 
     esp_err_t markFreeing();
 
     esp_err_t copyItems(Page& other);
 
+    /**
+     * Append the item starting at index, including its data entries, to the other page.
+     * The item itself stays in this page. Returns ESP_ERR_NVS_PAGE_FULL if the other page has no room for it.
+     */
+    esp_err_t copyItem(size_t index, Page& other, size_t* otherIndex = nullptr);
+
     esp_err_t erase();
 
     void debugDump() const;
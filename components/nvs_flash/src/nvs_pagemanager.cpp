@@ -56,9 +56,16 @@ esp_err_t PageManager::load(Partition *partition, uint32_t baseSector, uint32_t
         mSeqNumber = lastSeqNo + 1;
     }
 
-    // if power went out after a new item for the given key was written,
-    // but before the old one was erased, we end up with a duplicate item
     if (!partition->get_readonly()) {
+        // if power went out while a transaction was written, complete or revert it before
+        // the duplicate items it left behind are handled below
+        auto err = recoverTransaction();
+        if (err != ESP_OK) {
+            return err;
+        }
+
+        // if power went out after a new item for the given key was written,
+        // but before the old one was erased, we end up with a duplicate item
         Page& lastPage = back();
         size_t lastItemIndex = SIZE_MAX;
         Item item;
@@ -136,8 +143,12 @@ esp_err_t PageManager::load(Partition *partition, uint32_t baseSector, uint32_t
     return ESP_OK;
 }
 
-esp_err_t PageManager::requestNewPage()
+esp_err_t PageManager::requestNewPage(Page** reclaimedPage)
 {
+    if (reclaimedPage) {
+        *reclaimedPage = nullptr;
+    }
+
     if (mFreePageList.empty()) {
         return ESP_ERR_NVS_INVALID_STATE;
     }
@@ -152,6 +163,12 @@ esp_err_t PageManager::requestNewPage()
     size_t maxUnusedItems = 0;
     for (auto it = begin(); it != end(); ++it) {
 
+        // the pages written by a transaction stay in place, see beginTransaction()
+        uint32_t seqNumber;
+        if (mTransactionActive && (it->getSeqNumber(seqNumber) != ESP_OK || seqNumber >= mTransactionSeqNumber)) {
+            continue;
+        }
+
         auto unused =  Page::ENTRY_COUNT - it->getUsedEntryCount();
         if (unused > maxUnusedItems) {
             maxUnusedItemsPageIt = it;
@@ -172,6 +189,10 @@ esp_err_t PageManager::requestNewPage()
 
     Page* erasedPage = maxUnusedItemsPageIt;
 
+    if (reclaimedPage) {
+        *reclaimedPage = erasedPage;
+    }
+
 #ifndef NDEBUG
     size_t usedEntries = erasedPage->getUsedEntryCount();
 #endif
@@ -179,6 +200,17 @@ esp_err_t PageManager::requestNewPage()
     if (err != ESP_OK) {
         return err;
     }
+
+    if (mTransactionActive) {
+        uint8_t movedEntries = erasedPage->getUsedEntryCount();
+        err = newPage->writeItem(Page::NS_INDEX, ItemType::U8, Page::TXN_RECLAIM_KEY, &movedEntries, sizeof(movedEntries));
+        if (err != ESP_OK) {
+            return err;
+        }
+#ifndef NDEBUG
+        ++usedEntries;
+#endif
+    }
     err = erasedPage->copyItems(*newPage);
     if (err != ESP_OK && err != ESP_ERR_NVS_NOT_FOUND) {
         return err;
@@ -199,6 +231,85 @@ esp_err_t PageManager::requestNewPage()
     return ESP_OK;
 }
 
+esp_err_t PageManager::reclaimStep(size_t maxEntries, ItemIndex* itemIndex, bool& finished)
+{
+    finished = true;
+
+    if (mTransactionActive) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+
+    if (mFreePageList.size() >= RECLAIM_FREE_PAGES) {
+        return ESP_OK;
+    }
+
+    // same choice as in requestNewPage(), except for the current page
+    Page& current = back();
+    Page* victim = nullptr;
+    size_t maxUnusedItems = 0;
+    for (auto it = begin(); it != end(); ++it) {
+        if (static_cast<Page*>(it) == &current) {
+            continue;
+        }
+        auto unused =  Page::ENTRY_COUNT - it->getUsedEntryCount();
+        if (unused > maxUnusedItems) {
+            victim = it;
+            maxUnusedItems = unused;
+        }
+    }
+
+    if (victim == nullptr) {
+        return ESP_OK;
+    }
+
+    if (victim->getUsedEntryCount() == 0) {
+        if (itemIndex) {
+            itemIndex->erasePage(victim);
+        }
+        auto err = victim->erase();
+        if (err != ESP_OK) {
+            return err;
+        }
+        mPageList.erase(victim);
+        mFreePageList.push_back(victim);
+        finished = (mFreePageList.size() >= RECLAIM_FREE_PAGES);
+        return ESP_OK;
+    }
+
+    // A page whose items don't fit into the current page is left to requestNewPage()
+    if (victim->getUsedEntryCount() > current.getFreeEntryCount()) {
+        return ESP_OK;
+    }
+
+    esp_err_t result = ESP_OK;
+    size_t movedEntries = 0;
+    size_t index = 0;
+    Item item;
+    while (movedEntries < maxEntries && victim->findItem(Page::NS_ANY, ItemType::ANY, nullptr, index, item) == ESP_OK) {
+        size_t newIndex;
+        auto err = victim->copyItem(index, current, &newIndex);
+        if (err != ESP_OK) {
+            return err;
+        }
+        if (itemIndex) {
+            itemIndex->erase(item, victim, index);
+            if (itemIndex->insert(item, &current, newIndex) != ESP_OK) {
+                // the item is moved anyway, the caller has to stop using the index
+                result = ESP_ERR_NO_MEM;
+            }
+        }
+        err = victim->eraseEntryAndSpan(index);
+        if (err != ESP_OK) {
+            return err;
+        }
+        movedEntries += item.span;
+        index += item.span;
+    }
+
+    finished = false;
+    return result;
+}
+
 esp_err_t PageManager::activatePage()
 {
     if (mFreePageList.empty()) {
@@ -218,6 +329,189 @@ esp_err_t PageManager::activatePage()
     return ESP_OK;
 }
 
+void PageManager::beginTransaction(size_t markerIndex)
+{
+    back().getSeqNumber(mTransactionSeqNumber);
+    mTransactionIndex = markerIndex;
+    mTransactionActive = true;
+}
+
+esp_err_t PageManager::endTransaction(bool committed, ItemIndex* itemIndex)
+{
+    if (!mTransactionActive) {
+        return ESP_ERR_NVS_INVALID_STATE;
+    }
+
+    for (auto it = begin(); it != end(); ++it) {
+        size_t index = transactionStart(*it);
+        Item item;
+        while (index < Page::ENTRY_COUNT && it->findItem(Page::NS_ANY, ItemType::ANY, nullptr, index, item) == ESP_OK) {
+            esp_err_t err = ESP_OK;
+            if (item.nsIndex == Page::NS_INDEX) {
+                // markers are erased last
+            } else if (!committed) {
+                err = eraseEntry(*it, index, item, itemIndex);
+            } else if (item.datatype != ItemType::BLOB_DATA) {
+                // chunks of the older versions are erased together with their blob index
+                err = eraseOlderVersions(item, itemIndex);
+            }
+            if (err != ESP_OK) {
+                return err;
+            }
+            index += item.span;
+        }
+    }
+
+    auto err = eraseTransactionMarkers(itemIndex);
+    if (err != ESP_OK) {
+        return err;
+    }
+    mTransactionActive = false;
+    return ESP_OK;
+}
+
+bool PageManager::isTransactionMarker(const Item& item)
+{
+    if (item.nsIndex != Page::NS_INDEX || item.datatype != ItemType::U8) {
+        return false;
+    }
+    return strncmp(item.key, Page::TXN_BEGIN_KEY, Item::MAX_KEY_LENGTH) == 0
+           || strncmp(item.key, Page::TXN_RECLAIM_KEY, Item::MAX_KEY_LENGTH) == 0
+           || strncmp(item.key, Page::TXN_COMMIT_KEY, Item::MAX_KEY_LENGTH) == 0;
+}
+
+esp_err_t PageManager::recoverTransaction()
+{
+    Item item;
+    for (auto it = begin(); it != end(); ++it) {
+        size_t index = 0;
+        if (it->findItem(Page::NS_INDEX, ItemType::U8, Page::TXN_BEGIN_KEY, index, item) == ESP_OK) {
+            it->getSeqNumber(mTransactionSeqNumber);
+            mTransactionIndex = index;
+            mTransactionActive = true;
+            break;
+        }
+    }
+
+    if (!mTransactionActive) {
+        // markers left behind after the begin marker was erased
+        return eraseTransactionMarkers(nullptr);
+    }
+
+    // a commit marker written before the begin marker belongs to an earlier transaction
+    bool committed = false;
+    for (auto it = begin(); it != end() && !committed; ++it) {
+        size_t index = 0;
+        while (it->findItem(Page::NS_INDEX, ItemType::U8, Page::TXN_COMMIT_KEY, index, item) == ESP_OK) {
+            if (isTransactionItem(*it, index)) {
+                committed = true;
+                break;
+            }
+            index += item.span;
+        }
+    }
+
+    return endTransaction(committed);
+}
+
+size_t PageManager::transactionStart(Page& page)
+{
+    uint32_t seqNumber;
+    if (!mTransactionActive || page.getSeqNumber(seqNumber) != ESP_OK || seqNumber < mTransactionSeqNumber) {
+        return Page::ENTRY_COUNT;
+    }
+    if (seqNumber == mTransactionSeqNumber) {
+        return mTransactionIndex + 1;
+    }
+
+    // a page activated during the transaction starts with the items moved from the reclaimed page, if any
+    size_t index = 0;
+    Item item;
+    if (page.findItem(Page::NS_INDEX, ItemType::U8, Page::TXN_RECLAIM_KEY, index, item) == ESP_OK && index == 0) {
+        uint8_t movedEntries;
+        if (item.getValue(movedEntries) == ESP_OK) {
+            return 1 + movedEntries;
+        }
+    }
+    return 0;
+}
+
+// Erase the items with the same namespace and key as the given item of the transaction, which were written before
+// the transaction. The same items are considered older versions as by Storage::writeItem.
+esp_err_t PageManager::eraseOlderVersions(const Item& item, ItemIndex* itemIndex)
+{
+    for (auto it = begin(); it != end(); ++it) {
+        if (it->state() == Page::PageState::FREEING) {
+            continue;
+        }
+        size_t index = 0;
+        Item old;
+        while (it->findItem(item.nsIndex, ItemType::ANY, item.key, index, old) == ESP_OK) {
+#ifdef CONFIG_NVS_LEGACY_DUP_KEYS_COMPATIBILITY
+            bool isOlderVersion = (old.datatype == item.datatype)
+                                  || (item.datatype == ItemType::BLOB_IDX && old.datatype == ItemType::BLOB);
+#else
+            bool isOlderVersion = (old.datatype != ItemType::BLOB_DATA);
+#endif
+            if (isOlderVersion && !isTransactionItem(*it, index)) {
+                if (old.datatype == ItemType::BLOB_IDX) {
+                    // the chunks of the new version have the other version offset, see Storage::writeItem
+                    size_t chunkStart = static_cast<size_t>(old.blobIndex.chunkStart);
+                    for (size_t chunk = chunkStart; chunk < chunkStart + old.blobIndex.chunkCount; ++chunk) {
+                        for (auto chunkIt = begin(); chunkIt != end(); ++chunkIt) {
+                            size_t chunkIndex = 0;
+                            Item data;
+                            while (chunkIt->findItem(item.nsIndex, ItemType::BLOB_DATA, item.key, chunkIndex, data, static_cast<uint8_t>(chunk)) == ESP_OK) {
+                                if (!isTransactionItem(*chunkIt, chunkIndex)) {
+                                    auto err = eraseEntry(*chunkIt, chunkIndex, data, itemIndex);
+                                    if (err != ESP_OK) {
+                                        return err;
+                                    }
+                                }
+                                chunkIndex += data.span;
+                            }
+                        }
+                    }
+                }
+                auto err = eraseEntry(*it, index, old, itemIndex);
+                if (err != ESP_OK) {
+                    return err;
+                }
+            }
+            index += old.span;
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t PageManager::eraseTransactionMarkers(ItemIndex* itemIndex)
+{
+    // The begin marker goes first: the other markers are meaningless without it.
+    const char* keys[] = {Page::TXN_BEGIN_KEY, Page::TXN_RECLAIM_KEY, Page::TXN_COMMIT_KEY};
+    for (auto key : keys) {
+        for (auto it = begin(); it != end(); ++it) {
+            size_t index = 0;
+            Item item;
+            while (it->findItem(Page::NS_INDEX, ItemType::U8, key, index, item) == ESP_OK) {
+                auto err = eraseEntry(*it, index, item, itemIndex);
+                if (err != ESP_OK) {
+                    return err;
+                }
+                index += item.span;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t PageManager::eraseEntry(Page& page, size_t index, const Item& item, ItemIndex* itemIndex)
+{
+    if (itemIndex) {
+        itemIndex->erase(item, &page, index);
+    }
+    return page.eraseEntryAndSpan(index);
+}
+
 esp_err_t PageManager::fillStats(nvs_stats_t& nvsStats)
 {
     nvsStats.used_entries      = 0;
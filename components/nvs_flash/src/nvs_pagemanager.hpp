@@ -18,6 +18,7 @@
 #include <list>
 #include "nvs_types.hpp"
 #include "nvs_page.hpp"
+#include "nvs_item_index.hpp"
 #include "partition.hpp"
 #include "intrusive_list.h"
 
@@ -52,10 +53,56 @@ public:
         return mPageCount;
     }
 
-    esp_err_t requestNewPage();
+    /**
+     * Activate a new page. If there are not enough free pages, the live items of the page with most erased
+     * entries are copied to the new page and the page is erased.
+     *
+     * @param reclaimedPage if not null, set to the page whose items were moved to the new page, or to nullptr
+     *                      if no page had to be reclaimed.
+     */
+    esp_err_t requestNewPage(Page** reclaimedPage = nullptr);
 
     esp_err_t fillStats(nvs_stats_t& nvsStats);
 
+    /**
+     * Start writing a transaction, i.e. a batch of items which are either all present after a power loss or none
+     * of them. The begin marker item has just been written at markerIndex of the current page.
+     *
+     * Until endTransaction() is called, only pages written before the begin marker are reclaimed, and the items
+     * moved by a reclaim are preceded by a reclaim marker holding their number of entries. All other items
+     * written after the begin marker belong to the transaction.
+     */
+    void beginTransaction(size_t markerIndex);
+
+    /**
+     * Finish the transaction. If it was committed, the older versions of the items of the transaction are
+     * erased, otherwise the items of the transaction are erased. The markers are erased last.
+     *
+     * @param itemIndex if not null, the erased items are removed from this index as well
+     */
+    esp_err_t endTransaction(bool committed, ItemIndex* itemIndex = nullptr);
+
+    bool isTransactionActive() const
+    {
+        return mTransactionActive;
+    }
+
+    static bool isTransactionMarker(const Item& item);
+
+    /**
+     * Do one step of reclaiming a page ahead of time, so that requestNewPage() finds enough free pages and
+     * doesn't have to copy items and erase a sector while an item is being written.
+     *
+     * A step either moves live items of the full page with the most erased entries to the current page,
+     * up to maxEntries entries but at least one item, or erases that page once it holds no live items.
+     * Every item is written to the current page before it is erased from the reclaimed page, the same way
+     * as an updated value, so a power loss doesn't lose it.
+     *
+     * @param itemIndex if not null, the moved items are updated in this index as well
+     * @param finished set to true if no further step is needed or possible
+     */
+    esp_err_t reclaimStep(size_t maxEntries, ItemIndex* itemIndex, bool& finished);
+
     uint32_t getBaseSector()
     {
         return mBaseSector;
@@ -66,12 +113,33 @@ protected:
 
     esp_err_t activatePage();
 
+    esp_err_t recoverTransaction();
+
+    size_t transactionStart(Page& page);
+
+    bool isTransactionItem(Page& page, size_t itemIndex)
+    {
+        return itemIndex >= transactionStart(page);
+    }
+
+    esp_err_t eraseOlderVersions(const Item& item, ItemIndex* itemIndex);
+
+    esp_err_t eraseTransactionMarkers(ItemIndex* itemIndex);
+
+    esp_err_t eraseEntry(Page& page, size_t index, const Item& item, ItemIndex* itemIndex);
+
     TPageList mPageList;
     TPageList mFreePageList;
     std::unique_ptr<Page[]> mPages;
     uint32_t mBaseSector;
     uint32_t mPageCount;
     uint32_t mSeqNumber;
+    // number of free pages which requestNewPage() needs to activate a page without reclaiming one
+    static const size_t RECLAIM_FREE_PAGES = 2;
+
+    bool mTransactionActive = false;
+    uint32_t mTransactionSeqNumber;
+    size_t mTransactionIndex;
 }; // class PageManager
 
 
@@ -89,6 +89,21 @@ public:
      */
     esp_err_t erase_range(size_t dst_offset, size_t size) override;
 
+    /**
+     * Look into \c esp_partition_mmap for more details.
+     *
+     * @return
+     *      - ESP_OK on success
+     *      - ESP_ERR_NOT_SUPPORTED if the partition is on an external flash chip
+     *      - other error codes from the esp_partition API
+     */
+    esp_err_t mmap(size_t src_offset, size_t size, const void** out_ptr, esp_partition_mmap_handle_t* out_handle) override;
+
+    /**
+     * Look into \c esp_partition_munmap for more details.
+     */
+    void munmap(esp_partition_mmap_handle_t handle) override;
+
     /**
      * @return the base address of the partition.
      */
@@ -49,46 +49,85 @@ void Storage::clearNamespaces()
     mNamespaces.clearAndFreeNodes();
 }
 
-esp_err_t Storage::populateBlobIndices(TBlobIndexList& blobIdxList)
+// Load the namespaces and collect the multi-page blob indices in a single pass over the items of all pages,
+// as every pass has to read the header of each item from flash.
+esp_err_t Storage::loadNamespacesAndBlobIndices(TBlobIndexList& blobIdxList)
 {
     for(auto it = mPageManager.begin(); it != mPageManager.end(); ++it) {
         Page& p = *it;
         size_t itemIndex = 0;
         Item item;
 
-        /* If the power went off just after writing a blob index, the duplicate detection
-         * logic in pagemanager will remove the earlier index. So we should never find a
-         * duplicate index at this point */
-
-        while(p.findItem(Page::NS_ANY, ItemType::BLOB_IDX, nullptr, itemIndex, item) == ESP_OK) {
-            BlobIndexNode* entry = new (std::nothrow) BlobIndexNode;
+        while(p.findItem(Page::NS_ANY, ItemType::ANY, nullptr, itemIndex, item) == ESP_OK) {
+            itemIndex += item.span;
 
-            if(!entry) return ESP_ERR_NO_MEM;
+            if(item.nsIndex == Page::NS_INDEX && item.datatype == ItemType::U8) {
+                // markers of an unfinished transaction are only left on a read-only partition
+                if(PageManager::isTransactionMarker(item)) {
+                    continue;
+                }
+                NamespaceEntry* entry = new (std::nothrow) NamespaceEntry;
 
-            item.getKey(entry->key, sizeof(entry->key));
-            entry->nsIndex = item.nsIndex;
-            entry->chunkStart = item.blobIndex.chunkStart;
-            entry->chunkCount = item.blobIndex.chunkCount;
-            entry->dataSize = item.blobIndex.dataSize;
-            entry->observedDataSize = 0;
-            entry->observedChunkCount = 0;
+                if(!entry) return ESP_ERR_NO_MEM;
 
-            blobIdxList.push_back(entry);
-            itemIndex += item.span;
+                item.getKey(entry->mName, sizeof(entry->mName));
+                esp_err_t err = item.getValue(entry->mIndex);
+                if(err != ESP_OK) {
+                    delete entry;
+                    return err;
+                }
+                if(mNamespaceUsage.set(entry->mIndex, true) != ESP_OK) {
+                    delete entry;
+                    return ESP_FAIL;
+                }
+                mNamespaces.push_back(entry);
+            } else if(item.datatype == ItemType::BLOB_IDX && item.chunkIndex == Page::CHUNK_ANY) {
+                /* If the power went off just after writing a blob index, the duplicate detection
+                 * logic in pagemanager will remove the earlier index. So we should never find a
+                 * duplicate index at this point */
+                BlobIndexNode* entry = new (std::nothrow) BlobIndexNode;
+
+                if(!entry) return ESP_ERR_NO_MEM;
+
+                item.getKey(entry->key, sizeof(entry->key));
+                entry->nsIndex = item.nsIndex;
+                entry->chunkStart = item.blobIndex.chunkStart;
+                entry->chunkCount = item.blobIndex.chunkCount;
+                entry->dataSize = item.blobIndex.dataSize;
+                entry->observedDataSize = 0;
+                entry->observedChunkCount = 0;
+
+                blobIdxList.push_back(entry);
+            }
         }
     }
 
     return ESP_OK;
 }
 
+bool Storage::isOrphanDataBlob(TBlobIndexList& blobIdxList, const Item& item)
+{
+    auto iter = std::find_if(blobIdxList.begin(),
+            blobIdxList.end(),
+            [&] (const BlobIndexNode& e) -> bool
+            {return (strncmp(item.key, e.key, sizeof(e.key) - 1) == 0)
+                    && (item.nsIndex == e.nsIndex)
+                    && (item.chunkIndex >=  static_cast<uint8_t> (e.chunkStart))
+                    && (item.chunkIndex < static_cast<uint8_t> (e.chunkStart) + e.chunkCount);});
+    return iter == std::end(blobIdxList);
+}
+
 // Check BLOB_DATA entries belonging to BLOB_INDEX entries for mismatched records.
 // BLOB_INDEX record is compared with information collected from BLOB_DATA records
 // matched using namespace index, key and chunk version. Mismatched summary length
 // or wrong number of chunks are checked. Mismatched BLOB_INDEX data are deleted
-// and removed from the blobIdxList. The BLOB_DATA are left as orphans and removed
-// later by the call to eraseOrphanDataBlobs().
-void Storage::eraseMismatchedBlobIndexes(TBlobIndexList& blobIdxList)
+// and removed from the blobIdxList.
+// BLOB_DATA entries not belonging to any BLOB_INDEX are deleted in the same pass.
+// The BLOB_DATA of a mismatched BLOB_INDEX are left as orphans and the function
+// returns true, so that they are removed later by the call to eraseOrphanDataBlobs().
+bool Storage::eraseMismatchedBlobIndexes(TBlobIndexList& blobIdxList)
 {
+    bool erased = false;
     for(auto it = mPageManager.begin(); it != mPageManager.end(); ++it) {
         Page& p = *it;
         size_t itemIndex = 0;
@@ -112,6 +151,9 @@ void Storage::eraseMismatchedBlobIndexes(TBlobIndexList& blobIdxList)
                 iter->observedDataSize += item.varLength.dataSize;
                 iter->observedChunkCount++;
             }
+            if(isOrphanDataBlob(blobIdxList, item)) {
+                p.eraseItem(item.nsIndex, item.datatype, item.key, item.chunkIndex);
+            }
             itemIndex += item.span;
         }
     }
@@ -142,6 +184,7 @@ void Storage::eraseMismatchedBlobIndexes(TBlobIndexList& blobIdxList)
             ++iter;
             blobIdxList.erase(tmp);
             delete (nvs::Storage::BlobIndexNode*)tmp;
+            erased = true;
         }
         else
         {
@@ -149,6 +192,7 @@ void Storage::eraseMismatchedBlobIndexes(TBlobIndexList& blobIdxList)
             ++iter;
         }
     }
+    return erased;
 }
 
 void Storage::eraseOrphanDataBlobs(TBlobIndexList& blobIdxList)
@@ -163,15 +207,7 @@ void Storage::eraseOrphanDataBlobs(TBlobIndexList& blobIdxList)
          * 2) VER_1_OFFSET <= chunkIndex < VER_ANY => Version1 chunks
          */
         while(p.findItem(Page::NS_ANY, ItemType::BLOB_DATA, nullptr, itemIndex, item) == ESP_OK) {
-
-            auto iter = std::find_if(blobIdxList.begin(),
-                    blobIdxList.end(),
-                    [=] (const BlobIndexNode& e) -> bool
-                    {return (strncmp(item.key, e.key, sizeof(e.key) - 1) == 0)
-                            && (item.nsIndex == e.nsIndex)
-                            && (item.chunkIndex >=  static_cast<uint8_t> (e.chunkStart))
-                            && (item.chunkIndex < static_cast<uint8_t> (e.chunkStart) + e.chunkCount);});
-            if(iter == std::end(blobIdxList)) {
+            if(isOrphanDataBlob(blobIdxList, item)) {
                 p.eraseItem(item.nsIndex, item.datatype, item.key, item.chunkIndex);
             }
 
@@ -188,59 +224,40 @@ esp_err_t Storage::init(uint32_t baseSector, uint32_t sectorCount)
         return err;
     }
 
-    // load namespaces list
+    // load namespaces list and the list of multi-page index entries
     clearNamespaces();
     std::fill_n(mNamespaceUsage.data(), mNamespaceUsage.byteSize() / 4, 0);
-    for(auto it = mPageManager.begin(); it != mPageManager.end(); ++it) {
-        Page& p = *it;
-        size_t itemIndex = 0;
-        Item item;
-        while(p.findItem(Page::NS_INDEX, ItemType::U8, nullptr, itemIndex, item) == ESP_OK) {
-            NamespaceEntry* entry = new (std::nothrow) NamespaceEntry;
-
-            if(!entry) {
-                mState = StorageState::INVALID;
-                return ESP_ERR_NO_MEM;
-            }
-
-            item.getKey(entry->mName, sizeof(entry->mName));
-            err = item.getValue(entry->mIndex);
-            if(err != ESP_OK) {
-                delete entry;
-                return err;
-            }
-            if(mNamespaceUsage.set(entry->mIndex, true) != ESP_OK) {
-                delete entry;
-                return ESP_FAIL;
-            }
-            mNamespaces.push_back(entry);
-            itemIndex += item.span;
-        }
+    TBlobIndexList blobIdxList;
+    err = loadNamespacesAndBlobIndices(blobIdxList);
+    if(err != ESP_OK) {
+        blobIdxList.clearAndFreeNodes();
+        mState = StorageState::INVALID;
+        return err;
     }
     if(mNamespaceUsage.set(0, true) != ESP_OK) {
+        blobIdxList.clearAndFreeNodes();
         return ESP_FAIL;
     }
     if(mNamespaceUsage.set(255, true) != ESP_OK) {
+        blobIdxList.clearAndFreeNodes();
         return ESP_FAIL;
     }
 
-    // Populate list of multi-page index entries.
-    TBlobIndexList blobIdxList;
-    err = populateBlobIndices(blobIdxList);
-    if(err != ESP_OK) {
-        mState = StorageState::INVALID;
-        return ESP_ERR_NO_MEM;
+    // Remove blob indexes with mismatched blob data length or chunk count,
+    // and the entries for which there is no parent multi-page index.
+    if(eraseMismatchedBlobIndexes(blobIdxList)) {
+        // Remove the entries of the blob indexes erased above.
+        eraseOrphanDataBlobs(blobIdxList);
     }
 
-    // remove blob indexes with mismatched blob data length or chunk count
-    eraseMismatchedBlobIndexes(blobIdxList);
-
-    // Remove the entries for which there is no parent multi-page index.
-    eraseOrphanDataBlobs(blobIdxList);
-
     // Purge the blob index list
     blobIdxList.clearAndFreeNodes();
 
+    if(mItemIndexEnabled) {
+        rebuildItemIndex();
+    }
+
+    mItemCache.clear();
     mState = StorageState::ACTIVE;
 
 #ifdef DEBUG_STORAGE
@@ -256,6 +273,54 @@ bool Storage::isValid() const
 
 esp_err_t Storage::findItem(uint8_t nsIndex, ItemType datatype, const char* key, Page* &page, Item& item, uint8_t chunkIdx, VerOffset chunkStart, size_t* itemIndex)
 {
+    // The item index can be used under the same conditions as the HashList of the page, i.e. if the hash
+    // of namespace index, key and chunk index is known.
+    if(mItemIndexEnabled && nsIndex != Page::NS_ANY && key != nullptr && (datatype != ItemType::BLOB_DATA || chunkIdx != Page::CHUNK_ANY)) {
+        ItemIndex::Candidate candidates[ITEM_INDEX_MAX_CANDIDATES];
+        uint32_t seqNumbers[ITEM_INDEX_MAX_CANDIDATES];
+        size_t count = mItemIndex.find(Item(nsIndex, datatype, 0, key, chunkIdx), candidates, ITEM_INDEX_MAX_CANDIDATES);
+
+        if(count <= ITEM_INDEX_MAX_CANDIDATES) {
+            // Visit the candidate pages in the same order as the scan over the page list would,
+            // candidates on the same page are ordered by their entry index.
+            size_t valid = 0;
+            for(size_t i = 0; i < count; ++i) {
+                ItemIndex::Candidate candidate = candidates[i];
+                uint32_t seqNumber;
+                if(candidate.mPage->getSeqNumber(seqNumber) != ESP_OK) {
+                    continue;
+                }
+                size_t pos = valid++;
+                while(pos > 0 && (seqNumbers[pos - 1] > seqNumber ||
+                        (seqNumbers[pos - 1] == seqNumber && candidates[pos - 1].mIndex > candidate.mIndex))) {
+                    candidates[pos] = candidates[pos - 1];
+                    seqNumbers[pos] = seqNumbers[pos - 1];
+                    --pos;
+                }
+                candidates[pos] = candidate;
+                seqNumbers[pos] = seqNumber;
+            }
+
+            for(size_t i = 0; i < valid; ++i) {
+                // The lookup starting at the lowest candidate index of the page finds the same item as the
+                // lookup of the whole page, as all live items with the same hash are present in the index.
+                if(i > 0 && candidates[i].mPage == candidates[i - 1].mPage) {
+                    continue;
+                }
+                size_t tmpItemIndex = candidates[i].mIndex;
+                auto err = candidates[i].mPage->findItem(nsIndex, datatype, key, tmpItemIndex, item, chunkIdx, chunkStart);
+                if(err == ESP_OK) {
+                    page = candidates[i].mPage;
+                    if(itemIndex) {
+                        *itemIndex = tmpItemIndex;
+                    }
+                    return ESP_OK;
+                }
+            }
+            return ESP_ERR_NVS_NOT_FOUND;
+        }
+    }
+
     for(auto it = std::begin(mPageManager); it != std::end(mPageManager); ++it) {
         size_t tmpItemIndex = 0;
         auto err = it->findItem(nsIndex, datatype, key, tmpItemIndex, item, chunkIdx, chunkStart);
@@ -301,7 +366,7 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
                     return err;
                 }
             }
-            err = mPageManager.requestNewPage();
+            err = requestNewPage();
             if(err != ESP_OK) {
                 return err;
             } else if(getCurrentPage().getVarDataTailroom() == tailroom) {
@@ -321,14 +386,16 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
         chunkSize = (remainingSize > tailroom)? tailroom : remainingSize;
         remainingSize -= chunkSize;
 
+        size_t itemIndex;
         err = page.writeItem(nsIndex, ItemType::BLOB_DATA, key,
-                static_cast<const uint8_t*> (data) + offset, chunkSize, static_cast<uint8_t> (chunkStart) + chunkCount);
+                static_cast<const uint8_t*> (data) + offset, chunkSize, static_cast<uint8_t> (chunkStart) + chunkCount, &itemIndex);
         chunkCount++;
 
         if(err != ESP_OK) {
             NVS_ASSERT_OR_RETURN(err != ESP_ERR_NVS_PAGE_FULL, err);
             break;
         } else {
+            indexItem(page, itemIndex, nsIndex, ItemType::BLOB_DATA, key, static_cast<uint8_t> (chunkStart) + chunkCount - 1);
             UsedPageNode* node = new (std::nothrow) UsedPageNode();
             if(!node) {
                 err = ESP_ERR_NO_MEM;
@@ -343,7 +410,7 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
                         break;
                     }
                 }
-                err = mPageManager.requestNewPage();
+                err = requestNewPage();
                 if(err != ESP_OK) {
                     break;
                 }
@@ -358,8 +425,11 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
             item.blobIndex.chunkCount = chunkCount;
             item.blobIndex.chunkStart = chunkStart;
 
-            err = getCurrentPage().writeItem(nsIndex, ItemType::BLOB_IDX, key, item.data, sizeof(item.data));
+            err = getCurrentPage().writeItem(nsIndex, ItemType::BLOB_IDX, key, item.data, sizeof(item.data), Page::CHUNK_ANY, &itemIndex);
             NVS_ASSERT_OR_RETURN(err != ESP_ERR_NVS_PAGE_FULL, err);
+            if(err == ESP_OK) {
+                indexItem(getCurrentPage(), itemIndex, nsIndex, ItemType::BLOB_IDX, key);
+            }
             break;
         }
     } while(1);
@@ -368,21 +438,29 @@ esp_err_t Storage::writeMultiPageBlob(uint8_t nsIndex, const char* key, const vo
         /* Anything failed, then we should erase all the written chunks*/
         int ii=0;
         for(auto it = std::begin(usedPages); it != std::end(usedPages); it++) {
-            it->mPage->eraseItem(nsIndex, ItemType::BLOB_DATA, key, ii++);
+            it->mPage->eraseItem(nsIndex, ItemType::BLOB_DATA, key, static_cast<uint8_t> (chunkStart) + ii++);
         }
     }
     usedPages.clearAndFreeNodes();
     return err;
 }
 
+esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize)
+{
+    return writeItem(nsIndex, datatype, key, data, dataSize, true);
+}
+
 // datatype BLOB is written as BLOB_INDEX and BLOB_DATA and is searched for previous value as BLOB_INDEX and/or BLOB
 // datatype BLOB_INDEX and BLOB_DATA are not supported as input parameters, the layer above should always use BLOB
-esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize)
+esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, bool eraseOldValue)
 {
     if(mState != StorageState::ACTIVE) {
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+    // values of the key with any datatype may be replaced below
+    mItemCache.invalidate(nsIndex, key);
+
     // pointer to the page where the existing item was found
     Page* findPage = nullptr;
     // index of the item in the page where the existing item was found
@@ -485,21 +563,23 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
             return ESP_OK;
         }
 
-        Page& page = getCurrentPage();
-        err = page.writeItem(nsIndex, datatype, key, data, dataSize);
+        Page* page = &getCurrentPage();
+        size_t newItemIndex;
+        err = page->writeItem(nsIndex, datatype, key, data, dataSize, Page::CHUNK_ANY, &newItemIndex);
         if(err == ESP_ERR_NVS_PAGE_FULL) {
-            if(page.state() != Page::PageState::FULL) {
-                err = page.markFull();
+            if(page->state() != Page::PageState::FULL) {
+                err = page->markFull();
                 if(err != ESP_OK) {
                     return err;
                 }
             }
-            err = mPageManager.requestNewPage();
+            err = requestNewPage();
             if(err != ESP_OK) {
                 return err;
             }
 
-            err = getCurrentPage().writeItem(nsIndex, datatype, key, data, dataSize);
+            page = &getCurrentPage();
+            err = page->writeItem(nsIndex, datatype, key, data, dataSize, Page::CHUNK_ANY, &newItemIndex);
             if(err == ESP_ERR_NVS_PAGE_FULL) {
                 return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
             }
@@ -508,13 +588,16 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
         if(err != ESP_OK) {
             return err;
         }
+
+        indexItem(*page, newItemIndex, nsIndex, datatype, key);
     }
 
     // Delete previous value
     // Note: The old entry won't be deleted if the new value is the same as the old value - code won't reach here in that case.
 
     // If findPage is null then previous value was not present in NVS and nothig is to be deleted.
-    if(findPage == nullptr) {
+    // Within a transaction, the previous value is erased by PageManager::endTransaction() after the commit.
+    if(findPage == nullptr || !eraseOldValue) {
         return err;
     }
 
@@ -562,6 +645,7 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
         }
 
         // Page containing the old value is now refreshed. We can erase the old value.
+        unindexItem(item, findPage, itemIndex);
         err = findPage->eraseEntryAndSpan(itemIndex);
         if(err == ESP_ERR_FLASH_OP_FAIL) {
             return ESP_ERR_NVS_REMOVE_FAILED;
@@ -574,6 +658,108 @@ esp_err_t Storage::writeItem(uint8_t nsIndex, ItemType datatype, const char* key
     return err;
 }
 
+esp_err_t Storage::commitTransaction(uint8_t nsIndex, Transaction& transaction)
+{
+    if(mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    if(transaction.size() == 0) {
+        return ESP_OK;
+    }
+
+    size_t markerIndex;
+    esp_err_t err = writeTransactionMarker(Page::TXN_BEGIN_KEY, &markerIndex);
+    if(err != ESP_OK) {
+        return err;
+    }
+    mPageManager.beginTransaction(markerIndex);
+
+    // The new values are appended next to the old ones, which stay valid until the commit marker is written.
+    for(auto it = transaction.items().begin(); it != transaction.items().end(); ++it) {
+        err = writeItem(nsIndex, it->mDatatype, it->mKey, it->mData, it->mDataSize, false);
+        if(err != ESP_OK) {
+            break;
+        }
+    }
+
+    if(err == ESP_OK) {
+        err = writeTransactionMarker(Page::TXN_COMMIT_KEY, nullptr);
+    }
+
+    auto endErr = mPageManager.endTransaction(err == ESP_OK, mItemIndexEnabled ? &mItemIndex : nullptr);
+    if(endErr != ESP_OK) {
+        // The markers are still in flash. Further writes would be mistaken for a part of the transaction,
+        // so the storage has to be initialized again, which completes the transaction.
+        mState = StorageState::INVALID;
+        return endErr;
+    }
+
+#ifdef DEBUG_STORAGE
+    if(err == ESP_OK) {
+        debugCheck();
+    }
+#endif
+    return err;
+}
+
+esp_err_t Storage::reclaimStep(size_t maxEntries)
+{
+    if(mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    bool finished;
+    auto err = mPageManager.reclaimStep(maxEntries, mItemIndexEnabled ? &mItemIndex : nullptr, finished);
+    if(err == ESP_ERR_NO_MEM && mItemIndexEnabled) {
+        disableItemIndex();
+    }
+    if(err != ESP_OK) {
+        return err;
+    }
+
+#ifdef DEBUG_STORAGE
+    debugCheck();
+#endif
+    return finished ? ESP_OK : ESP_ERR_NOT_FINISHED;
+}
+
+esp_err_t Storage::writeTransactionMarker(const char* key, size_t* markerIndex)
+{
+    const uint8_t value = 0;
+    Page* page = &getCurrentPage();
+    size_t itemIndex;
+    esp_err_t err = page->writeItem(Page::NS_INDEX, ItemType::U8, key, &value, sizeof(value), Page::CHUNK_ANY, &itemIndex);
+    if(err == ESP_ERR_NVS_PAGE_FULL) {
+        if(page->state() != Page::PageState::FULL) {
+            err = page->markFull();
+            if(err != ESP_OK) {
+                return err;
+            }
+        }
+        err = requestNewPage();
+        if(err != ESP_OK) {
+            return err;
+        }
+
+        page = &getCurrentPage();
+        err = page->writeItem(Page::NS_INDEX, ItemType::U8, key, &value, sizeof(value), Page::CHUNK_ANY, &itemIndex);
+        if(err == ESP_ERR_NVS_PAGE_FULL) {
+            return ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+        }
+    }
+
+    if(err != ESP_OK) {
+        return err;
+    }
+
+    indexItem(*page, itemIndex, Page::NS_INDEX, ItemType::U8, key);
+    if(markerIndex) {
+        *markerIndex = itemIndex;
+    }
+    return ESP_OK;
+}
+
 esp_err_t Storage::createOrOpenNamespace(const char* nsName, bool canCreate, uint8_t& nsIndex)
 {
     if(mState != StorageState::ACTIVE) {
@@ -745,6 +931,22 @@ esp_err_t Storage::readItem(uint8_t nsIndex, ItemType datatype, const char* key,
         return ESP_ERR_NVS_NOT_INITIALIZED;
     }
 
+    if(isCacheable(datatype)) {
+        const ItemCache::CacheEntry* cached = mItemCache.find(nsIndex, datatype, key);
+        if(cached) {
+            // same checks as in Page::readItem
+            if(!isVariableLengthType(datatype)) {
+                if(dataSize != cached->mDataSize) {
+                    return ESP_ERR_NVS_TYPE_MISMATCH;
+                }
+            } else if(dataSize < cached->mDataSize) {
+                return ESP_ERR_NVS_INVALID_LENGTH;
+            }
+            memcpy(data, cached->mData, cached->mDataSize);
+            return ESP_OK;
+        }
+    }
+
     Item item;
     Page* findPage = nullptr;
     if(datatype == ItemType::BLOB) {
@@ -758,8 +960,122 @@ esp_err_t Storage::readItem(uint8_t nsIndex, ItemType datatype, const char* key,
     if(err != ESP_OK) {
         return err;
     }
-    return findPage->readItem(nsIndex, datatype, key, data, dataSize);
+    err = findPage->readItem(nsIndex, datatype, key, data, dataSize);
+    if(err == ESP_OK && isCacheable(datatype)) {
+        mItemCache.insert(nsIndex, datatype, key, data, isVariableLengthType(datatype) ? item.varLength.dataSize : dataSize);
+    }
+    return err;
+}
+
+esp_err_t Storage::openBlobReader(nvs_opaque_blob_reader_t* reader, uint8_t nsIndex, const char* key)
+{
+    if(mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
 
+    reader->storage = this;
+    reader->nsIndex = nsIndex;
+    strlcpy(reader->key, key, sizeof(reader->key));
+    reader->nextChunk = 0;
+    reader->offset = 0;
+    reader->mapped = nullptr;
+    reader->buffer = nullptr;
+
+    Item item;
+    Page* findPage = nullptr;
+    auto err = findItem(nsIndex, ItemType::BLOB_IDX, reader->key, findPage, item);
+    if(err == ESP_OK) {
+        reader->chunkStart = item.blobIndex.chunkStart;
+        reader->chunkCount = item.blobIndex.chunkCount;
+        reader->dataSize = item.blobIndex.dataSize;
+        return ESP_OK;
+    } else if(err != ESP_ERR_NVS_NOT_FOUND) {
+        return err;
+    }
+
+    // a blob stored with earlier version format without index is returned as a single chunk
+    err = findItem(nsIndex, ItemType::BLOB, reader->key, findPage, item);
+    if(err != ESP_OK) {
+        return err;
+    }
+    reader->chunkStart = VerOffset::VER_ANY;
+    reader->chunkCount = 1;
+    reader->dataSize = item.varLength.dataSize;
+    return ESP_OK;
+}
+
+esp_err_t Storage::nextBlobChunk(nvs_opaque_blob_reader_t* reader, nvs_blob_chunk_t& chunk)
+{
+    closeBlobReader(reader);
+
+    if(mState != StorageState::ACTIVE) {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    if(reader->nextChunk >= reader->chunkCount) {
+        // all chunks have been returned, they must add up to the length of the blob
+        return (reader->offset == reader->dataSize) ? ESP_ERR_NVS_NOT_FOUND : ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    Item item;
+    Page* findPage = nullptr;
+    size_t itemIndex = 0;
+    esp_err_t err;
+    if(reader->chunkStart == VerOffset::VER_ANY) {
+        err = findItem(reader->nsIndex, ItemType::BLOB, reader->key, findPage, item, Page::CHUNK_ANY, VerOffset::VER_ANY, &itemIndex);
+    } else {
+        err = findItem(reader->nsIndex, ItemType::BLOB_DATA, reader->key, findPage, item, static_cast<uint8_t> (reader->chunkStart) + reader->nextChunk, VerOffset::VER_ANY, &itemIndex);
+    }
+    if(err != ESP_OK) {
+        return err;
+    }
+
+    // same check as in readMultiPageBlob()
+    if(item.varLength.dataSize > reader->dataSize - reader->offset) {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    const void* data = nullptr;
+    if(item.varLength.dataSize > 0) {
+        err = findPage->mmapVariableLengthItemData(item, itemIndex, &data, &reader->mmapHandle);
+        if(err == ESP_OK) {
+            reader->mapped = data;
+        } else if(err == ESP_ERR_NOT_SUPPORTED) {
+            reader->buffer = new (std::nothrow) uint8_t[item.varLength.dataSize];
+            if(!reader->buffer) {
+                return ESP_ERR_NO_MEM;
+            }
+            err = findPage->readVariableLengthItemData(item, itemIndex, reader->buffer);
+            if(err != ESP_OK) {
+                closeBlobReader(reader);
+                return err;
+            }
+            data = reader->buffer;
+        } else {
+            return err;
+        }
+    }
+
+    chunk.data = data;
+    chunk.size = item.varLength.dataSize;
+    chunk.offset = reader->offset;
+    chunk.ver_offset = (reader->chunkStart == VerOffset::VER_ANY) ? 0 : static_cast<uint8_t> (reader->chunkStart);
+    chunk.chunk_index = reader->nextChunk;
+    chunk.mapped = (reader->mapped != nullptr);
+
+    reader->offset += item.varLength.dataSize;
+    ++reader->nextChunk;
+    return ESP_OK;
+}
+
+void Storage::closeBlobReader(nvs_opaque_blob_reader_t* reader)
+{
+    if(reader->mapped) {
+        mPartition->munmap(reader->mmapHandle);
+        reader->mapped = nullptr;
+    }
+    delete [] reader->buffer;
+    reader->buffer = nullptr;
 }
 
 esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffset chunkStart)
@@ -780,6 +1096,7 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
     chunkCount = item.blobIndex.chunkCount;
 
     // Erase the index first and make children blobs orphan
+    unindexItem(item, findPage, itemIndex);
     err = findPage->eraseEntryAndSpan(itemIndex);
     if(err != ESP_OK) {
         return err;
@@ -796,6 +1113,7 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
         // Ignore potential error if the item is not found
         err = findItem(nsIndex, ItemType::BLOB_IDX, key, findPage, item, Page::CHUNK_ANY, chunkStart, &itemIndex);
         if(err == ESP_OK) {
+            unindexItem(item, findPage, itemIndex);
             err = findPage->eraseEntryAndSpan(itemIndex);
             if(err != ESP_OK) {
                 return err;
@@ -817,6 +1135,7 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
                 if(err == ESP_ERR_NVS_NOT_FOUND) {
                     break;
                 } else if(err == ESP_OK) {
+                    unindexItem(item, &(*it), itemIndex);
                     err = it->eraseEntryAndSpan(itemIndex);
 
                     // advance itemIndex to the next potential entry on the page
@@ -853,6 +1172,7 @@ esp_err_t Storage::eraseMultiPageBlob(uint8_t nsIndex, const char* key, VerOffse
             }
 
             // Erase the entry
+            unindexItem(item, findPage, itemIndex);
             err = findPage->eraseEntryAndSpan(itemIndex);
             if(err != ESP_OK) {
                 return err;
@@ -874,6 +1194,8 @@ esp_err_t Storage::eraseItem(uint8_t nsIndex, ItemType datatype, const char* key
     esp_err_t err = ESP_OK;
     size_t itemIndex = 0;
 
+    mItemCache.invalidate(nsIndex, key);
+
     err = findItem(nsIndex, datatype, key, findPage, item, Page::CHUNK_ANY, VerOffset::VER_ANY, &itemIndex);
     if(err != ESP_OK) {
         return err;
@@ -883,6 +1205,7 @@ esp_err_t Storage::eraseItem(uint8_t nsIndex, ItemType datatype, const char* key
         return eraseMultiPageBlob(nsIndex, key, item.blobIndex.chunkStart);
     }
 
+    unindexItem(item, findPage, itemIndex);
     return findPage->eraseEntryAndSpan(itemIndex);
 }
 
@@ -903,6 +1226,13 @@ esp_err_t Storage::eraseNamespace(uint8_t nsIndex)
             }
         }
     }
+
+    mItemCache.invalidateNamespace(nsIndex);
+
+    // Items of the namespace are erased page by page without their keys being known, build the index anew
+    if(mItemIndexEnabled) {
+        rebuildItemIndex();
+    }
     return ESP_OK;
 
 }
@@ -937,6 +1267,14 @@ esp_err_t Storage::getItemDataSize(uint8_t nsIndex, ItemType datatype, const cha
     Page* findPage = nullptr;
     esp_err_t err = ESP_OK;
 
+    if(isCacheable(datatype)) {
+        const ItemCache::CacheEntry* cached = mItemCache.find(nsIndex, datatype, key);
+        if(cached) {
+            dataSize = cached->mDataSize;
+            return ESP_OK;
+        }
+    }
+
     // If requested datatype is BLOB, first try to find the item with datatype BLOB_IDX - new format
     // If not found, try to find the item with datatype BLOB - old format.
     if(datatype == ItemType::BLOB) {
@@ -957,6 +1295,94 @@ esp_err_t Storage::getItemDataSize(uint8_t nsIndex, ItemType datatype, const cha
     return ESP_OK;
 }
 
+esp_err_t Storage::requestNewPage()
+{
+    Page* reclaimedPage = nullptr;
+    esp_err_t err = mPageManager.requestNewPage(&reclaimedPage);
+    if(!mItemIndexEnabled || reclaimedPage == nullptr) {
+        return err;
+    }
+
+    if(err != ESP_OK) {
+        // Reclaiming the page failed half way, the location of its items is unknown
+        rebuildItemIndex();
+        return err;
+    }
+
+    // Items of the reclaimed page were moved to the new page
+    mItemIndex.erasePage(reclaimedPage);
+    indexPage(getCurrentPage());
+    return ESP_OK;
+}
+
+void Storage::indexPage(Page& page)
+{
+    size_t itemIndex = 0;
+    Item item;
+    while(page.findItem(Page::NS_ANY, ItemType::ANY, nullptr, itemIndex, item) == ESP_OK) {
+        if(mItemIndex.insert(item, &page, itemIndex) != ESP_OK) {
+            disableItemIndex();
+            return;
+        }
+        itemIndex += item.span;
+    }
+}
+
+void Storage::rebuildItemIndex()
+{
+    mItemIndex.clear();
+    mItemIndexEnabled = true;
+    for(auto it = mPageManager.begin(); it != mPageManager.end() && mItemIndexEnabled; ++it) {
+        indexPage(*it);
+    }
+
+    ESP_LOGD(TAG, "item index of %s: %u items, %u bytes", getPartName(),
+            static_cast<unsigned>(mItemIndex.size()), static_cast<unsigned>(getItemIndexMemoryUsage()));
+}
+
+void Storage::indexItem(Page& page, size_t itemIndex, uint8_t nsIndex, ItemType datatype, const char* key, uint8_t chunkIdx)
+{
+    if(!mItemIndexEnabled) {
+        return;
+    }
+    if(mItemIndex.insert(Item(nsIndex, datatype, 0, key, chunkIdx), &page, itemIndex) != ESP_OK) {
+        disableItemIndex();
+    }
+}
+
+void Storage::unindexItem(const Item& item, const Page* page, size_t itemIndex)
+{
+    if(mItemIndexEnabled) {
+        mItemIndex.erase(item, page, itemIndex);
+    }
+}
+
+void Storage::disableItemIndex()
+{
+    // An incomplete index would hide items, fall back to the lookup of all pages
+    ESP_LOGW(TAG, "not enough memory for item index of %s, disabling it", getPartName());
+    mItemIndex.clear();
+    mItemIndexEnabled = false;
+}
+
+esp_err_t Storage::setItemIndexEnabled(bool enabled)
+{
+    if(!enabled) {
+        mItemIndex.clear();
+        mItemIndexEnabled = false;
+        return ESP_OK;
+    }
+
+    if(mState != StorageState::ACTIVE) {
+        // the index will be built by init()
+        mItemIndexEnabled = true;
+        return ESP_OK;
+    }
+
+    rebuildItemIndex();
+    return mItemIndexEnabled ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
 void Storage::debugDump()
 {
     for(auto p = mPageManager.begin(); p != mPageManager.end(); ++p) {
@@ -994,9 +1420,19 @@ void Storage::debugCheck()
 esp_err_t Storage::fillStats(nvs_stats_t& nvsStats)
 {
     nvsStats.namespace_count = mNamespaces.size();
+    nvsStats.item_index_memory = getItemIndexMemoryUsage();
     return mPageManager.fillStats(nvsStats);
 }
 
+void Storage::fillCacheStats(nvs_cache_stats_t& cacheStats)
+{
+    cacheStats.hits         = mItemCache.hits();
+    cacheStats.misses       = mItemCache.misses();
+    cacheStats.evictions    = mItemCache.evictions();
+    cacheStats.cached_items = mItemCache.size();
+    cacheStats.max_items    = mItemCache.capacity();
+}
+
 esp_err_t Storage::calcEntriesInNamespace(uint8_t nsIndex, size_t& usedEntries)
 {
     usedEntries = 0;
@@ -9,10 +9,14 @@
 #include <memory>
 #include <cstdlib>
 #include <unordered_map>
+#include "sdkconfig.h"
 #include "nvs.hpp"
 #include "nvs_types.hpp"
 #include "nvs_page.hpp"
 #include "nvs_pagemanager.hpp"
+#include "nvs_item_index.hpp"
+#include "nvs_item_cache.hpp"
+#include "nvs_transaction.hpp"
 #include "nvs_memory_management.hpp"
 #include "partition.hpp"
 
@@ -62,6 +66,9 @@ public:
         if (partition == nullptr) {
             abort();
         }
+#ifdef CONFIG_NVS_READ_CACHE_SIZE
+        mItemCache.setCapacity(CONFIG_NVS_READ_CACHE_SIZE);
+#endif
     };
 
     esp_err_t init(uint32_t baseSector, uint32_t sectorCount);
@@ -74,6 +81,20 @@ public:
 
     esp_err_t readItem(uint8_t nsIndex, ItemType datatype, const char* key, void* data, size_t dataSize);
 
+    /**
+     * Write all items staged in the transaction, so that either all of them or none of them are present after
+     * a power loss. The items are appended first, the older values are erased once a commit marker follows them.
+     * While the transaction is written, only the pages written before it are reclaimed. If the items don't fit,
+     * the items written so far are erased again and ESP_ERR_NVS_NOT_ENOUGH_SPACE is returned.
+     */
+    esp_err_t commitTransaction(uint8_t nsIndex, Transaction& transaction);
+
+    /**
+     * Reclaim space ahead of time, moving at most maxEntries entries, see PageManager::reclaimStep().
+     * Returns ESP_ERR_NOT_FINISHED if further steps are needed.
+     */
+    esp_err_t reclaimStep(size_t maxEntries);
+
     esp_err_t findKey(const uint8_t nsIndex, const char* key, ItemType* datatype);
 
     esp_err_t getItemDataSize(uint8_t nsIndex, ItemType datatype, const char* key, size_t& dataSize);
@@ -136,6 +157,42 @@ public:
 
     bool nextEntry(nvs_opaque_iterator_t* it);
 
+    /**
+     * Look up a blob and prepare the reader for returning its chunks one by one with nextBlobChunk().
+     */
+    esp_err_t openBlobReader(nvs_opaque_blob_reader_t* reader, uint8_t nsIndex, const char* key);
+
+    /**
+     * Return the next chunk of the blob. The data are mapped from flash if the partition supports it, otherwise
+     * they are read into a buffer of the size of the chunk. Either is released by the next call or by
+     * closeBlobReader().
+     */
+    esp_err_t nextBlobChunk(nvs_opaque_blob_reader_t* reader, nvs_blob_chunk_t& chunk);
+
+    void closeBlobReader(nvs_opaque_blob_reader_t* reader);
+
+    esp_err_t setItemIndexEnabled(bool enabled);
+
+    bool isItemIndexEnabled() const
+    {
+        return mItemIndexEnabled;
+    }
+
+    size_t getItemIndexMemoryUsage() const
+    {
+        return mItemIndexEnabled ? mItemIndex.getMemoryUsage() : 0;
+    }
+
+    /**
+     * Set the maximum number of small values kept in the read cache, 0 disables the cache.
+     */
+    void setReadCacheSize(size_t itemCount)
+    {
+        mItemCache.setCapacity(itemCount);
+    }
+
+    void fillCacheStats(nvs_cache_stats_t& cacheStats);
+
 protected:
 
     Page& getCurrentPage()
@@ -145,9 +202,11 @@ protected:
 
     void clearNamespaces();
 
-    esp_err_t populateBlobIndices(TBlobIndexList&);
+    esp_err_t loadNamespacesAndBlobIndices(TBlobIndexList&);
+
+    static bool isOrphanDataBlob(TBlobIndexList&, const Item&);
 
-    void eraseMismatchedBlobIndexes(TBlobIndexList&);
+    bool eraseMismatchedBlobIndexes(TBlobIndexList&);
 
     void eraseOrphanDataBlobs(TBlobIndexList&);
 
@@ -155,6 +214,27 @@ protected:
 
     esp_err_t findItem(uint8_t nsIndex, ItemType datatype, const char* key, Page* &page, Item& item, uint8_t chunkIdx = Page::CHUNK_ANY, VerOffset chunkStart = VerOffset::VER_ANY, size_t* itemIndex = NULL);
 
+    esp_err_t writeItem(uint8_t nsIndex, ItemType datatype, const char* key, const void* data, size_t dataSize, bool eraseOldValue);
+
+    esp_err_t writeTransactionMarker(const char* key, size_t* markerIndex);
+
+    esp_err_t requestNewPage();
+
+    void rebuildItemIndex();
+
+    void indexPage(Page& page);
+
+    void indexItem(Page& page, size_t itemIndex, uint8_t nsIndex, ItemType datatype, const char* key, uint8_t chunkIdx = Page::CHUNK_ANY);
+
+    void unindexItem(const Item& item, const Page* page, size_t itemIndex);
+
+    void disableItemIndex();
+
+    bool isCacheable(ItemType datatype) const
+    {
+        return mItemCache.capacity() > 0 && datatype != ItemType::BLOB;
+    }
+
 protected:
     Partition *mPartition;
     size_t mPageCount;
@@ -162,6 +242,16 @@ protected:
     TNamespaces mNamespaces;
     CompressedEnumTable<bool, 1, 256> mNamespaceUsage;
     StorageState mState = StorageState::INVALID;
+    ItemIndex mItemIndex;
+    ItemCache mItemCache;
+#ifdef CONFIG_NVS_STORAGE_ITEM_INDEX
+    bool mItemIndexEnabled = true;
+#else
+    bool mItemIndexEnabled = false;
+#endif
+
+    // maximum number of index nodes sharing one hash which are resolved without falling back to the page scan
+    static const size_t ITEM_INDEX_MAX_CANDIDATES = 8;
 };
 
 } // namespace nvs
@@ -176,4 +266,19 @@ struct nvs_opaque_iterator_t
     nvs_entry_info_t entry_info;
 };
 
+struct nvs_opaque_blob_reader_t
+{
+    nvs::Storage *storage;
+    uint8_t nsIndex;
+    char key[NVS_KEY_NAME_MAX_SIZE];
+    nvs::VerOffset chunkStart;  // VER_ANY for a blob stored without blob index
+    uint8_t chunkCount;
+    uint8_t nextChunk;
+    size_t dataSize;
+    size_t offset;
+    const void *mapped;         // data of the current chunk if mapped from flash
+    esp_partition_mmap_handle_t mmapHandle;
+    uint8_t *buffer;            // data of the current chunk if read from flash
+};
+
 #endif /* nvs_storage_hpp */
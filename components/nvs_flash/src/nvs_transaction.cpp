@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#if __has_include(<bsd/string.h>)
+// for strlcpy
+#include <bsd/string.h>
+#endif
+#include "nvs_transaction.hpp"
+#include "nvs_page.hpp"
+
+namespace nvs
+{
+
+Transaction::Transaction()
+{
+}
+
+Transaction::~Transaction()
+{
+    clear();
+}
+
+void Transaction::clear()
+{
+    mItems.clearAndFreeNodes();
+}
+
+esp_err_t Transaction::set(ItemType datatype, const char* key, const void* data, size_t dataSize)
+{
+    if (strlen(key) > Item::MAX_KEY_LENGTH) {
+        return ESP_ERR_NVS_KEY_TOO_LONG;
+    }
+
+    if (datatype == ItemType::SZ && dataSize > Page::CHUNK_MAX_SIZE) {
+        return ESP_ERR_NVS_VALUE_TOO_LONG;
+    }
+
+    uint8_t* buf = nullptr;
+    if (dataSize > 0) {
+        buf = new (std::nothrow) uint8_t[dataSize];
+        if (!buf) {
+            return ESP_ERR_NO_MEM;
+        }
+        memcpy(buf, data, dataSize);
+    }
+
+    TransactionItem* staged = find(key);
+    if (!staged) {
+        staged = new (std::nothrow) TransactionItem;
+        if (!staged) {
+            delete [] buf;
+            return ESP_ERR_NO_MEM;
+        }
+        strlcpy(staged->mKey, key, sizeof(staged->mKey));
+        mItems.push_back(staged);
+    }
+
+    delete [] staged->mData;
+    staged->mDatatype = datatype;
+    staged->mData = buf;
+    staged->mDataSize = dataSize;
+    return ESP_OK;
+}
+
+Transaction::TransactionItem* Transaction::find(const char* key)
+{
+    for (auto it = mItems.begin(); it != mItems.end(); ++it) {
+        if (strncmp(it->mKey, key, Item::MAX_KEY_LENGTH) == 0) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace nvs
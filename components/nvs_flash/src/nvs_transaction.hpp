@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef nvs_transaction_hpp
+#define nvs_transaction_hpp
+
+#include "nvs.h"
+#include "nvs_types.hpp"
+#include "nvs_memory_management.hpp"
+#include "intrusive_list.h"
+
+namespace nvs
+{
+
+/**
+ * Values written through a handle between nvs_txn_begin() and nvs_txn_commit().
+ *
+ * The values are kept in RAM until the transaction is committed by Storage::commitTransaction(). Writing a key
+ * which is already staged replaces the staged value, so that only the last value of every key reaches the flash.
+ */
+class Transaction : public ExceptionlessAllocatable
+{
+public:
+    struct TransactionItem : public intrusive_list_node<TransactionItem>, public ExceptionlessAllocatable {
+    public:
+        ~TransactionItem()
+        {
+            delete [] mData;
+        }
+
+        char mKey[Item::MAX_KEY_LENGTH + 1];
+        ItemType mDatatype;
+        uint8_t* mData = nullptr;
+        size_t mDataSize = 0;
+    };
+
+    typedef intrusive_list<TransactionItem> TItemList;
+
+    Transaction();
+    ~Transaction();
+
+    /**
+     * Stage a value. Datatype BLOB is used for blobs, the same way as in Storage::writeItem().
+     */
+    esp_err_t set(ItemType datatype, const char* key, const void* data, size_t dataSize);
+
+    TransactionItem* find(const char* key);
+
+    TItemList& items()
+    {
+        return mItems;
+    }
+
+    size_t size() const
+    {
+        return mItems.size();
+    }
+
+    void clear();
+
+private:
+    Transaction(const Transaction& other);
+    const Transaction& operator= (const Transaction& rhs);
+
+    TItemList mItems;
+}; // class Transaction
+
+} // namespace nvs
+
+#endif /* nvs_transaction_hpp */
@@ -8,6 +8,7 @@
 #define PARTITION_HPP_
 
 #include "esp_err.h"
+#include "esp_partition.h"
 
 namespace nvs {
 
@@ -35,6 +36,14 @@ public:
 
     virtual esp_err_t erase_range(size_t dst_offset, size_t size) = 0;
 
+    /**
+     * Map a region of the partition into the address space for reading. The memory holds the raw flash contents,
+     * partitions which can't provide the data of read() this way return ESP_ERR_NOT_SUPPORTED.
+     */
+    virtual esp_err_t mmap(size_t src_offset, size_t size, const void** out_ptr, esp_partition_mmap_handle_t* out_handle) = 0;
+
+    virtual void munmap(esp_partition_mmap_handle_t handle) = 0;
+
     /**
      * Return the address of the beginning of the partition.
      */
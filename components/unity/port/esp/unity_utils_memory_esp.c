@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2015-2021 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -15,6 +15,8 @@ static size_t s_before_free_32bit;
 
 void unity_utils_record_free_mem(void)
 {
+    // blocks kept in the small block caches are not counted as free
+    heap_caps_cache_flush();
     s_before_free_8bit = heap_caps_get_free_size(MALLOC_CAP_8BIT);
     s_before_free_32bit = heap_caps_get_free_size(MALLOC_CAP_32BIT);
 }
@@ -33,6 +35,7 @@ void unity_utils_setup_heap_record(size_t num_heap_records)
 
 void unity_utils_evaluate_leaks_direct(size_t threshold)
 {
+    heap_caps_cache_flush();
     size_t after_free_8bit = heap_caps_get_free_size(MALLOC_CAP_8BIT);
     size_t after_free_32bit = heap_caps_get_free_size(MALLOC_CAP_32BIT);
     unity_utils_check_leak(s_before_free_8bit, after_free_8bit, "8BIT", threshold);
@@ -162,6 +162,7 @@ def check_output(p: Any) -> None:
     [
         'v1',
         'v2_bin',
+        'v2_bin_async',
         'v2_bin_with_txt',
         'v2_txt',
     ],